@@ -201,6 +201,13 @@
 #include "cdisort.h"
 #include "locate.h"
 
+/*
+ * ARTS: The function-static variables below hold state between calls, e.g.
+ * callnum, lazily initialized tables and machine constants. They are kept
+ * per thread, so that c_disort can run in several threads at once.
+ */
+#define DS_THREAD_LOCAL _Thread_local
+
 /*============================= c_disort() ==============================*/
 
 /*-------------------------------------------------------------------------------*
@@ -396,13 +403,13 @@
 void c_disort(disort_state  *ds,
 	      disort_output *out)
 {
-  static int
+  static DS_THREAD_LOCAL int
     self_tested = -1;
   int
     prntu0[2],
     corint,deltam,scat_yes,compare,lyrcut,needdeltam,
     iq,iu,j,kconv,l,lc,lev,lu,mazim,naz,ncol,ncos,ncut,nn;
-  static int
+  static DS_THREAD_LOCAL int
     callnum=1;
   int
     ipvt[ds->nstr*ds->nlyr],
@@ -1085,12 +1092,12 @@ double c_bidir_reflectivity ( double       wvnmlo,
   double
     ans, rmu, flxalb;
 
-  static double
+  static DS_THREAD_LOCAL double
     badmu, swvnmlo, swvnmhi, srho0, sk,
     stheta, ssigma, st1, st2, sscale;
 
 #if HAVE_BRDF
-    static double
+    static DS_THREAD_LOCAL double
     siso, svol, sgeo;
 #endif
 
@@ -4596,13 +4603,13 @@ void c_surface_bidir(disort_state *ds,
                      double       *rmu,
 		     int           callnum)
 {
-  static int
+  static DS_THREAD_LOCAL int
     pass1 = TRUE;
   register int
     iq,iu,jg,jq,k;
   double
     dref,sum;
-  static double
+  static DS_THREAD_LOCAL double
     gmu[NMUG],gwt[NMUG];
   
   if (pass1) {
@@ -5096,7 +5103,7 @@ void c_set_coefficients_beam_source(disort_state *ds,
     iq,k;
   double 
     deltat,sum,q0a,q2a,q0,q2;
-  static double
+  static DS_THREAD_LOCAL double
     big;
 
   big    = sqrt(DBL_MAX)/1.e+10;
@@ -6259,13 +6266,13 @@ double c_dref(double       wvnmlo,
 	      disort_brdf *brdf,
 	      int          callnum )
 {
-  static int
+  static DS_THREAD_LOCAL int
     pass1 = TRUE;
   register int
     jg,k;
   double
     ans,sum;
-  static double
+  static DS_THREAD_LOCAL double
     gmu[NMUG],gwt[NMUG];
 
   if (pass1) {
@@ -6486,7 +6493,7 @@ double c_planck_func1(double wnumlo,
     i,k,m,mmax,n,smallv;
   int
     converged;
-  static int
+  static DS_THREAD_LOCAL int
     initialized = FALSE;
   const double
     vcp[7] = {10.25,5.7,3.9,2.9,2.3,1.9,0.0};
@@ -6494,7 +6501,7 @@ double c_planck_func1(double wnumlo,
     del,ex,exm,hh,mv,oldval,
     val,val0,vsq,d[2],p[2],v[2],
     ans;
-  static double
+  static DS_THREAD_LOCAL double
     vmax,sigdpi,conc;
 
   if (!initialized) {
@@ -6978,14 +6985,14 @@ void c_gaussian_quadrature(int    m,
                            double *gmu,
                            double *gwt)
 {
-  static int
+  static DS_THREAD_LOCAL int
     initialized = FALSE;
   register int
     iter,k,lim,nn,np1;
   double
     cona,t,en,nnp1,p=0,p2pri,pm1,pm2,ppr,
     prod,tmp,x,xi;
-  static double
+  static DS_THREAD_LOCAL double
     tol;
 
   if (!initialized) {
@@ -7096,9 +7103,9 @@ void c_gaussian_quadrature(int    m,
 double c_ratio(double a,
              double b)
 {
-  static int
+  static DS_THREAD_LOCAL int
     initialized = FALSE;
-  static double
+  static DS_THREAD_LOCAL double
     tiny,huge,powmax,powmin;
   double
     ans,absa,absb,powa,powb;
@@ -10235,9 +10242,9 @@ void c_twostr_solns(disort_state *ds,
 {
   register int
     lc;
-  static int
+  static DS_THREAD_LOCAL int
     initialized = FALSE;
-  static double
+  static DS_THREAD_LOCAL double
     big,large,small,little;
   double
     q_1,q_2,qq,q0a,q0,q1a,q2a,q1,q2,
@@ -10626,7 +10633,7 @@ void c_twostr_set(disort_state *ds,
                   double       *tplanck,
                   double       *utaupr)
 {
-  static int
+  static DS_THREAD_LOCAL int
     firstpass = TRUE;
   register int
     lc,lu,lev;
@@ -11058,7 +11065,7 @@ double c_planck_func2(double wnumlo,
 {
   register int
     m,n,smallv,k,i,mmax;
-  static int
+  static DS_THREAD_LOCAL int
     initialized = FALSE;
   double
     ans,del,val,val0,oldval,exm,
@@ -11066,7 +11073,7 @@ double c_planck_func2(double wnumlo,
     d[2],p[2],v[2];
   const double
     vcp[7] = {10.25,5.7,3.9,2.9,2.3,1.9,0.0};
-  static double
+  static DS_THREAD_LOCAL double
     sigdpi,vmax,conc,c1;
 
   if (!initialized) {
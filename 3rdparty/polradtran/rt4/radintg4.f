@@ -145,7 +145,6 @@ C      two layer properties and the radiance incident on the top and bottom.
       PARAMETER (MAXV=64, MAXM=4096)
       REAL*8    S(MAXV), V(MAXV)
       REAL*8    X(MAXM), Y(MAXM)
-      COMMON /SCRATCH1/ X, Y
 
 
 C               Compute gamma plus
@@ -214,8 +213,6 @@ C      T_REFLECT, T_TRANS, and T_SOURCE.
       REAL*8   LINFAC, ZERO
       REAL*8   X(MAXM), Y(MAXM)
       REAL*8   GAMMA(MAXM)
-      COMMON /SCRATCH1/ X, Y
-      COMMON /SCRATCH2/ GAMMA
       PARAMETER (ZERO=0.0D0)
 
 
@@ -345,8 +342,6 @@ C      thus layer 1 is put on top of layer 2.
       PARAMETER (MAXM=4096)
       REAL*8   X(MAXM), Y(MAXM)
       REAL*8   GAMMA(MAXM)
-      COMMON /SCRATCH1/ X, Y
-      COMMON /SCRATCH2/ GAMMA
 
 C           GAMMAp = inv[1 - R1p * R2m]     (p for +,  m for -)
       CALL MMULT (N, N, N, REFLECT1(1,1,1), REFLECT2(1,1,2), X)
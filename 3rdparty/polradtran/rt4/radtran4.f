@@ -5,6 +5,9 @@ C    not calculated internally anymore, but set from interface variables
 C    corresponding to GND_RADIANCE and the (non-zero) surface part of
 C    REFLECT, which have to be prepared externally (eg by ARTS' own
 C    surface property methods.
+C        Furthermore, the layer matrices are passed in as work arrays
+C    and the subroutines do not use COMMON blocks, so that RADTRANO
+C    can be called from several threads at once.
 C
 C        RADTRANO solves the plane-parallel polarized radiative transfer
 C    equation for an inhomogenous atmosphere with particles oriented 
@@ -83,6 +86,15 @@ C                                    (NSTOKES,NUMMU,NOUTLEVELS)
 C  DOWN_RAD          REAL array    Downward radiances
 C                                    (NSTOKES,NUMMU,NOUTLEVELS)
 C
+C    Work arrays (provided by the caller, contents are not used)
+C
+C  REFLECT           REAL array    Reflection matrices of the layers
+C                                    (2*(NSTOKES*NUMMU)**2*(NUM_LAYERS+1))
+C  TRANS             REAL array    Transmission matrices of the layers
+C                                    (2*(NSTOKES*NUMMU)**2*(NUM_LAYERS+1))
+C  SOURCE            REAL array    Source vectors of the layers
+C                                    (2*NSTOKES*NUMMU*(NUM_LAYERS+1))
+C
 C
 C             Format of Scattering Files
 C
@@ -147,7 +159,8 @@ c     .               GAS_EXTINCT, SCAT_FILES,
 c     .               NOUTLEVELS, OUTLEVELS,
 c     .               MU_VALUES, UP_FLUX, DOWN_FLUX,
      .               MU_VALUES,
-     .               UP_RAD, DOWN_RAD)
+     .               UP_RAD, DOWN_RAD,
+     .               REFLECT, TRANS, SOURCE)
       INTEGER   NSTOKES, NUMMU, NUM_LAYERS, NSL
 c      INTEGER   NOUTLEVELS, OUTLEVELS(NOUTLEVELS)
       REAL*8    GROUND_TEMP, GROUND_ALBEDO
@@ -170,9 +183,12 @@ c      CHARACTER*64 SCAT_FILES(*)
       REAL*8    EXTINCT_MATRIX(NSTOKES,NSTOKES,NUMMU,2,NSL)
       REAL*8    EMIS_VECTOR(NSTOKES,NUMMU,2,NSL)
       REAL*8    SCATTER_MATRIX(NSTOKES,NUMMU,NSTOKES,NUMMU,4,NSL)
+      REAL*8    REFLECT(2*(NSTOKES*NUMMU)**2*(NUM_LAYERS+1))
+      REAL*8    TRANS(2*(NSTOKES*NUMMU)**2*(NUM_LAYERS+1))
+      REAL*8    SOURCE(2*NSTOKES*NUMMU*(NUM_LAYERS+1))
 
-      INTEGER   MAXV, MAXM, MAXLAY, MAXLM
-      PARAMETER (MAXV=64, MAXM=4096, MAXLAY=400, MAXLM=301*4096)
+      INTEGER   MAXV, MAXM
+      PARAMETER (MAXV=64, MAXM=4096)
 
       REAL*8    PI, TWOPI, ZERO
       PARAMETER (PI = 3.1415926535897932384D0, TWOPI=2.0D0*PI)
@@ -191,9 +207,6 @@ c      REAL*8    EXTINCT_MATRIX(16*2*MAXV), EMIS_VECTOR(4*2*MAXV)
       REAL*8    REFLECT1(2*MAXM),UPREFLECT(2*MAXM),DOWNREFLECT(2*MAXM)
       REAL*8    TRANS1(2*MAXM),  UPTRANS(2*MAXM),  DOWNTRANS(2*MAXM)
       REAL*8    SOURCE1(2*MAXV), UPSOURCE(2*MAXV), DOWNSOURCE(2*MAXV)
-      REAL*8    REFLECT(2*MAXLM)
-      REAL*8    TRANS(2*MAXLM)
-      REAL*8    SOURCE(2*MAXV*(MAXLAY+1))
 c      REAL*8    GND_RADIANCE(MAXV), SKY_RADIANCE(2*MAXV)
       REAL*8    SKY_RADIANCE(2*MAXV)
 c      CHARACTER*64 SCAT_FILE
@@ -224,20 +237,6 @@ c      NSTOKES = MIN(NSTOKES,2)
      .     '.  Yours is ', N, '*', N, ' = ', N*N
           STOP
       ENDIF
-      IF (NUM_LAYERS .GT. MAXLAY) THEN
-          WRITE (*,'(1X,A,3(A,I4))') 'Number of layers exceeded.',
-     .     '  Maximum number :', MAXLAY,
-     .     '.  Yours is ', NUM_LAYERS
-          STOP
-      ENDIF
-      IF ((NUM_LAYERS+1)*N*N .GT. MAXLM) THEN
-          WRITE (*,'(1X,A,A,I5,3(A,I3),A,I5)')
-     .     'Matrix layer size exceeded.',
-     .     '  Maximum number (num_layers+1)*(nstokes*nummu)^2:', MAXLM,
-     .     '.  Yours is (', NUM_LAYERS, '+1)*(', NSTOKES, '*', NUMMU,
-     .     ')^2 = ', (NUM_LAYERS+1)*N*N
-          STOP
-      ENDIF
 
 
 C           Make the desired quadrature abscissas and weights
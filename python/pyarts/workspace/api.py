@@ -270,6 +270,66 @@ class VariableValueStruct(c.Structure):
         self.initialized = initialized
         self.dimensions  = (c.c_long * 7)(*dimensions)
 
+class ArrayViewStruct(c.Structure):
+    """
+    View of the data of a Vector, Matrix, Tensor3-7 or Sparse in the style
+    of the buffer protocol.
+
+    Dense data is described by the data pointer, the shape and the strides
+    in bytes, so any numpy.ndarray of float64, including non-contiguous
+    views, can be passed to ARTS without first copying it. Sparse matrices
+    are described by the element, column index and row start arrays of
+    their compressed row storage.
+    """
+    _fields_ = [("ptr", c.c_void_p),
+                ("ndim", c.c_long),
+                ("shape", 7 * c.c_long),
+                ("strides", 7 * c.c_long),
+                ("nnz", c.c_long),
+                ("inner_ptr", c.POINTER(c.c_int)),
+                ("outer_ptr", c.POINTER(c.c_int))]
+
+    @classmethod
+    def from_value(cls, value):
+        """ Create a view of a numpy.ndarray or scipy.sparse matrix.
+
+        Args:
+            value(object): The python object to create the view of.
+
+        Returns:
+            The ArrayViewStruct or None if the value is neither an array of
+            float64 with at most 7 dimensions nor a sparse matrix.
+        """
+        view = cls()
+        if isinstance(value, np.ndarray):
+            if value.dtype != np.float64 or not 0 < value.ndim <= 7:
+                return None
+            view.ptr = value.ctypes.data
+            view.ndim = value.ndim
+            for i in range(value.ndim):
+                view.shape[i] = value.shape[i]
+                view.strides[i] = value.strides[i]
+        elif sp.sparse.issparse(value):
+            # Work on a copy, csr_matrix shares the arrays of a csr input
+            # and the view needs sorted indices without duplicates
+            m = sp.sparse.csr_matrix(value, dtype=np.float64).copy()
+            m.sum_duplicates()
+            m.sort_indices()
+            indices = m.indices.astype(np.intc, copy=False)
+            indptr = m.indptr.astype(np.intc, copy=False)
+            view.ptr = m.data.ctypes.data
+            view.ndim = 2
+            view.shape[0], view.shape[1] = m.shape
+            view.nnz = m.nnz
+            view.inner_ptr = c.cast(indices.ctypes.data, c.POINTER(c.c_int))
+            view.outer_ptr = c.cast(indptr.ctypes.data, c.POINTER(c.c_int))
+            value = (m, indices, indptr)
+        else:
+            return None
+        # Keep the data alive as long as the view
+        view._value = value
+        return view
+
 class CovarianceMatrixBlockStruct(c.Structure):
     """
     c struct representing block of covariance matrices.
@@ -386,6 +446,38 @@ arts_api.execute_agenda.restype  = c.c_char_p
 arts_api.destroy_agenda.argtypes = [c.c_void_p]
 arts_api.destroy_agenda.restype  = None
 
+# Asynchronous execution
+#
+# Status codes returned by async_task_status and async_task_wait.
+ASYNC_QUEUED, ASYNC_RUNNING, ASYNC_FINISHED, ASYNC_FAILED, ASYNC_CANCELLED = range(5)
+
+arts_api.set_async_threads.argtypes = [c.c_long]
+arts_api.set_async_threads.restype  = None
+
+arts_api.execute_agenda_async.argtypes = [c.c_void_p, c.c_void_p]
+arts_api.execute_agenda_async.restype  = c.c_void_p
+
+arts_api.execute_workspace_method_async.argtypes = [c.c_void_p, c.c_long,
+                                                    c.c_ulong, c.POINTER(c.c_long),
+                                                    c.c_ulong, c.POINTER(c.c_long)]
+arts_api.execute_workspace_method_async.restype  = c.c_void_p
+
+arts_api.async_task_status.argtypes = [c.c_void_p]
+arts_api.async_task_status.restype  = c.c_long
+
+# Wait for task with timeout in seconds, negative to wait until finished.
+arts_api.async_task_wait.argtypes = [c.c_void_p, c.c_double]
+arts_api.async_task_wait.restype  = c.c_long
+
+arts_api.async_task_cancel.argtypes = [c.c_void_p]
+arts_api.async_task_cancel.restype  = None
+
+arts_api.async_task_error.argtypes = [c.c_void_p]
+arts_api.async_task_error.restype  = c.c_char_p
+
+arts_api.destroy_async_task.argtypes = [c.c_void_p]
+arts_api.destroy_async_task.restype  = None
+
 # Groups
 #
 # Returns the number of WSV groups.
@@ -419,6 +511,25 @@ arts_api.get_variable_value.restype  = VariableValueStruct
 arts_api.set_variable_value.argtypes = [c.c_void_p, c.c_long, c.c_long, VariableValueStruct]
 arts_api.set_variable_value.restype  =  c.c_char_p
 
+# Get a view of the storage of a Vector, Matrix, Tensor3-7 or Sparse WSV
+# given a workspace handle, the variable id and the group id.
+arts_api.get_variable_view.argtypes = [c.c_void_p, c.c_long, c.c_long,
+                                       c.POINTER(ArrayViewStruct)]
+arts_api.get_variable_view.restype  = c.c_char_p
+
+# Set a Vector, Matrix, Tensor3-7 or Sparse WSV from an ArrayViewStruct.
+arts_api.set_variable_view.argtypes = [c.c_void_p, c.c_long, c.c_long,
+                                       c.POINTER(ArrayViewStruct)]
+arts_api.set_variable_view.restype  = c.c_char_p
+
+# Resize a Vector, Matrix, Tensor3-7 or Sparse WSV given the number of
+# dimensions, the shape and the number of non-zero elements and return a
+# view of its storage.
+arts_api.resize_variable.argtypes = [c.c_void_p, c.c_long, c.c_long, c.c_long,
+                                     c.POINTER(c.c_long), c.c_long,
+                                     c.POINTER(ArrayViewStruct)]
+arts_api.resize_variable.restype  = c.c_char_p
+
 # Adds a value of a given group to a given workspace.
 arts_api.add_variable.restype  = c.c_long
 arts_api.add_variable.argtypes = [c.c_void_p, c.c_long, c.c_char_p]
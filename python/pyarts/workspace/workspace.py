@@ -24,7 +24,8 @@ from copy       import copy
 from functools  import wraps
 import os
 
-from pyarts.workspace.api import (arts_api, VariableValueStruct, data_path_push,
+from pyarts.workspace.api import (arts_api, VariableValueStruct,
+                                ArrayViewStruct, data_path_push,
                                 data_path_pop, include_path_push,
                                 include_path_pop, is_empty)
 from pyarts.workspace.methods   import WorkspaceMethod, workspace_methods
@@ -445,6 +446,19 @@ class Workspace:
                                 " value  '{}'.".format(wsv.group, value))
             value = converted
 
+        # Arrays and sparse matrices are copied directly from their
+        # memory, whatever their layout.
+        view = ArrayViewStruct.from_value(value)
+        if view is not None and wsv.group in ["Vector", "Matrix", "Sparse"] \
+                + ["Tensor{}".format(i) for i in range(3, 8)]:
+            err = arts_api.set_variable_view(self.ptr, wsv.ws_id, wsv.group_id,
+                                             c.byref(view))
+            if not err is None:
+                msg = ("The following error occurred when trying to set the"
+                       " WSV {}: {}".format(wsv.name, err.decode()))
+                raise Exception(msg)
+            return None
+
         s = VariableValueStruct(value)
         if s.ptr:
             err = arts_api.set_variable_value(self.ptr, wsv.ws_id, wsv.group_id, s)
@@ -0,0 +1,78 @@
+"""
+Test asynchronous execution through the C API.
+"""
+import time
+import numpy as np
+import pytest
+from pyarts.workspace import Workspace, arts_agenda
+from pyarts.workspace.api import arts_api, ASYNC_FINISHED, ASYNC_CANCELLED
+
+@arts_agenda
+def set_agenda(ws):
+    ws.IndexSet(ws.stokes_dim, 3)
+
+@arts_agenda
+def sleep_agenda(ws):
+    ws.Sleep(0.2)
+    ws.Sleep(0.2)
+    ws.Sleep(0.2)
+    ws.Sleep(0.2)
+    ws.Sleep(0.2)
+
+
+class TestAsync:
+    """
+    Tests submitting, waiting for and cancelling agenda executions.
+    """
+    def setup_method(self):
+        """
+        This ensures a new Workspace for every test.
+        """
+        self.ws = Workspace(verbosity = 0)
+        self.ws.stokes_dim = 1
+
+    def test_submit_wait(self):
+        """
+        Execute an agenda and wait for it.
+        """
+        task = arts_api.execute_agenda_async(self.ws.ptr, set_agenda.ptr)
+        status = arts_api.async_task_wait(task, -1.0)
+        assert status == ASYNC_FINISHED
+        assert arts_api.async_task_status(task) == ASYNC_FINISHED
+        assert arts_api.async_task_error(task) is None
+        arts_api.destroy_async_task(task)
+        assert self.ws.stokes_dim.value == 3
+
+    def test_wait_timeout(self):
+        """
+        Waiting returns after the timeout while the agenda is running.
+        """
+        task = arts_api.execute_agenda_async(self.ws.ptr, sleep_agenda.ptr)
+        status = arts_api.async_task_wait(task, 0.05)
+        assert status not in [ASYNC_FINISHED, ASYNC_CANCELLED]
+        assert arts_api.async_task_wait(task, -1.0) == ASYNC_FINISHED
+        arts_api.destroy_async_task(task)
+
+    def test_cancel(self):
+        """
+        Cancel a running and a queued execution.
+        """
+        running = arts_api.execute_agenda_async(self.ws.ptr, sleep_agenda.ptr)
+        queued = arts_api.execute_agenda_async(self.ws.ptr, set_agenda.ptr)
+
+        start = time.time()
+        arts_api.async_task_wait(running, 0.1)
+        arts_api.async_task_cancel(running)
+        arts_api.async_task_cancel(queued)
+
+        # The running agenda stops after the current Sleep
+        assert arts_api.async_task_wait(running, -1.0) == ASYNC_CANCELLED
+        assert time.time() - start < 0.8
+        assert b"cancelled" in arts_api.async_task_error(running)
+
+        # The queued agenda is never started
+        assert arts_api.async_task_wait(queued, -1.0) == ASYNC_CANCELLED
+        assert self.ws.stokes_dim.value == 1
+
+        arts_api.destroy_async_task(running)
+        arts_api.destroy_async_task(queued)
@@ -1,12 +1,14 @@
 """
 Test accessing and transferring workspace variables.
 """
+import ctypes as c
 import os
 import numpy as np
 import pytest
 import scipy as sp
 import pyarts
 from pyarts.workspace import Workspace, WorkspaceVariable
+from pyarts.workspace.api import arts_api, ArrayViewStruct
 from pyarts.xml import load, save
 
 class TestVariables:
@@ -265,3 +267,116 @@ class TestVariables:
 
         v = WorkspaceVariable.convert("ArrayOfArrayOfIndex", 1)
         return v
+
+    @staticmethod
+    def view_to_array(view):
+        """
+        Numpy array of the dense storage exposed by an ArrayViewStruct.
+        """
+        shape = tuple(view.shape[i] for i in range(view.ndim))
+        strides = tuple(view.strides[i] for i in range(view.ndim))
+        size = 1 + sum((n - 1) * s // 8 for n, s in zip(shape, strides))
+        data = np.ctypeslib.as_array(c.cast(view.ptr, c.POINTER(c.c_double)),
+                                     (size,))
+        return np.lib.stride_tricks.as_strided(data, shape, strides)
+
+    def test_get_variable_view(self):
+        """
+        Get a view of the storage of Matrix and Sparse WSVs.
+        """
+        self.ws.MatrixCreate("matrix_variable")
+        m = np.random.rand(4, 5)
+        self.ws.matrix_variable = m
+        wsv = self.ws.matrix_variable
+
+        view = ArrayViewStruct()
+        err = arts_api.get_variable_view(self.ws.ptr, wsv.ws_id, wsv.group_id,
+                                         c.byref(view))
+        assert err is None
+        assert view.ndim == 2
+        assert np.all(self.view_to_array(view) == m)
+
+        # Changes through the view are seen by ARTS
+        self.view_to_array(view)[1, 2] = -1.0
+        assert self.ws.matrix_variable.value[1, 2] == -1.0
+
+        m = sp.sparse.random(10, 8, density=0.3, format="csr")
+        self.ws.sensor_response = m
+        wsv = self.ws.sensor_response
+        err = arts_api.get_variable_view(self.ws.ptr, wsv.ws_id, wsv.group_id,
+                                         c.byref(view))
+        assert err is None
+        assert view.nnz == m.nnz
+        data = np.ctypeslib.as_array(c.cast(view.ptr, c.POINTER(c.c_double)),
+                                     (view.nnz,))
+        indices = np.ctypeslib.as_array(view.inner_ptr, (view.nnz,))
+        indptr = np.ctypeslib.as_array(view.outer_ptr, (view.shape[0] + 1,))
+        v = sp.sparse.csr_matrix((data, indices, indptr), shape=m.shape)
+        assert np.all(v.toarray() == m.toarray())
+
+    def test_resize_variable(self):
+        """
+        Resize a Tensor3 WSV and fill it in place.
+        """
+        self.ws.Tensor3Create("tensor_3")
+        wsv = self.ws.tensor_3
+
+        shape = (c.c_long * 3)(2, 3, 4)
+        view = ArrayViewStruct()
+        err = arts_api.resize_variable(self.ws.ptr, wsv.ws_id, wsv.group_id,
+                                       3, shape, 0, c.byref(view))
+        assert err is None
+        t = np.random.rand(2, 3, 4)
+        self.view_to_array(view)[:] = t
+        assert np.all(self.ws.tensor_3.value == t)
+
+        # Wrong number of dimensions
+        err = arts_api.resize_variable(self.ws.ptr, wsv.ws_id, wsv.group_id,
+                                       2, shape, 0, c.byref(view))
+        assert err is not None
+
+    def test_set_variable_view(self):
+        """
+        Set WSVs from non-contiguous arrays and from sparse matrices.
+        """
+        self.ws.MatrixCreate("matrix_variable")
+        m = np.random.rand(10, 12)
+        for v in [m[::2, ::3], m.T, m[::-1, 1:], np.asfortranarray(m)]:
+            self.ws.matrix_variable = v
+            assert np.all(self.ws.matrix_variable.value == v)
+
+        self.ws.Tensor4Create("tensor_4")
+        t = np.random.rand(3, 4, 5, 6)
+        v = t.transpose(2, 0, 3, 1)[::2]
+        self.ws.tensor_4 = v
+        assert np.all(self.ws.tensor_4.value == v)
+
+        # Unsorted sparse input with duplicates, which must not be changed
+        data = np.array([1.0, 2.0, 3.0, 4.0])
+        indices = np.array([3, 1, 1, 0], dtype=np.intc)
+        indptr = np.array([0, 3, 3, 4], dtype=np.intc)
+        m = sp.sparse.csr_matrix((data, indices, indptr), shape=(3, 4))
+        self.ws.sensor_response = m
+        assert np.all(self.ws.sensor_response.value.toarray() == m.toarray())
+        assert np.all(m.indices == [3, 1, 1, 0])
+        assert np.all(m.data == [1.0, 2.0, 3.0, 4.0])
+
+    def test_set_variable_view_aliased(self):
+        """
+        Set WSVs from views of their own storage.
+        """
+        self.ws.MatrixCreate("matrix_variable")
+        m = np.random.rand(6, 6)
+
+        self.ws.matrix_variable = m
+        self.ws.matrix_variable = self.ws.matrix_variable.value.T
+        assert np.all(self.ws.matrix_variable.value == m.T)
+
+        self.ws.matrix_variable = m
+        self.ws.matrix_variable = self.ws.matrix_variable.value[::2, 1:]
+        assert np.all(self.ws.matrix_variable.value == m[::2, 1:])
+
+        m = sp.sparse.random(10, 8, density=0.3, format="csr")
+        self.ws.sensor_response = m
+        self.ws.sensor_response = self.ws.sensor_response.value
+        assert np.all(self.ws.sensor_response.value.toarray() == m.toarray())
@@ -607,7 +607,9 @@ void xsec_species(Matrix& xsec,
                   const AbsorptionLines& band,
                   const Numeric& isot_ratio,
                   const SpeciesAuxData::AuxType& partfun_type,
-                  const ArrayOfGriddedField1& partfun_data) {
+                  const ArrayOfGriddedField1& partfun_data,
+                  const Linefunctions::FaddeevaAlgorithm faddeeva_algorithm,
+                  const Numeric lineshape_window) {
   // Size of problem
   const Index np = abs_p.nelem();      // number of pressure levels
   const Index nf = f_grid.nelem();     // number of Dirac frequencies
@@ -626,6 +628,10 @@ void xsec_species(Matrix& xsec,
   
   // Constant for all lines
   const Numeric QT0 = single_partition_function(band.T0(), partfun_type, partfun_data);
+  
+  // Lines and frequencies inside the cutoff are the same for all levels
+  const Linefunctions::BandFrequencyIndex index(MapToEigen(f_grid), band);
+  if (not index.size()) return;
 
   ArrayOfString fail_msg;
   bool do_abort = false;
@@ -656,6 +662,7 @@ void xsec_species(Matrix& xsec,
                                                sum,
                                                f_grid,
                                                band,
+                                               index,
                                                jacobian_quantities,
                                                line_shape_vmr,
                                                abs_nlte[ip],
@@ -668,7 +675,11 @@ void xsec_species(Matrix& xsec,
                                                QT,
                                                dQTdT,
                                                QT0,
-                                               false);
+                                               false,
+                                               false,
+                                               Zeeman::Polarization::Pi,
+                                               faddeeva_algorithm,
+                                               lineshape_window);
 
       // absorption cross-section
       MapToEigen(xsec).col(ip).noalias() += sum.F.real();
@@ -39,6 +39,7 @@
 #include "messages.h"
 #include "mystring.h"
 #include "absorptionlines.h"
+#include "linefunctions.h"
 
 /** Contains the lookup data for one isotopologue.
     \author Stefan Buehler */
@@ -396,6 +397,8 @@ void set_vmr_from_first_species(Vector& vmr,
  *  @param[in] isot_ratio Isotopologue ratio of this species
  *  @param[in] partfun_type Partition function type for this species
  *  @param[in] partfun_data Partition function model data for this species
+ *  @param[in] faddeeva_algorithm Algorithm for the Faddeeva function of Voigt lines
+ *  @param[in] lineshape_window Evaluate lines only this many Voigt half-widths from their center (if positive)
  * 
  *  @author Richard Larsson
  *  @date   2019-10-10
@@ -416,7 +419,10 @@ void xsec_species(Matrix& xsec,
                   const AbsorptionLines& band,
                   const Numeric& isot_ratio,
                   const SpeciesAuxData::AuxType& partfun_type,
-                  const ArrayOfGriddedField1& partfun_data);
+                  const ArrayOfGriddedField1& partfun_data,
+                  const Linefunctions::FaddeevaAlgorithm faddeeva_algorithm=
+                      Linefunctions::FaddeevaAlgorithm::Faddeeva,
+                  const Numeric lineshape_window=0);
 
 /** Returns the species data
  * 
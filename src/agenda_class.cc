@@ -37,8 +37,16 @@
 #include "global_data.h"
 #include "messages.h"
 #include "methods.h"
+#include "profiler.h"
 #include "workspace_ng.h"
 
+/** Cancellation flag of the calling thread, see Agenda::set_cancel_flag. */
+static thread_local const std::atomic<bool>* agenda_cancel_flag = nullptr;
+
+void Agenda::set_cancel_flag(const std::atomic<bool>* flag) {
+  agenda_cancel_flag = flag;
+}
+
 //! Appends methods to an agenda
 /*!
   This function appends a workspace method to the agenda. It currently only
@@ -70,6 +78,7 @@ void Agenda::append(const String& methodname, const TokVal& keywordvalue) {
 
   mml.push_back(MRecord(id, output, input, keywordvalue, Agenda()));
   mchecked = false;
+  methods_changed();
 }
 
 //! Checks consistency of an agenda.
@@ -137,6 +146,55 @@ void Agenda::check(Workspace& ws, const Verbosity& verbosity) {
   set_outputs_to_push_and_dup(verbosity);
 
   mchecked = true;
+
+  compile();
+}
+
+//! Build the execution plan of an agenda.
+/*!
+  Resolves the getaway function of every method and the list of
+  variables which have to be initialized before it can be called, so
+  that execute does not have to derive this information from the method
+  lookup data each time the agenda runs.
+
+  This is done by check, but must be called again if the method list
+  is modified directly.
+*/
+void Agenda::compile() {
+  compile_plan(mplan);
+  mplan_version = mversion;
+}
+
+//! Build the execution plan for the current method list.
+/*!
+  \param[out] plan One ExecutionStep for each method of the agenda.
+*/
+void Agenda::compile_plan(Array<ExecutionStep>& plan) const {
+  using global_data::md_data;
+
+  // The array holding the pointers to the getaway functions:
+  extern void (*getaways[])(Workspace&, const MRecord&);
+
+  plan.resize(mml.nelem());
+  for (Index i = 0; i < mml.nelem(); ++i) {
+    const MRecord& mrr = mml[i];
+    const MdRecord& mdd = md_data[mrr.Id()];
+    ExecutionStep& step = plan[i];
+
+    step.getaway = getaways[mrr.Id()];
+
+    // All input variables, except for the value of Set methods:
+    const ArrayOfIndex& vin = mrr.In();
+    step.required.resize(0);
+    for (Index s = 0; s < vin.nelem(); ++s)
+      if (s != vin.nelem() - 1 || !mdd.SetMethod())
+        step.required.push_back(vin[s]);
+
+    // Output variables which are also used as input:
+    const ArrayOfIndex& vinout = mdd.InOut();
+    for (Index s = 0; s < vinout.nelem(); ++s)
+      step.required.push_back(mrr.Out()[vinout[s]]);
+  }
 }
 
 //! Execute an agenda.
@@ -173,12 +231,23 @@ void Agenda::execute(Workspace& ws) const {
   // The method description lookup table:
   using global_data::md_data;
 
-  // The array holding the pointers to the getaway functions:
-  extern void (*getaways[])(Workspace&, const MRecord&);
+  // Agendas modified after the last compile have no valid plan
+  const bool plan_valid = mplan_version == mversion;
+  Array<ExecutionStep> local_plan;
+  if (!plan_valid) compile_plan(local_plan);
+  const Array<ExecutionStep>& plan = plan_valid ? mplan : local_plan;
+
+  profiler::Scope agenda_profile(mname, true);
 
-  const Index wsv_id_verbosity = get_wsv_id("verbosity");
+  static const Index wsv_id_verbosity = get_wsv_id("verbosity");
   ws.duplicate(wsv_id_verbosity);
 
+  // Remove the duplicated verbosity again, also if a method throws
+  struct VerbosityPop {
+    Workspace& ws;
+    ~VerbosityPop() { ws.pop_free(wsv_id_verbosity); }
+  } verbosity_pop{ws};
+
   Verbosity& averbosity = *((Verbosity*)ws[wsv_id_verbosity]);
 
   averbosity.set_main_agenda(is_main_agenda());
@@ -193,47 +262,43 @@ void Agenda::execute(Workspace& ws) const {
           << "{\n";
   }
 
-  for (Index i = 0; i < mml.nelem(); ++i) {
-    const Verbosity& verbosity = *((Verbosity*)ws[wsv_id_verbosity]);
-    CREATE_OUT1;
-    CREATE_OUT3;
+  const Verbosity& verbosity = averbosity;
+  CREATE_OUT1;
+  CREATE_OUT3;
 
+  for (Index i = 0; i < mml.nelem(); ++i) {
     // Runtime method data for this method:
     const MRecord& mrr = mml[i];
     // Method data for this method:
     const MdRecord& mdd = md_data[mrr.Id()];
+    const ExecutionStep& step = plan[i];
+
+    if (agenda_cancel_flag &&
+        agenda_cancel_flag->load(std::memory_order_relaxed)) {
+      aout1 << "}\n";
+      throw runtime_error("Execution of agenda *" + mname + "* was cancelled.");
+    }
 
     try {
       {
+        // Only build the message if it is going to be printed
         if (mrr.isInternal()) {
-          out3 << "- " + mdd.Name() + "\n";
+          if (out3.sufficient_priority()) out3 << "- " + mdd.Name() + "\n";
         } else {
-          out1 << "- " + mdd.Name() + "\n";
+          if (out1.sufficient_priority()) out1 << "- " + mdd.Name() + "\n";
         }
       }
 
-      {  // Check if all input variables are initialized:
-        const ArrayOfIndex& v(mrr.In());
-        for (Index s = 0; s < v.nelem(); ++s)
-          if ((s != v.nelem() - 1 || !mdd.SetMethod()) &&
-              !ws.is_initialized(v[s]))
-            throw runtime_error(
-                "Method " + mdd.Name() +
-                " needs input variable: " + Workspace::wsv_data[v[s]].Name());
-      }
-
-      {  // Check if all output variables which are also used as input
-        // are initialized
-        const ArrayOfIndex& v = mdd.InOut();
-        for (Index s = 0; s < v.nelem(); ++s)
-          if (!ws.is_initialized(mrr.Out()[v[s]]))
-            throw runtime_error("Method " + mdd.Name() +
-                                " needs input variable: " +
-                                Workspace::wsv_data[mrr.Out()[v[s]]].Name());
-      }
+      // Check if all input variables are initialized:
+      for (auto&& v : step.required)
+        if (!ws.is_initialized(v))
+          throw runtime_error("Method " + mdd.Name() +
+                              " needs input variable: " +
+                              Workspace::wsv_data[v].Name());
 
       // Call the getaway function:
-      getaways[mrr.Id()](ws, mrr);
+      profiler::Scope method_profile(mdd.Name(), false);
+      step.getaway(ws, mrr);
 
     } catch (const std::bad_alloc& x) {
       aout1 << "}\n";
@@ -256,8 +321,6 @@ void Agenda::execute(Workspace& ws) const {
   }
 
   aout1 << "}\n";
-
-  ws.pop_free(wsv_id_verbosity);
 }
 
 //! Retrieve indexes of all input and output WSVs
@@ -26,6 +26,7 @@
 #ifndef agenda_class_h
 #define agenda_class_h
 
+#include <atomic>
 #include <set>
 #include "messages.h"
 #include "token.h"
@@ -49,7 +50,10 @@ class Agenda {
         moutput_push(),
         moutput_dup(),
         main_agenda(false),
-        mchecked(false) { /* Nothing to do here */
+        mchecked(false),
+        mversion(0),
+        mplan(),
+        mplan_version(-1) { /* Nothing to do here */
   }
 
   /*! 
@@ -61,13 +65,17 @@ class Agenda {
         moutput_push(x.moutput_push),
         moutput_dup(x.moutput_dup),
         main_agenda(x.main_agenda),
-        mchecked(x.mchecked) { /* Nothing to do here */
+        mchecked(x.mchecked),
+        mversion(x.mversion),
+        mplan(x.mplan),
+        mplan_version(x.mplan_version) { /* Nothing to do here */
   }
 
   void append(const String& methodname, const TokVal& keywordvalue);
   void check(Workspace& ws, const Verbosity& verbosity);
   void push_back(const MRecord& n);
   void execute(Workspace& ws) const;
+  void compile();
   inline void resize(Index n);
   inline Index nelem() const;
   inline Agenda& operator=(const Agenda& x);
@@ -76,6 +84,7 @@ class Agenda {
   void set_methods(const Array<MRecord>& ml) {
     mml = ml;
     mchecked = false;
+    methods_changed();
   }
   void set_outputs_to_push_and_dup(const Verbosity& verbosity);
   bool is_input(Workspace& ws, Index var) const;
@@ -88,10 +97,21 @@ class Agenda {
   void set_main_agenda() {
     main_agenda = true;
     mchecked = true;
+    compile();
   }
   bool is_main_agenda() const { return main_agenda; }
   bool checked() const { return mchecked; }
 
+  /** Stop agenda execution on the calling thread on request.
+   *
+   * While a flag is set, execute() checks it before calling each method
+   * and throws if it is true. The flag is per thread, so agendas that a
+   * method executes on OpenMP worker threads do not see it.
+   *
+   * @param[in] flag The flag, or nullptr to remove it.
+   */
+  static void set_cancel_flag(const std::atomic<bool>* flag);
+
  private:
   String mname;       /*!< Agenda name. */
   Array<MRecord> mml; /*!< The actual list of methods to execute. */
@@ -105,6 +125,31 @@ class Agenda {
 
   /** Flag indicating that the agenda was checked for consistency */
   bool mchecked;
+
+  /** Version of the method list, changed with every modification of mml. */
+  Index mversion;
+
+  /** One method of the agenda, prepared for execution. */
+  struct ExecutionStep {
+    /** Getaway function of the method. */
+    void (*getaway)(Workspace&, const MRecord&);
+    /** WSVs which have to be initialized before the method is called. */
+    ArrayOfIndex required;
+  };
+
+  void compile_plan(Array<ExecutionStep>& plan) const;
+
+  /** Drop the execution plan after a modification of the method list. */
+  void methods_changed() {
+    mversion++;
+    mplan.resize(0);
+  }
+
+  /** Execution plan, one step for each method in mml. */
+  Array<ExecutionStep> mplan;
+
+  /** Version of the method list that mplan was built for. */
+  Index mplan_version;
 };
 
 // Documentation with implementation.
@@ -254,7 +299,10 @@ class MRecord {
 /*!
   Resizes the agenda's method list to n elements
  */
-inline void Agenda::resize(Index n) { mml.resize(n); }
+inline void Agenda::resize(Index n) {
+  mml.resize(n);
+  methods_changed();
+}
 
 //! Return the number of agenda elements.
 /*!  
@@ -274,6 +322,7 @@ inline Index Agenda::nelem() const { return mml.nelem(); }
 inline void Agenda::push_back(const MRecord& n) {
   mml.push_back(n);
   mchecked = false;
+  methods_changed();
 }
 
 //! Assignment operator.
@@ -286,6 +335,9 @@ inline Agenda& Agenda::operator=(const Agenda& x) {
   moutput_push = x.moutput_push;
   moutput_dup = x.moutput_dup;
   mchecked = x.mchecked;
+  mversion = x.mversion;
+  mplan = x.mplan;
+  mplan_version = x.mplan_version;
   return *this;
 }
 
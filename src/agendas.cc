@@ -117,6 +117,16 @@ void define_agenda_data() {
             "abs_nlte",
             "abs_vmrs")));
 
+  agenda_data.push_back(
+      AgRecord(NAME("benchmark_agenda"),
+               DESCRIPTION("Workload to be timed by *Benchmark*.\n"
+                           "\n"
+                           "All variables set inside the agenda are local to\n"
+                           "it, so every repetition starts from the same\n"
+                           "workspace state.\n"),
+               OUTPUT(),
+               INPUT()));
+
   agenda_data.push_back(
       AgRecord(NAME("dobatch_calc_agenda"),
                DESCRIPTION("Calculations to perform for each batch case.\n"
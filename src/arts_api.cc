@@ -10,6 +10,18 @@
 #include "parser.h"
 #include "workspace_ng.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 using global_data::md_data;
 using global_data::wsv_group_names;
 extern Parameters parameters;
@@ -19,7 +31,9 @@ Index get_wsv_id(const char *);
 
 using global_data::MdMap;
 
-std::string string_buffer;
+// One buffer per thread, so that executions on the threads of the
+// asynchronous API do not overwrite each other's error messages.
+thread_local std::string string_buffer;
 
 //extern "C" {
 
@@ -43,6 +57,402 @@ void copy_output_and_input(ArrayOfIndex &output,
   }
 }
 
+/** Number of dimensions of the dense groups Vector, Matrix and Tensor3-7.
+ *
+ * @param group_id Index of the group.
+ * @return The number of dimensions, or 0 for all other groups.
+ */
+Index dense_rank(Index group_id) {
+  const String &group = wsv_group_names[group_id];
+  if (group == "Vector") return 1;
+  if (group == "Matrix") return 2;
+  if (group.nelem() == 7 && group.substr(0, 6) == "Tensor" &&
+      group[6] >= '3' && group[6] <= '7')
+    return group[6] - '0';
+  return 0;
+}
+
+/** Data pointer and shape of a dense WSV.
+ *
+ * @param wsv Pointer to the variable.
+ * @param rank Number of dimensions as returned by dense_rank.
+ * @param[out] shape The shape of the variable.
+ * @return Pointer to the data.
+ */
+Numeric *dense_data(void *wsv, Index rank, long *shape) {
+  switch (rank) {
+    case 1: {
+      Vector &v = *static_cast<Vector *>(wsv);
+      shape[0] = v.nelem();
+      return v.get_c_array();
+    }
+    case 2: {
+      Matrix &m = *static_cast<Matrix *>(wsv);
+      shape[0] = m.nrows();
+      shape[1] = m.ncols();
+      return m.get_c_array();
+    }
+    case 3: {
+      Tensor3 &t = *static_cast<Tensor3 *>(wsv);
+      shape[0] = t.npages();
+      shape[1] = t.nrows();
+      shape[2] = t.ncols();
+      return t.get_c_array();
+    }
+    case 4: {
+      Tensor4 &t = *static_cast<Tensor4 *>(wsv);
+      shape[0] = t.nbooks();
+      shape[1] = t.npages();
+      shape[2] = t.nrows();
+      shape[3] = t.ncols();
+      return t.get_c_array();
+    }
+    case 5: {
+      Tensor5 &t = *static_cast<Tensor5 *>(wsv);
+      shape[0] = t.nshelves();
+      shape[1] = t.nbooks();
+      shape[2] = t.npages();
+      shape[3] = t.nrows();
+      shape[4] = t.ncols();
+      return t.get_c_array();
+    }
+    case 6: {
+      Tensor6 &t = *static_cast<Tensor6 *>(wsv);
+      shape[0] = t.nvitrines();
+      shape[1] = t.nshelves();
+      shape[2] = t.nbooks();
+      shape[3] = t.npages();
+      shape[4] = t.nrows();
+      shape[5] = t.ncols();
+      return t.get_c_array();
+    }
+    case 7: {
+      Tensor7 &t = *static_cast<Tensor7 *>(wsv);
+      shape[0] = t.nlibraries();
+      shape[1] = t.nvitrines();
+      shape[2] = t.nshelves();
+      shape[3] = t.nbooks();
+      shape[4] = t.npages();
+      shape[5] = t.nrows();
+      shape[6] = t.ncols();
+      return t.get_c_array();
+    }
+  }
+  ARTS_ASSERT(false);
+  return nullptr;
+}
+
+/** Resize a dense WSV.
+ *
+ * The storage is kept if the shape does not change.
+ *
+ * @param wsv Pointer to the variable.
+ * @param rank Number of dimensions as returned by dense_rank.
+ * @param shape The new shape.
+ */
+void dense_resize(void *wsv, Index rank, const long *shape) {
+  for (Index i = 0; i < rank; i++)
+    ARTS_USER_ERROR_IF(shape[i] < 0, "Negative size in dimension ", i, ".");
+
+  switch (rank) {
+    case 1:
+      static_cast<Vector *>(wsv)->resize(shape[0]);
+      break;
+    case 2:
+      static_cast<Matrix *>(wsv)->resize(shape[0], shape[1]);
+      break;
+    case 3:
+      static_cast<Tensor3 *>(wsv)->resize(shape[0], shape[1], shape[2]);
+      break;
+    case 4:
+      static_cast<Tensor4 *>(wsv)->resize(
+          shape[0], shape[1], shape[2], shape[3]);
+      break;
+    case 5:
+      static_cast<Tensor5 *>(wsv)->resize(
+          shape[0], shape[1], shape[2], shape[3], shape[4]);
+      break;
+    case 6:
+      static_cast<Tensor6 *>(wsv)->resize(
+          shape[0], shape[1], shape[2], shape[3], shape[4], shape[5]);
+      break;
+    case 7:
+      static_cast<Tensor7 *>(wsv)->resize(shape[0],
+                                          shape[1],
+                                          shape[2],
+                                          shape[3],
+                                          shape[4],
+                                          shape[5],
+                                          shape[6]);
+      break;
+  }
+}
+
+/** Fill view with the data of a dense WSV.
+ *
+ * @param[out] view The view.
+ * @param wsv Pointer to the variable.
+ * @param rank Number of dimensions as returned by dense_rank.
+ */
+void dense_view(ArrayViewStruct &view, void *wsv, Index rank) {
+  view = ArrayViewStruct{};
+  view.ndim = rank;
+  view.ptr = dense_data(wsv, rank, view.shape);
+  long stride = sizeof(Numeric);
+  for (Index i = rank - 1; i >= 0; i--) {
+    view.strides[i] = stride;
+    stride *= view.shape[i];
+  }
+}
+
+/** Fill view with the compressed row storage of a Sparse WSV.
+ *
+ * @param[out] view The view.
+ * @param s The sparse matrix.
+ */
+void sparse_view(ArrayViewStruct &view, Sparse &s) {
+  view = ArrayViewStruct{};
+  view.ndim = 2;
+  view.shape[0] = s.nrows();
+  view.shape[1] = s.ncols();
+  view.nnz = s.nnz();
+  view.ptr = s.get_element_pointer();
+  view.inner_ptr = s.get_column_index_pointer();
+  view.outer_ptr = s.get_row_start_pointer();
+}
+
+/** Copy strided data into contiguous row-major storage.
+ *
+ * @param dst The destination.
+ * @param src Pointer to the first source element.
+ * @param rank Number of dimensions.
+ * @param shape The shape of the data.
+ * @param strides The source strides in bytes.
+ */
+void copy_strided(Numeric *dst,
+                  const char *src,
+                  Index rank,
+                  const long *shape,
+                  const long *strides) {
+  if (rank == 1) {
+    if (strides[0] == sizeof(Numeric)) {
+      const Numeric *first = reinterpret_cast<const Numeric *>(src);
+      std::copy(first, first + shape[0], dst);
+    } else {
+      for (long i = 0; i < shape[0]; i++)
+        dst[i] = *reinterpret_cast<const Numeric *>(src + i * strides[0]);
+    }
+    return;
+  }
+
+  long inner = 1;
+  for (Index i = 1; i < rank; i++) inner *= shape[i];
+  for (long i = 0; i < shape[0]; i++)
+    copy_strided(
+        dst + i * inner, src + i * strides[0], rank - 1, shape + 1, strides + 1);
+}
+
+/** Check that a sparse matrix is given in valid compressed row storage.
+ *
+ * @param view The view of the sparse matrix.
+ */
+void check_compressed_storage(const ArrayViewStruct &view) {
+  ARTS_USER_ERROR_IF(view.ndim != 2, "Sparse matrices must have 2 dimensions.");
+  ARTS_USER_ERROR_IF(view.nnz && (!view.ptr || !view.inner_ptr),
+                     "Element or column index pointer missing.");
+  ARTS_USER_ERROR_IF(!view.outer_ptr, "Row start pointer missing.");
+  ARTS_USER_ERROR_IF(view.outer_ptr[0] != 0 ||
+                         view.outer_ptr[view.shape[0]] != view.nnz,
+                     "Row starts must run from 0 to the number of non-zero "
+                     "elements.");
+  for (long r = 0; r < view.shape[0]; r++) {
+    ARTS_USER_ERROR_IF(view.outer_ptr[r] > view.outer_ptr[r + 1],
+                       "Row starts must not decrease.");
+    for (int k = view.outer_ptr[r]; k < view.outer_ptr[r + 1]; k++) {
+      ARTS_USER_ERROR_IF(view.inner_ptr[k] < 0 ||
+                             view.inner_ptr[k] >= view.shape[1] ||
+                             (k > view.outer_ptr[r] &&
+                              view.inner_ptr[k] <= view.inner_ptr[k - 1]),
+                         "Column indices of row ", r,
+                         " must be increasing and inside the matrix.");
+    }
+  }
+}
+
+/** One execution submitted through the asynchronous API. */
+struct AsyncJob {
+  /** The workspace to execute on. */
+  InteractiveWorkspace *workspace;
+  /** Execute, return the error message or nullptr. */
+  std::function<const char *()> run;
+  /** Set to request cancellation. */
+  std::atomic<bool> cancel{false};
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  /** One of AsyncTaskStatus, guarded by mutex. */
+  long status{ASYNC_QUEUED};
+  /** Error message, guarded by mutex. */
+  std::string error;
+};
+
+/** Handle given out by the asynchronous API. */
+struct AsyncTask {
+  std::shared_ptr<AsyncJob> job;
+};
+
+/** Thread pool for the asynchronous API.
+ *
+ * The jobs of each workspace are kept in their own queue and executed
+ * one after the other. Jobs of different workspaces run concurrently.
+ */
+class AsyncExecutor {
+ public:
+  explicit AsyncExecutor(Index nthreads) {
+    for (Index i = 0; i < nthreads; i++)
+      mthreads.emplace_back(&AsyncExecutor::work, this);
+  }
+
+  AsyncExecutor(const AsyncExecutor &) = delete;
+  AsyncExecutor &operator=(const AsyncExecutor &) = delete;
+
+  /** Finish all submitted jobs and stop the threads. */
+  ~AsyncExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mmutex);
+      mstop = true;
+    }
+    mwork.notify_all();
+    for (auto &t : mthreads) t.join();
+  }
+
+  void submit(const std::shared_ptr<AsyncJob> &job) {
+    {
+      std::lock_guard<std::mutex> lock(mmutex);
+      // A workspace with a running job is added to mready again once
+      // that job has finished
+      auto &queue = mqueues[job->workspace];
+      queue.jobs.push_back(job);
+      if (!queue.running && queue.jobs.size() == 1)
+        mready.push_back(job->workspace);
+    }
+    mwork.notify_one();
+  }
+
+  /** Wait until no job of the given workspace is queued or running. */
+  void wait(InteractiveWorkspace *workspace) {
+    std::unique_lock<std::mutex> lock(mmutex);
+    midle.wait(lock, [&] { return !mqueues.count(workspace); });
+  }
+
+  /** Wait until no job is queued or running. */
+  void wait_all() {
+    std::unique_lock<std::mutex> lock(mmutex);
+    midle.wait(lock, [&] { return mqueues.empty(); });
+  }
+
+ private:
+  struct WorkspaceQueue {
+    std::deque<std::shared_ptr<AsyncJob>> jobs;
+    bool running{false};
+  };
+
+  void work() {
+    std::unique_lock<std::mutex> lock(mmutex);
+    for (;;) {
+      mwork.wait(lock, [&] { return mstop || !mready.empty(); });
+      if (mready.empty()) return;
+
+      InteractiveWorkspace *workspace = mready.front();
+      mready.pop_front();
+      WorkspaceQueue &queue = mqueues[workspace];
+      std::shared_ptr<AsyncJob> job = queue.jobs.front();
+      queue.jobs.pop_front();
+      queue.running = true;
+
+      lock.unlock();
+      execute(*job);
+      lock.lock();
+
+      queue.running = false;
+      if (queue.jobs.empty()) {
+        mqueues.erase(workspace);
+        midle.notify_all();
+      } else {
+        mready.push_back(workspace);
+        mwork.notify_one();
+      }
+    }
+  }
+
+  static void execute(AsyncJob &job) {
+    {
+      std::lock_guard<std::mutex> lock(job.mutex);
+      if (job.cancel) {
+        job.status = ASYNC_CANCELLED;
+        job.error = "Execution was cancelled before it started.";
+        job.finished.notify_all();
+        return;
+      }
+      job.status = ASYNC_RUNNING;
+    }
+
+    Agenda::set_cancel_flag(&job.cancel);
+    const char *error;
+    try {
+      error = job.run();
+    } catch (const std::exception &e) {
+      string_buffer = e.what();
+      error = string_buffer.c_str();
+    }
+    Agenda::set_cancel_flag(nullptr);
+
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (error) {
+      job.status = job.cancel ? ASYNC_CANCELLED : ASYNC_FAILED;
+      job.error = error;
+    } else {
+      job.status = ASYNC_FINISHED;
+    }
+    job.finished.notify_all();
+  }
+
+  std::mutex mmutex;
+  /** Signals new jobs to the threads. */
+  std::condition_variable mwork;
+  /** Signals that all jobs of a workspace have finished. */
+  std::condition_variable midle;
+  std::map<InteractiveWorkspace *, WorkspaceQueue> mqueues;
+  /** Workspaces with queued jobs and no running job. */
+  std::deque<InteractiveWorkspace *> mready;
+  bool mstop{false};
+  std::vector<std::thread> mthreads;
+};
+
+std::mutex async_executor_mutex;
+/** Shared, so that it can be used without holding async_executor_mutex. */
+std::shared_ptr<AsyncExecutor> async_executor;
+Index async_threads = 0;
+
+std::shared_ptr<AsyncExecutor> get_async_executor() {
+  std::lock_guard<std::mutex> lock(async_executor_mutex);
+  if (!async_executor) {
+    Index n = async_threads;
+    if (n <= 0) n = std::max<Index>(1, std::thread::hardware_concurrency());
+    async_executor = std::make_shared<AsyncExecutor>(n);
+  }
+  return async_executor;
+}
+
+AsyncTask *submit_async(InteractiveWorkspace *workspace,
+                        std::function<const char *()> run) {
+  auto job = std::make_shared<AsyncJob>();
+  job->workspace = workspace;
+  job->run = std::move(run);
+  get_async_executor()->submit(job);
+  return new AsyncTask{job};
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Setup and Finalization.
 ////////////////////////////////////////////////////////////////////////////
@@ -72,10 +482,9 @@ void set_basename(const char *name) { out_basename = name; }
 ////////////////////////////////////////////////////////////////////////////
 Agenda *parse_agenda(const char *filename) {
   Agenda *a = new Agenda;
-  ArtsParser parser = ArtsParser(*a, filename, verbosity_at_launch);
 
   try {
-    parser.parse_tasklist();
+    ArtsParser::parse_file(*a, filename, verbosity_at_launch);
     a->set_name(filename);
     a->set_main_agenda();
   } catch (const std::exception &e) {
@@ -193,7 +602,17 @@ InteractiveWorkspace *create_workspace(const Index verbosity,
   return new InteractiveWorkspace(verbosity, agenda_verbosity);
 }
 
-void destroy_workspace(InteractiveWorkspace *workspace) { delete workspace; }
+void destroy_workspace(InteractiveWorkspace *workspace) {
+  // Wait without holding the lock, which would block all other
+  // workspaces from submitting and the executor from being replaced
+  std::shared_ptr<AsyncExecutor> executor;
+  {
+    std::lock_guard<std::mutex> lock(async_executor_mutex);
+    executor = async_executor;
+  }
+  if (executor) executor->wait(workspace);
+  delete workspace;
+}
 
 ////////////////////////////////////////////////////////////////////////////
 // Accessing WSV Group Information
@@ -271,6 +690,73 @@ const char *execute_workspace_method(InteractiveWorkspace *workspace,
   return workspace->execute_workspace_method(id, output, input);
 }
 
+////////////////////////////////////////////////////////////////////////////
+// Asynchronous execution
+////////////////////////////////////////////////////////////////////////////
+
+void set_async_threads(long n) {
+  std::lock_guard<std::mutex> lock(async_executor_mutex);
+  // destroy_workspace may still hold the executor, so wait for the jobs
+  // here instead of relying on the destructor
+  if (async_executor) async_executor->wait_all();
+  async_executor.reset();
+  async_threads = n;
+}
+
+AsyncTask *execute_agenda_async(InteractiveWorkspace *workspace,
+                                const Agenda *a) {
+  Agenda b(*a);
+  b.set_main_agenda();
+  return submit_async(
+      workspace, [workspace, b]() { return workspace->execute_agenda(&b); });
+}
+
+AsyncTask *execute_workspace_method_async(InteractiveWorkspace *workspace,
+                                          long id,
+                                          unsigned long n_args_out,
+                                          const long *args_out,
+                                          unsigned long n_args_in,
+                                          const long *args_in) {
+  ArrayOfIndex output, input;
+  copy_output_and_input(
+      output, input, n_args_out, args_out, n_args_in, args_in);
+  return submit_async(workspace, [workspace, id, output, input]() {
+    return workspace->execute_workspace_method(id, output, input);
+  });
+}
+
+long async_task_status(AsyncTask *task) {
+  std::lock_guard<std::mutex> lock(task->job->mutex);
+  return task->job->status;
+}
+
+long async_task_wait(AsyncTask *task, double timeout) {
+  AsyncJob &job = *task->job;
+  auto done = [&] {
+    return job.status != ASYNC_QUEUED && job.status != ASYNC_RUNNING;
+  };
+
+  std::unique_lock<std::mutex> lock(job.mutex);
+  if (timeout < 0)
+    job.finished.wait(lock, done);
+  else
+    job.finished.wait_for(
+        lock, std::chrono::duration<double>(timeout), done);
+  return job.status;
+}
+
+void async_task_cancel(AsyncTask *task) { task->job->cancel = true; }
+
+const char *async_task_error(AsyncTask *task) {
+  std::lock_guard<std::mutex> lock(task->job->mutex);
+  if (task->job->status != ASYNC_FAILED &&
+      task->job->status != ASYNC_CANCELLED)
+    return nullptr;
+  return task->job->error.c_str();
+}
+
+void destroy_async_task(AsyncTask *task) { delete task; }
+
 const char *method_print_doc(long id) {
   std::stringstream ss;
   ;
@@ -633,6 +1119,136 @@ const char *set_variable_value(InteractiveWorkspace *workspace,
   return nullptr;
 }
 
+const char *get_variable_view(InteractiveWorkspace *workspace,
+                              long id,
+                              long group_id,
+                              ArrayViewStruct *view) {
+  try {
+    ARTS_USER_ERROR_IF(!workspace->is_initialized(id),
+                       "The variable is uninitialized.");
+    if (wsv_group_names[group_id] == "Sparse") {
+      sparse_view(*view, *static_cast<Sparse *>(workspace->operator[](id)));
+    } else {
+      const Index rank = dense_rank(group_id);
+      ARTS_USER_ERROR_IF(!rank,
+                         "Views are only available for Vector, Matrix, "
+                         "Tensor3-7 and Sparse.");
+      dense_view(*view, workspace->operator[](id), rank);
+    }
+  } catch (const std::exception &e) {
+    string_buffer = std::string(e.what());
+    return string_buffer.c_str();
+  }
+  return nullptr;
+}
+
+const char *set_variable_view(InteractiveWorkspace *workspace,
+                              long id,
+                              long group_id,
+                              const ArrayViewStruct *view) {
+  try {
+    if (wsv_group_names[group_id] == "Sparse") {
+      check_compressed_storage(*view);
+      Sparse &s = *static_cast<Sparse *>(workspace->operator[](id));
+
+      // A view of the variable itself is copied into a new matrix, since
+      // resizing frees the storage it points to
+      const bool aliased = view->ptr == s.get_element_pointer() ||
+                           view->inner_ptr == s.get_column_index_pointer() ||
+                           view->outer_ptr == s.get_row_start_pointer();
+      Sparse copy;
+      Sparse &target = aliased ? copy : s;
+
+      target.resize(view->shape[0], view->shape[1], view->nnz);
+      const Numeric *elements = static_cast<const Numeric *>(view->ptr);
+      std::copy(elements, elements + view->nnz, target.get_element_pointer());
+      std::copy(view->inner_ptr,
+                view->inner_ptr + view->nnz,
+                target.get_column_index_pointer());
+      std::copy(view->outer_ptr,
+                view->outer_ptr + view->shape[0] + 1,
+                target.get_row_start_pointer());
+      if (aliased) s = copy;
+    } else {
+      const Index rank = dense_rank(group_id);
+      ARTS_USER_ERROR_IF(!rank,
+                         "Views can only be set for Vector, Matrix, "
+                         "Tensor3-7 and Sparse.");
+      ARTS_USER_ERROR_IF(view->ndim != rank,
+                         "Expected ", rank, " dimensions, got ", view->ndim,
+                         ".");
+      void *wsv = workspace->operator[](id);
+
+      long shape[7];
+      long strides[7];
+      std::copy(view->strides, view->strides + rank, strides);
+      const char *src = static_cast<const char *>(view->ptr);
+      Index size = 1;
+      for (Index i = 0; i < rank; i++) size *= view->shape[i];
+
+      // A view of the variable itself, e.g. a transpose or a slice, is
+      // copied out first, since the storage is overwritten or freed below
+      Numeric *data = dense_data(wsv, rank, shape);
+      Index old_size = 1;
+      for (Index i = 0; i < rank; i++) old_size *= shape[i];
+      std::vector<Numeric> copy;
+      if (size > 0 && old_size &&
+          src >= reinterpret_cast<const char *>(data) &&
+          src < reinterpret_cast<const char *>(data + old_size)) {
+        copy.resize(size);
+        copy_strided(copy.data(), src, rank, view->shape, view->strides);
+        src = reinterpret_cast<const char *>(copy.data());
+        long stride = sizeof(Numeric);
+        for (Index i = rank - 1; i >= 0; i--) {
+          strides[i] = stride;
+          stride *= view->shape[i];
+        }
+      }
+
+      dense_resize(wsv, rank, view->shape);
+      data = dense_data(wsv, rank, shape);
+      if (size) copy_strided(data, src, rank, view->shape, strides);
+    }
+  } catch (const std::exception &e) {
+    string_buffer = std::string(e.what());
+    return string_buffer.c_str();
+  }
+  return nullptr;
+}
+
+const char *resize_variable(InteractiveWorkspace *workspace,
+                            long id,
+                            long group_id,
+                            long ndim,
+                            const long *shape,
+                            long nnz,
+                            ArrayViewStruct *view) {
+  try {
+    if (wsv_group_names[group_id] == "Sparse") {
+      ARTS_USER_ERROR_IF(ndim != 2, "Sparse matrices must have 2 dimensions.");
+      ARTS_USER_ERROR_IF(shape[0] < 0 || shape[1] < 0 || nnz < 0,
+                         "Sizes must not be negative.");
+      Sparse &s = *static_cast<Sparse *>(workspace->operator[](id));
+      s.resize(shape[0], shape[1], nnz);
+      sparse_view(*view, s);
+    } else {
+      const Index rank = dense_rank(group_id);
+      ARTS_USER_ERROR_IF(!rank,
+                         "Only Vector, Matrix, Tensor3-7 and Sparse "
+                         "variables can be resized.");
+      ARTS_USER_ERROR_IF(ndim != rank,
+                         "Expected ", rank, " dimensions, got ", ndim, ".");
+      void *wsv = workspace->operator[](id);
+      dense_resize(wsv, rank, shape);
+      dense_view(*view, wsv, rank);
+    }
+  } catch (const std::exception &e) {
+    string_buffer = std::string(e.what());
+    return string_buffer.c_str();
+  }
+  return nullptr;
+}
+
 long add_variable(InteractiveWorkspace *workspace,
                   long group_id,
                   const char *name) {
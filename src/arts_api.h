@@ -222,6 +222,53 @@ struct CovarianceMatrixBlockStruct {
   const int *outer_ptr;
 };
 
+/** View of array data
+ *
+ * This struct describes memory holding the data of a Vector, Matrix,
+ * Tensor3-7 or Sparse in the style of the Python buffer protocol. It is
+ * used to exchange data with an outside application without copying or
+ * with a single strided copy.
+ */
+struct ArrayViewStruct {
+  /** Data pointer
+   *
+   * Pointer to the first element of a dense array, or to the element
+   * array of a sparse matrix.
+   */
+  void *ptr;
+  /** Number of dimensions
+   *
+   * 1 for Vector, 2 for Matrix and Sparse, 3-7 for Tensor3-7.
+   */
+  long ndim;
+  /** Shape
+   *
+   * Number of elements in each of the first ndim dimensions.
+   */
+  long shape[7];
+  /** Strides
+   *
+   * Distance in bytes between two consecutive elements in each of the
+   * first ndim dimensions. Strides of views set by ARTS always describe
+   * contiguous data in row-major order. Not used for sparse matrices.
+   */
+  long strides[7];
+  /** Number of non-zero elements of a sparse matrix, 0 otherwise. */
+  long nnz;
+  /** Column indices
+   *
+   * Pointer to the nnz column indices of a sparse matrix in compressed
+   * row storage. Null for dense arrays.
+   */
+  int *inner_ptr;
+  /** Row starts
+   *
+   * Pointer to the shape[0] + 1 row start offsets of a sparse matrix
+   * in compressed row storage. Null for dense arrays.
+   */
+  int *outer_ptr;
+};
+
 ////////////////////////////////////////////////////////////////////////////
 // Setup and Finalization.
 ////////////////////////////////////////////////////////////////////////////
@@ -302,8 +349,9 @@ void set_basename(const char *name);
  * to this agenda, which can be executed on a workspace using
  * execute_agenda(...).
  *
- * Note that parsing the same controlfile twice fails if this controlfile
- * creates new WSVs.
+ * Parsing the same controlfile again reuses the earlier result as long as
+ * the file and the files it includes are unchanged. Otherwise, parsing
+ * the same controlfile twice fails if this controlfile creates new WSVs.
  *
  * @param{in] filename The path to the controlfile relative to the ARTS search path.
  * @return Pointer to the agenda holding the parsed controlfile or NULL if
@@ -414,7 +462,10 @@ DLL_PUBLIC
 InteractiveWorkspace *create_workspace(const Index verbosity = 1,
                                        const Index agenda_verbosity = 0);
 
-/** Destroy given workspace. */
+/** Destroy given workspace.
+ *
+ * Waits for all asynchronous executions on the workspace to finish.
+ */
 DLL_PUBLIC
 void destroy_workspace(InteractiveWorkspace *workspace);
 
@@ -512,6 +563,120 @@ const char *execute_workspace_method(InteractiveWorkspace *workspace,
 DLL_PUBLIC
 const char *method_print_doc(long id);
 
+////////////////////////////////////////////////////////////////////////////
+// Asynchronous execution
+////////////////////////////////////////////////////////////////////////////
+
+/** Handle of an asynchronous agenda or method execution. */
+struct AsyncTask;
+
+/** States of an asynchronous execution. */
+enum AsyncTaskStatus {
+  ASYNC_QUEUED = 0,
+  ASYNC_RUNNING = 1,
+  ASYNC_FINISHED = 2,
+  ASYNC_FAILED = 3,
+  ASYNC_CANCELLED = 4
+};
+
+/** Set number of threads for asynchronous execution.
+ *
+ * By default, one thread per processor core is used. Changing the number
+ * waits for all submitted executions to finish.
+ *
+ * @param n The number of threads, 0 to use the default.
+ */
+DLL_PUBLIC
+void set_async_threads(long n);
+
+/** Execute agenda asynchronously.
+ *
+ * Like execute_agenda, but returns immediately. The agenda is copied, so
+ * it can be destroyed before the execution has finished. Executions on
+ * the same workspace run one after the other in the order they were
+ * submitted, executions on different workspaces run concurrently.
+ *
+ * The workspace must not be modified while executions on it are
+ * pending, and no variables may be added while any execution is pending.
+ *
+ * @param workspace Pointer of the InteractiveWorkspace object to execute
+ * the agenda on.
+ * @param a Pointer to the agenda to execute.
+ * @return Handle to the execution, to be freed with destroy_async_task.
+ */
+DLL_PUBLIC
+AsyncTask *execute_agenda_async(InteractiveWorkspace *workspace,
+                                const Agenda *a);
+
+/** Execute workspace method asynchronously.
+ *
+ * Like execute_workspace_method, but returns immediately. See
+ * execute_agenda_async.
+ *
+ * \param workspace Pointer of the InteractiveWorkspace object.
+ * \param id The index of the WSM
+ * \param n_args_out Number of output WSVs.
+ * \param args_out Pointer to the array holding the indices of the output WSVs.
+ * \param n_args_in Number of input WSVs.
+ * \param args_in Pointer to the array holding the indices of the input WSVs.
+ * \return Handle to the execution, to be freed with destroy_async_task.
+ */
+DLL_PUBLIC
+AsyncTask *execute_workspace_method_async(InteractiveWorkspace *workspace,
+                                          long id,
+                                          unsigned long n_args_out,
+                                          const long *args_out,
+                                          unsigned long n_args_in,
+                                          const long *args_in);
+
+/** Status of an asynchronous execution.
+ *
+ * @param task The execution.
+ * @return One of AsyncTaskStatus.
+ */
+DLL_PUBLIC
+long async_task_status(AsyncTask *task);
+
+/** Wait for an asynchronous execution to finish.
+ *
+ * @param task The execution.
+ * @param timeout Maximum time to wait in seconds. Waits until the execution
+ * has finished if negative.
+ * @return One of AsyncTaskStatus.
+ */
+DLL_PUBLIC
+long async_task_wait(AsyncTask *task, double timeout);
+
+/** Cancel an asynchronous execution.
+ *
+ * A queued execution is not started. A running agenda stops before its
+ * next method. A running workspace method is not interrupted. This
+ * includes agendas that a method executes on OpenMP worker threads, e.g.
+ * in ybatchCalc, since only the thread of the execution checks the flag.
+ *
+ * @param task The execution.
+ */
+DLL_PUBLIC
+void async_task_cancel(AsyncTask *task);
+
+/** Error message of a failed or cancelled asynchronous execution.
+ *
+ * @param task The execution.
+ * @return Pointer to the c_str holding the error message, NULL if the
+ * execution has not failed.
+ */
+DLL_PUBLIC
+const char *async_task_error(AsyncTask *task);
+
+/** Free the handle of an asynchronous execution.
+ *
+ * This does not cancel the execution.
+ *
+ * @param task The execution.
+ */
+DLL_PUBLIC
+void destroy_async_task(AsyncTask *task);
+
 ////////////////////////////////////////////////////////////////////////////
 // Accessing and Manipulating WSVs
 ////////////////////////////////////////////////////////////////////////////
@@ -611,6 +776,75 @@ const char *set_variable_value(InteractiveWorkspace *workspace,
                                long id,
                                long group_id,
                                VariableValueStruct value);
+
+/** Get a view of the data of a WSV.
+ *
+ * For variables of type Vector, Matrix, Tensor3-7 and Sparse, the view
+ * points directly to the storage of the variable in the workspace, so
+ * the data can be read and modified without copying. The view becomes
+ * invalid when the variable is resized, set or erased.
+ *
+ * @param workspace Pointer to a InteractiveWorkspace object.
+ * @param id Index of the workspace variable.
+ * @param group_id Index of the group the variable belongs to.
+ * @param[out] view The view of the data.
+ * @return Pointer to null-terminated string containing the error message,
+ * or null on success.
+ */
+DLL_PUBLIC
+const char *get_variable_view(InteractiveWorkspace *workspace,
+                              long id,
+                              long group_id,
+                              ArrayViewStruct *view);
+
+/** Set the value of a WSV from a view of external data.
+ *
+ * The data is copied directly into the storage of the variable, which is
+ * only reallocated if the shape changes. For dense arrays, any strides
+ * are accepted, so non-contiguous arrays and views of other arrays do
+ * not have to be copied into contiguous memory first. Sparse matrices are
+ * given in compressed row storage and copied without sorting.
+ *
+ * @param workspace Pointer to a InteractiveWorkspace object.
+ * @param id Index of the workspace variable.
+ * @param group_id Index of the group the variable belongs to.
+ * @param view The view of the data.
+ * @return Pointer to null-terminated string containing the error message,
+ * or null on success.
+ */
+DLL_PUBLIC
+const char *set_variable_view(InteractiveWorkspace *workspace,
+                              long id,
+                              long group_id,
+                              const ArrayViewStruct *view);
+
+/** Resize a WSV and get a view of its storage.
+ *
+ * This allocates the storage of a Vector, Matrix, Tensor3-7 or Sparse
+ * variable inside ARTS, so that an outside application can fill it in
+ * place without any further copy. For sparse matrices nnz elements are
+ * allocated and the element, column index and row start arrays of the
+ * returned view have to be filled in compressed row storage. The
+ * contents of dense arrays are undefined if the shape changed.
+ *
+ * @param workspace Pointer to a InteractiveWorkspace object.
+ * @param id Index of the workspace variable.
+ * @param group_id Index of the group the variable belongs to.
+ * @param ndim Number of dimensions given in shape.
+ * @param shape The new shape.
+ * @param nnz The number of non-zero elements for sparse matrices.
+ * @param[out] view The view of the storage.
+ * @return Pointer to null-terminated string containing the error message,
+ * or null on success.
+ */
+DLL_PUBLIC
+const char *resize_variable(InteractiveWorkspace *workspace,
+                            long id,
+                            long group_id,
+                            long ndim,
+                            const long *shape,
+                            long nnz,
+                            ArrayViewStruct *view);
 /** Add variable of given type to workspace.
  *
  * This adds and initializes a variable in the current workspace and also
@@ -38,6 +38,8 @@
 #include <omp.h>
 #endif
 
+#include "matpack.h"
+
 int arts_omp_get_max_threads();
 
 bool arts_omp_in_parallel();
@@ -50,4 +52,37 @@ void arts_omp_set_nested(int i);
 
 void arts_omp_set_dynamic(int i);
 
+//! Run a loop as OpenMP tasks.
+/*!
+  Calls body(i) for i = 0, ..., n-1, one task per iteration.
+
+  Outside of a parallel region a new team of threads is started for the
+  tasks. Inside a parallel region the tasks are added to the enclosing
+  team, so threads that have finished their own work pick them up instead
+  of idling. This makes it possible to nest loops of very different cost,
+  e.g. batch cases, measurement blocks and line-of-sights, and still keep
+  all threads busy. Inner loops using
+  "#pragma omp parallel for if (!arts_omp_in_parallel())" are run serially
+  inside the tasks, as before.
+
+  Iterations are started in order but are not guaranteed to finish in
+  order. The body must not throw, errors have to be caught and reported
+  inside the body. Without OMP support the loop is run serially.
+
+  \param n Number of iterations.
+  \param body Loop body, called with the iteration index.
+*/
+template <typename LoopBody>
+void arts_omp_taskloop(const Index n, LoopBody&& body) {
+  if (arts_omp_in_parallel()) {
+#pragma omp taskloop grainsize(1) shared(body)
+    for (Index i = 0; i < n; i++) body(i);
+  } else {
+#pragma omp parallel shared(body)
+#pragma omp single
+#pragma omp taskloop grainsize(1) shared(body)
+    for (Index i = 0; i < n; i++) body(i);
+  }
+}
+
 #endif  // arts_omp_h
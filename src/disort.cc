@@ -25,12 +25,14 @@
  */
 
 #include "disort.h"
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 #include "agenda_class.h"
 #include "array.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 
@@ -599,7 +601,8 @@ thread_local Verbosity disort_verbosity;
 /** Verbosity enabled replacement for the original cdisort function. */
 void c_errmsg(const char* messag, int type) {
   Verbosity verbosity = disort_verbosity;
-  static int warning_limit = FALSE, num_warnings = 0;
+  // Called from all threads of run_cdisort
+  static std::atomic<int> warning_limit{FALSE}, num_warnings{0};
 
   if (type == DS_ERROR) {
     CREATE_OUT0;
@@ -627,14 +630,14 @@ void c_errmsg(const char* messag, int type) {
 /** Verbosity enabled replacement for the original cdisort function. */
 int c_write_bad_var(int quiet, const char* varnam) {
   const int maxmsg = 50;
-  static int nummsg = 0;
+  static std::atomic<int> nummsg{0};
 
-  nummsg++;
+  const int msgnum = ++nummsg;
   if (quiet != QUIET) {
     Verbosity verbosity = disort_verbosity;
     CREATE_OUT1;
     out1 << "  ****  Input variable " << varnam << " in error  ****\n";
-    if (nummsg == maxmsg) {
+    if (msgnum == maxmsg) {
       c_errmsg("Too many input errors.  Aborting...", DS_ERROR);
     }
   }
@@ -770,13 +773,13 @@ void run_cdisort(Workspace& ws,
                 pnd_profiles,
                 cloudbox_limits);
 
-  disort_state ds;
-  disort_output out;
+  // Settings shared by all frequencies. Each thread makes its own copy of
+  // this state with separately allocated arrays.
+  disort_state ds{};
 
-  if (quiet == 0)
-    disort_verbosity = verbosity;
-  else
-    disort_verbosity = Verbosity(0, 0, 0);
+  const Verbosity disort_thread_verbosity =
+      quiet == 0 ? verbosity : Verbosity(0, 0, 0);
+  disort_verbosity = disort_thread_verbosity;
 
   const Index nf = f_grid.nelem();
 
@@ -814,21 +817,12 @@ void run_cdisort(Workspace& ws,
   ds.nphi = 1;
   Index Nlegendre = nstreams + 1;
 
-  /* Allocate memory */
-  c_disort_state_alloc(&ds);
-  c_disort_out_alloc(&ds, &out);
-
   // Properties of solar beam, set to zero as they are not needed
   ds.bc.fbeam = 0.;
   ds.bc.umu0 = 0.;
   ds.bc.phi0 = 0.;
   ds.bc.fluor = 0.;
 
-  // Since we have no solar source there is no angular dependance
-  ds.phi[0] = 0.;
-
-  for (Index i = 0; i <= ds.nlyr; i++) ds.temper[i] = t[ds.nlyr - i];
-
   Matrix ext_bulk_gas(nf, ds.nlyr + 1);
   get_gasoptprop(ws, ext_bulk_gas, propmat_clearsky_agenda, t, vmr, p, f_grid);
   Matrix ext_bulk_par(nf, ds.nlyr + 1), abs_bulk_par(nf, ds.nlyr + 1);
@@ -841,9 +835,6 @@ void run_cdisort(Workspace& ws,
   Matrix ssalb(nf, ds.nlyr);
   get_dtauc_ssalb(dtauc, ssalb, ext_bulk_gas, ext_bulk_par, abs_bulk_par, z);
 
-  // Transform to mu, starting with negative values
-  for (Index i = 0; i < ds.numu; i++) ds.umu[i] = -cos(za_grid[i] * PI / 180);
-
   //upper boundary conditions:
   // DISORT offers isotropic incoming radiance or emissivity-scaled planck
   // emission. Both are applied additively.
@@ -878,34 +869,58 @@ void run_cdisort(Workspace& ws,
   Tensor3 pmom(nf_ssd, ds.nlyr, Nlegendre, 0.);
   get_pmom(pmom, pfct_bulk_par, pfct_angs, Nlegendre);
 
-  for (Index f_index = 0; f_index < f_grid.nelem(); f_index++) {
-    sprintf(ds.header, "ARTS Calc f_index = %ld", f_index);
+  // Allocate the arrays of a thread's copy of the state and set the parts
+  // that do not depend on frequency
+  auto alloc_state = [&](disort_state& tds, disort_output& tout) {
+    tds = ds;
+    c_disort_state_alloc(&tds);
+    c_disort_out_alloc(&tds, &tout);
+
+    // Since we have no solar source there is no angular dependance
+    tds.phi[0] = 0.;
+
+    for (Index i = 0; i <= tds.nlyr; i++) tds.temper[i] = t[tds.nlyr - i];
+
+    // Transform to mu, starting with negative values
+    for (Index i = 0; i < tds.numu; i++)
+      tds.umu[i] = -cos(za_grid[i] * PI / 180);
+  };
 
-    std::memcpy(ds.dtauc,
+  auto free_state = [](disort_state& tds, disort_output& tout) {
+    c_disort_out_free(&tds, &tout);
+    c_disort_state_free(&tds);
+  };
+
+  auto calc_frequency = [&](disort_state& tds,
+                            disort_output& tout,
+                            const Index f_index) {
+    sprintf(tds.header, "ARTS Calc f_index = %ld", f_index);
+
+    std::memcpy(tds.dtauc,
                 dtauc(f_index, joker).get_c_array(),
-                sizeof(Numeric) * ds.nlyr);
-    std::memcpy(ds.ssalb,
+                sizeof(Numeric) * tds.nlyr);
+    std::memcpy(tds.ssalb,
                 ssalb(f_index, joker).get_c_array(),
-                sizeof(Numeric) * ds.nlyr);
+                sizeof(Numeric) * tds.nlyr);
 
     // Wavenumber in [1/cm]
-    ds.wvnmhi = ds.wvnmlo = (f_grid[f_index]) / (100. * SPEED_OF_LIGHT);
-    ds.wvnmhi += ds.wvnmhi * 1e-7;
-    ds.wvnmlo -= ds.wvnmlo * 1e-7;
+    tds.wvnmhi = tds.wvnmlo = (f_grid[f_index]) / (100. * SPEED_OF_LIGHT);
+    tds.wvnmhi += tds.wvnmhi * 1e-7;
+    tds.wvnmlo -= tds.wvnmlo * 1e-7;
 
-    ds.bc.albedo = surface_scalar_reflectivity[f_index];
+    tds.bc.albedo = surface_scalar_reflectivity[f_index];
 
-    std::memcpy(ds.pmom,
+    std::memcpy(tds.pmom,
                 pmom(f_index, joker, joker).get_c_array(),
                 sizeof(Numeric) * pmom.nrows() * pmom.ncols());
 
-    c_disort(&ds, &out);
+    c_disort(&tds, &tout);
 
-    for (Index j = 0; j < ds.numu; j++) {
+    for (Index j = 0; j < tds.numu; j++) {
       for (Index k = cboxlims[1] - cboxlims[0]; k >= 0; k--) {
         cloudbox_field(f_index, k + ncboxremoved, 0, 0, j, 0, 0) =
-            out.uu[ds.numu * (ds.nlyr - k - cboxlims[0]) + j] /
-            (ds.wvnmhi - ds.wvnmlo) / (100 * SPEED_OF_LIGHT);
+            tout.uu[tds.numu * (tds.nlyr - k - cboxlims[0]) + j] /
+            (tds.wvnmhi - tds.wvnmlo) / (100 * SPEED_OF_LIGHT);
       }
       // To avoid potential numerical problems at interpolation of the field,
       // we copy the surface field to underground altitudes
@@ -914,11 +929,24 @@ void run_cdisort(Workspace& ws,
             cloudbox_field(f_index, k + 1, 0, 0, j, 0, 0);
       }
     }
-  }
+  };
+
+  // The function-static variables of cdisort, e.g. its call counter and
+  // the tables it sets up on the first call, are thread-local
+#pragma omp parallel if (!arts_omp_in_parallel() && nf > 1)
+  {
+    disort_verbosity = disort_thread_verbosity;
 
-  /* Free allocated memory */
-  c_disort_out_free(&ds, &out);
-  c_disort_state_free(&ds);
+    disort_state tds;
+    disort_output tout;
+    alloc_state(tds, tout);
+
+#pragma omp for schedule(dynamic)
+    for (Index f_index = 0; f_index < nf; f_index++)
+      calc_frequency(tds, tout, f_index);
+
+    free_state(tds, tout);
+  }
 }
 
 void surf_albedoCalc(Workspace& ws,
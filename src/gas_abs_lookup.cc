@@ -24,13 +24,21 @@
 */
 
 #include "gas_abs_lookup.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
+#include <fstream>
 #include "check_input.h"
+#include "file.h"
 #include "interpolation.h"
 #include "logic.h"
 #include "messages.h"
 #include "physics_funcs.h"
+#include "xml_io_types.h"
 
 //! Find positions of new grid points in old grid.
 /*! 
@@ -217,7 +225,11 @@ void GasAbsLookup::Adapt(const ArrayOfArrayOfSpeciesTag& current_species,
   //
   //     Dimension: [ a, b, c, d ]
   //
-  if (0 == n_nls) {
+  // The dimensions of a memory-mapped table have been checked by
+  // ReadMapped.
+  if (mapped_xsec) {
+    // Nothing to check here.
+  } else if (0 == n_nls) {
     if (0 == t_pert.nelem()) {
       //     Simplest case (no temperature perturbations,
       //     no vmr perturbations):
@@ -400,49 +412,63 @@ void GasAbsLookup::Adapt(const ArrayOfArrayOfSpeciesTag& current_species,
   }
 
   // Absorption coefficients:
-  new_table.xsec.resize(
-      xsec.nbooks(),
-      n_current_species + n_current_nonlinear_species * (n_nls_pert - 1),
-      n_current_f_grid,
-      xsec.ncols());
-
-  // We have to copy the right species and frequencies from the old to
-  // the new table. Temperature perturbations and pressure grid remain
-  // the same.
-
-  // Do species:
-  for (Index i_s = 0, sp = 0; i_s < n_current_species; ++i_s) {
-    // n_v is the number of VMR perturbations
-    Index n_v;
-    if (current_non_linear[i_s])
-      n_v = n_nls_pert;
-    else
-      n_v = 1;
-
-    //      cout << "i_s / sp / n_v = " << i_s << " / " << sp << " / " << n_v << endl;
-    //      cout << "orig_pos = " << original_spec_pos_in_xsec[i_current_species[i_s]] << endl;
-
-    // Do frequencies:
-    for (Index i_f = 0; i_f < n_current_f_grid; ++i_f) {
-      if (i_current_species[i_s] >= 0) {
-        new_table.xsec(Range(joker), Range(sp, n_v), i_f, Range(joker)) =
-            xsec(Range(joker),
-                 Range(original_spec_pos_in_xsec[i_current_species[i_s]], n_v),
-                 i_current_f_grid[i_f],
-                 Range(joker));
-      } else {
-        // Here we handle the case of the trivial species, which we simply
-        // set to NAN:
-        new_table.xsec(Range(joker), Range(sp, n_v), i_f, Range(joker)) = NAN;
-      }
 
-      //           cout << "result: " << xsec( Range(joker),
-      //                                       Range(original_spec_pos_in_xsec[i_current_species[i_s]],n_v),
-      //                                       i_current_f_grid[i_f],
-      //                                       Range(joker) ) << endl;
-    }
+  // A memory-mapped table that already has the right species and
+  // frequencies is kept mapped.
+  bool keep_mapping = mapped_xsec and n_current_species == n_species and
+                      n_current_f_grid == n_f_grid;
+  for (Index i = 0; keep_mapping and i < n_current_species; ++i)
+    keep_mapping = i_current_species[i] == i;
+  for (Index i = 0; keep_mapping and i < n_current_f_grid; ++i)
+    keep_mapping = i_current_f_grid[i] == i;
+
+  // Used to decode a pressure level of a mapped table:
+  Tensor3 level_buffer;
+
+  if (keep_mapping) {
+    out3 << "  Keeping the memory-mapped cross sections.\n";
+    new_table.mapped_xsec = mapped_xsec;
+  } else {
+    new_table.xsec.resize(
+        std::max<Index>(t_pert.nelem(), 1),
+        n_current_species + n_current_nonlinear_species * (n_nls_pert - 1),
+        n_current_f_grid,
+        n_p_grid);
+
+    // We have to copy the right species and frequencies from the old to
+    // the new table. Temperature perturbations and pressure grid remain
+    // the same. This is done one pressure level at a time, so that
+    // a memory-mapped table never has to be fully decoded.
+    for (Index i_p = 0; i_p < n_p_grid; ++i_p) {
+      // Cross sections of this level, dimension [T, H2O, frequency]:
+      const ConstTensor3View level = XsecLevel(level_buffer, i_p);
+
+      // Do species:
+      for (Index i_s = 0, sp = 0; i_s < n_current_species; ++i_s) {
+        // n_v is the number of VMR perturbations
+        Index n_v;
+        if (current_non_linear[i_s])
+          n_v = n_nls_pert;
+        else
+          n_v = 1;
+
+        // Do frequencies:
+        for (Index i_f = 0; i_f < n_current_f_grid; ++i_f) {
+          if (i_current_species[i_s] >= 0) {
+            new_table.xsec(Range(joker), Range(sp, n_v), i_f, i_p) = level(
+                Range(joker),
+                Range(original_spec_pos_in_xsec[i_current_species[i_s]], n_v),
+                i_current_f_grid[i_f]);
+          } else {
+            // Here we handle the case of the trivial species, which we simply
+            // set to NAN:
+            new_table.xsec(Range(joker), Range(sp, n_v), i_f, i_p) = NAN;
+          }
+        }
 
-    sp += n_v;
+        sp += n_v;
+      }
+    }
   }
 
   // 4. Replace original table by the new one.
@@ -498,9 +524,9 @@ void GasAbsLookup::Adapt(const ArrayOfArrayOfSpeciesTag& current_species,
 
   \param[in] new_f_grid The frequency grid where absorption should be 
              extracted. With frequency interpolation order 0, this has
-             to match the lookup table's internal grid, or have exactly
-             1 element. With higher frequency interpolation order it can be
-             an arbitrary grid.
+             to match the lookup table's internal grid, a contiguous part
+             of it, or have exactly 1 element. With higher frequency
+             interpolation order it can be an arbitrary grid.
  
   \param[in] extpolfac How much extrapolation to allow. Useful for Doppler 
              calculations. (But there even better to make the lookup table
@@ -520,6 +546,64 @@ void GasAbsLookup::Extract(Matrix& sga,
                            ConstVectorView abs_vmrs,
                            ConstVectorView new_f_grid,
                            const Numeric& extpolfac) const {
+  sga.resize(species.nelem(), new_f_grid.nelem());
+
+  // A single point is a path with one point:
+  Extract(Tensor3View(sga),
+          p_interp_order,
+          t_interp_order,
+          h2o_interp_order,
+          f_interp_order,
+          ConstVectorView(p),
+          ConstVectorView(T),
+          ConstMatrixView(abs_vmrs),
+          new_f_grid,
+          extpolfac);
+}
+
+//! Extract scalar gas absorption coefficients for many atmospheric points.
+/*!
+  This does the same as the Extract above, for all points of, e.g., a
+  propagation path at once. The checks of the table and the frequency
+  interpolation are done only once for all points, and all buffers are
+  reused from point to point. Without temperature interpolation also the
+  interpolation weights are computed only once.
+
+  \param[out] sga_path Scalar gas absorption coefficients [1/m].
+              Dimension: [n_points, n_species, new_f_grid]. This must
+              already have the right size, but can be a view of a larger
+              tensor.
+
+  \param[in] p_interp_order Interpolation order for pressure.
+
+  \param[in] t_interp_order Interpolation order for temperature.
+
+  \param[in] h2o_interp_order Interpolation order for water vapor.
+
+  \param[in] f_interp_order Interpolation order for frequency.
+
+  \param[in] p_path The pressures [Pa]. Dimension: [n_points].
+
+  \param[in] t_path The temperatures [K]. Dimension: [n_points].
+
+  \param[in] abs_vmrs_path The VMRs [absolute number].
+             Dimension: [species, n_points].
+
+  \param[in] new_f_grid The frequency grid where absorption should be
+             extracted, see above.
+
+  \param[in] extpolfac How much extrapolation to allow.
+*/
+void GasAbsLookup::Extract(Tensor3View sga_path,
+                           const Index& p_interp_order,
+                           const Index& t_interp_order,
+                           const Index& h2o_interp_order,
+                           const Index& f_interp_order,
+                           ConstVectorView p_path,
+                           ConstVectorView t_path,
+                           ConstMatrixView abs_vmrs_path,
+                           ConstVectorView new_f_grid,
+                           const Numeric& extpolfac) const {
   // 1. Obtain some properties of the lookup table:
 
   // Number of gas species in the table:
@@ -595,7 +679,9 @@ void GasAbsLookup::Extract(Matrix& sga,
     //            << b << ", "
     //            << c << ", "
     //            << d << "\n";
-    ARTS_ASSERT(is_size(xsec, a, b, c, d));
+    Tensor3 buffer;
+    ARTS_ASSERT(is_size(XsecLevel(buffer, 0), a, b, c));
+    ARTS_ASSERT(IsMapped() or is_size(xsec, a, b, c, d));
   })
 
   // Make sure that log_p_grid is initialized:
@@ -647,8 +733,13 @@ void GasAbsLookup::Extract(Matrix& sga,
 
   // 3. Checks on the input variables:
 
+  // Number of atmospheric points:
+  const Index n_points = p_path.nelem();
+  ARTS_ASSERT(is_size(t_path, n_points));
+  ARTS_ASSERT(abs_vmrs_path.ncols() == n_points);
+
   // Check that abs_vmrs has the right dimension:
-  if (!is_size(abs_vmrs, n_species)) {
+  if (abs_vmrs_path.nrows() != n_species) {
     ostringstream os;
     os << "Number of species in lookup table does not match number\n"
        << "of species for which you want to extract absorption.\n"
@@ -657,6 +748,11 @@ void GasAbsLookup::Extract(Matrix& sga,
     throw runtime_error(os.str());
   }
 
+  ARTS_ASSERT(is_size(sga_path, n_points, n_species, n_new_f_grid));
+
+  // Nothing to extract without frequencies or points:
+  if (!n_new_f_grid || !n_points) return;
+
   // 4. Set up some things we will need later on:
 
   // 4.a Frequency grid positions
@@ -667,9 +763,10 @@ void GasAbsLookup::Extract(Matrix& sga,
   ArrayOfLagrangeInterpolation flag_local;
 
   // With f_interp_order 0 the frequency grid has to have the same size as in the
-  // lookup table, or exactly one element. If it matches the lookup table, we
-  // do no frequency interpolation at all. (We set the frequency grid positions
-  // to the predefined ones that come with the lookup table.)
+  // lookup table, be a contiguous part of it, or have exactly one element. If
+  // it matches the lookup table, we do no frequency interpolation at all. (We
+  // set the frequency grid positions to the predefined ones that come with the
+  // lookup table.)
   if (f_interp_order == 0) {
 
     // We do some superficial checks below, to make sure that the
@@ -720,10 +817,25 @@ void GasAbsLookup::Extract(Matrix& sga,
 	throw runtime_error(os.str());
       }
     } else {
-      ostringstream os;
-      os << "With f_interp_order 0 the frequency grid has to have the same\n"
-         << "size as in the lookup table, or exactly one element.";
-      throw runtime_error(os.str());
+      // A contiguous part of the lookup table grid, e.g. a frequency
+      // block of iyEmissionStandard. It is located by its first
+      // frequency, and checked as the full grid above.
+      const Index i0 =
+          LagrangeInterpolation(0, new_f_grid[0], f_grid, 0).pos;
+      if (i0 + n_new_f_grid > n_f_grid ||
+          abs(f_grid[i0] - new_f_grid[0]) > allowed_f_margin ||
+          abs(f_grid[i0 + n_new_f_grid - 1] - new_f_grid[n_new_f_grid - 1]) >
+              allowed_f_margin) {
+        ostringstream os;
+        os << "With f_interp_order 0 the frequency grid has to be the\n"
+           << "grid of the lookup table, a contiguous part of it, or have\n"
+           << "exactly one element.";
+        throw runtime_error(os.str());
+      }
+
+      flag = &flag_local;
+      flag_local.assign(flag_default.begin() + i0,
+                        flag_default.begin() + i0 + n_new_f_grid);
     }
   } else {
     const Numeric f_min = f_grid[0] - 0.5 * (f_grid[1] - f_grid[0]);
@@ -752,6 +864,21 @@ void GasAbsLookup::Extract(Matrix& sga,
     flag_local = Interpolation::LagrangeVector(new_f_grid, f_grid, f_interp_order);
   }
 
+  // The range of table frequencies that the interpolation uses. Only these
+  // have to be decoded if the table is mapped with reduced precision.
+  Index f_first = n_f_grid - 1, f_last = 0;
+  for (const auto& fl : *flag) {
+    f_first = min(f_first, fl.pos);
+    f_last = max(f_last, fl.pos + fl.size() - 1);
+  }
+
+  // The levels returned by XsecLevel start at f_first, so the grid
+  // positions are made relative to it. The default positions start at 0.
+  if (f_first > 0) {
+    ARTS_ASSERT(flag == &flag_local);
+    for (auto& fl : flag_local) fl.pos -= f_first;
+  }
+
   // 4.b Other stuff
 
   // Flag for temperature interpolation, if this is not 0 we want
@@ -764,39 +891,6 @@ void GasAbsLookup::Extract(Matrix& sga,
     non_linear[nonlinear_species[s]] = 1;
   }
 
-  // Calculate the number density for the given pressure and
-  // temperature:
-  // n = n0*T0/p0 * p/T or n = p/kB/t, ideal gas law
-  const Numeric n = number_density(p, T);
-
-  // 5. Determine pressure grid position and interpolation weights:
-
-  // Check that p is inside the grid. (p_grid is sorted in decreasing order.)
-  {
-    const Numeric p_max = p_grid[0] + 0.5 * (p_grid[0] - p_grid[1]);
-    const Numeric p_min = p_grid[n_p_grid - 1] -
-                          0.5 * (p_grid[n_p_grid - 2] - p_grid[n_p_grid - 1]);
-    if ((p > p_max) || (p < p_min)) {
-      ostringstream os;
-      os << "Problem with gas absorption lookup table.\n"
-         << "Pressure p is outside the range covered by the lookup table.\n"
-         << "Your p value is " << p << " Pa.\n"
-         << "The allowed range is " << p_min << " to " << p_max << ".\n"
-         << "The pressure grid range in the table is " << p_grid[n_p_grid - 1]
-         << " to " << p_grid[0] << ".\n"
-         << "We allow a bit of extrapolation, but NOT SO MUCH!";
-      throw runtime_error(os.str());
-    }
-  }
-
-  // For sure, we need to store the pressure grid position.
-  // We do the interpolation in log(p). Test have shown that this
-  // gives slightly better accuracy than interpolating in p directly.
-  const auto plag = Interpolation::LagrangeVector(log(p), log_p_grid, p_interp_order);
-
-  // Pressure interpolation weights:
-  const auto pitw = interpweights(plag[0]);
-
   // Define also other grid positions and interpolation weights here, so that
   // we do not have to allocate them over and over in the loops below.
 
@@ -821,10 +915,6 @@ void GasAbsLookup::Extract(Matrix& sga,
   const ArrayOfLagrangeInterpolation* vlag;
   ArrayOfLagrangeInterpolation vlag_h2o(1);  // only a scalar
 
-  // 6. We do the T and VMR interpolation for the pressure levels
-  // that are used in the pressure interpolation. (How many depends on
-  // p_interp_order.)
-
   // To store the interpolated result for the p_interp_order+1
   // pressure levels:
   // xsec dimensions are:
@@ -849,265 +939,773 @@ void GasAbsLookup::Extract(Matrix& sga,
   Tensor3OfTensor3 itw_withH2O(0,0,0), itw_noH2O(0,0,0);
   const Tensor3OfTensor3 *itw;
 
-  for (Index pi = 0; pi < p_interp_order + 1; ++pi) {
-    // Throw a runtime error if one of the reference VMR profiles is zero, but
-    // abs_vmrs is not. (This means that the lookup table was calculated with a
-    // reference profile of zero for that gas.)
-    //      for (Index si=0; si<n_species; ++si)
-    //        if ( (vmrs_ref(si,pi) == 0) &&
-    //            (abs_vmrs[si]    != 0) )
-    //        {
-    //          ostringstream os;
-    //          os << "Reference VMR profile is zero, you cannot extract\n"
-    //          << "Absorption for this species.\n"
-    //          << "Species: " << si
-    //          << " (" << get_species_name(species[si]) << ")\n"
-    //          << "Lookup table pressure level: " << pi
-    //          << " (" <<  p_grid[pi] << " Pa).";
-    //          throw runtime_error( os.str() );
-    //        }
-
-    // Index into p_grid:
-    const Index this_p_grid_index = plag[0].pos + pi;
-
-    // Determine temperature grid position. This is only done if we
-    // want temperature interpolation, but the variable tgp has to
-    // be visible also outside for later use:
-    if (do_T) {
-      // Temperature in the atmosphere is altitude
-      // dependent. When we do the interpolation for the pressure level
-      // below and above our point, we should correct the target value of
-      // the interpolation to the altitude (pressure) difference. This
-      // ensures that there is for example no T interpolation if the
-      // desired T is right on the reference profile curve.
-      //
-      // I explicitly compared this with the old option to calculate
-      // the temperature offset relative to the temperature at
-      // this level. The performance in both cases is very
-      // similar. The reason, why I decided to keep this new
-      // version, is that it avoids the problem of needing
-      // oversized temperature perturbations if the pressure
-      // grid is coarse.
-      //
-      // No! The above approach leads to problems when combined with
-      // higher order pressure interpolation. The problem is that
-      // the reference T and VMR profiles may be very
-      // irregular. (For example the H2O profile often has a big
-      // jump near the bottom.) That sometimes leads to negative
-      // effective reference values when the reference profile is
-      // interpolated. I therefore reverted back to the original
-      // version of using the real temperature and humidity, not
-      // the interpolated one.
-
-      //          const Numeric effective_T_ref = interp(pitw,t_ref,pgp);
-      const Numeric effective_T_ref = t_ref[this_p_grid_index];
-
-      // Convert temperature to offset from t_ref:
-      const Numeric T_offset = T - effective_T_ref;
-
-      //          cout << "T_offset = " << T_offset << endl;
-
-      // Check that temperature offset is inside the allowed range.
-      {
-        const Numeric t_min = t_pert[0] - extpolfac * (t_pert[1] - t_pert[0]);
-        const Numeric t_max =
-            t_pert[n_t_pert - 1] +
-            extpolfac * (t_pert[n_t_pert - 1] - t_pert[n_t_pert - 2]);
-        if ((T_offset > t_max) || (T_offset < t_min)) {
-          ostringstream os;
-          os << "Problem with gas absorption lookup table.\n"
-             << "Temperature T is outside the range covered by the lookup table.\n"
-             << "Your temperature was " << T << " K at a pressure of " << p
-             << " Pa.\n"
-             << "The temperature offset value is " << T_offset << ".\n"
-             << "The allowed range is " << t_min << " to " << t_max << ".\n"
-             << "The temperature perturbation grid range in the table is "
-             << t_pert[0] << " to " << t_pert[n_t_pert - 1] << ".\n"
-             << "We allow a bit of extrapolation, but NOT SO MUCH!";
-          throw runtime_error(os.str());
-        }
-      }
+  // Without temperature interpolation, the weights without H2O
+  // interpolation do not depend on the point, so we compute them here.
+  if (!do_T && n_nls < n_species) {
+    itw_noH2O = interpweights(*tlag, lag_trivial, *flag);
+  }
+
+  // Used to decode a pressure level of a mapped table:
+  Tensor3 level_buffer;
+
+  // 5. Loop the atmospheric points:
+  for (Index ip = 0; ip < n_points; ++ip) {
+    const Numeric p = p_path[ip];
+    const Numeric T = t_path[ip];
+    const ConstVectorView abs_vmrs = abs_vmrs_path(joker, ip);
+    MatrixView sga = sga_path(ip, joker, joker);
 
-      tlag_withT[0] = LagrangeInterpolation(0, T_offset, t_pert, t_interp_order);
+    // Calculate the number density for the given pressure and
+    // temperature:
+    // n = n0*T0/p0 * p/T or n = p/kB/t, ideal gas law
+    const Numeric n = number_density(p, T);
+
+    // 5.a Determine pressure grid position and interpolation weights:
+
+    // Check that p is inside the grid. (p_grid is sorted in decreasing order.)
+    {
+      const Numeric p_max = p_grid[0] + 0.5 * (p_grid[0] - p_grid[1]);
+      const Numeric p_min = p_grid[n_p_grid - 1] -
+                            0.5 * (p_grid[n_p_grid - 2] - p_grid[n_p_grid - 1]);
+      if ((p > p_max) || (p < p_min)) {
+        ostringstream os;
+        os << "Problem with gas absorption lookup table.\n"
+           << "Pressure p is outside the range covered by the lookup table.\n"
+           << "Your p value is " << p << " Pa.\n"
+           << "The allowed range is " << p_min << " to " << p_max << ".\n"
+           << "The pressure grid range in the table is " << p_grid[n_p_grid - 1]
+           << " to " << p_grid[0] << ".\n"
+           << "We allow a bit of extrapolation, but NOT SO MUCH!";
+        throw runtime_error(os.str());
+      }
     }
 
-    // Determine the H2O VMR grid position. We need to do this only
-    // once, since the only species who's VMR is interpolated is
-    // H2O. We do this only if there are nonlinear species, but the
-    // variable has to be visible later.
-    if (n_nls > 0) {
-      // Similar to the T case, we first interpolate the reference
-      // VMR to the pressure of extraction, then compare with
-      // the extraction VMR to determine the offset/fractional
-      // difference for the VMR interpolation.
-      //
-      // No! The above approach leads to problems when combined with
-      // higher order pressure interpolation. The problem is that
-      // the reference T and VMR profiles may be very
-      // irregular. (For example the H2O profile often has a big
-      // jump near the bottom.) That sometimes leads to negative
-      // effective reference values when the reference profile is
-      // interpolated. I therefore reverted back to the original
-      // version of using the real temperature and humidity, not
-      // the interpolated one.
-
-      //           const Numeric effective_vmr_ref = interp(pitw,
-      //                                                    vmrs_ref(h2o_index, Range(joker)),
-      //                                                    pgp);
-      const Numeric effective_vmr_ref = vmrs_ref(h2o_index, this_p_grid_index);
-
-      // Fractional VMR:
-      const Numeric VMR_frac = abs_vmrs[h2o_index] / effective_vmr_ref;
-
-      // Check that VMR_frac is inside the allowed range.
-      {
-        // FIXME: This check depends on how I interpolate VMR.
-        const Numeric x_min =
-            nls_pert[0] - extpolfac * (nls_pert[1] - nls_pert[0]);
-        const Numeric x_max =
-            nls_pert[n_nls_pert - 1] +
-            extpolfac * (nls_pert[n_nls_pert - 1] - nls_pert[n_nls_pert - 2]);
-
-        if ((VMR_frac > x_max) || (VMR_frac < x_min)) {
-          ostringstream os;
-          os << "Problem with gas absorption lookup table.\n"
-             << "VMR for H2O (species " << h2o_index
-             << ") is outside the range covered by the lookup table.\n"
-             << "Your VMR was " << abs_vmrs[h2o_index] << " at a pressure of "
-             << p << " Pa.\n"
-             << "The reference VMR value there is " << effective_vmr_ref << "\n"
-             << "The fractional VMR relative to the reference value is "
-             << VMR_frac << ".\n"
-             << "The allowed range is " << x_min << " to " << x_max << ".\n"
-             << "The fractional VMR perturbation grid range in the table is "
-             << nls_pert[0] << " to " << nls_pert[n_nls_pert - 1] << ".\n"
-             << "We allow a bit of extrapolation, but NOT SO MUCH!";
-          throw runtime_error(os.str());
+    // For sure, we need to store the pressure grid position.
+    // We do the interpolation in log(p). Test have shown that this
+    // gives slightly better accuracy than interpolating in p directly.
+    const auto plag = Interpolation::LagrangeVector(log(p), log_p_grid, p_interp_order);
+
+    // Pressure interpolation weights:
+    const auto pitw = interpweights(plag[0]);
+
+    // 6. We do the T and VMR interpolation for the pressure levels
+    // that are used in the pressure interpolation. (How many depends on
+    // p_interp_order.)
+
+    for (Index pi = 0; pi < p_interp_order + 1; ++pi) {
+      // Throw a runtime error if one of the reference VMR profiles is zero, but
+      // abs_vmrs is not. (This means that the lookup table was calculated with a
+      // reference profile of zero for that gas.)
+      //      for (Index si=0; si<n_species; ++si)
+      //        if ( (vmrs_ref(si,pi) == 0) &&
+      //            (abs_vmrs[si]    != 0) )
+      //        {
+      //          ostringstream os;
+      //          os << "Reference VMR profile is zero, you cannot extract\n"
+      //          << "Absorption for this species.\n"
+      //          << "Species: " << si
+      //          << " (" << get_species_name(species[si]) << ")\n"
+      //          << "Lookup table pressure level: " << pi
+      //          << " (" <<  p_grid[pi] << " Pa).";
+      //          throw runtime_error( os.str() );
+      //        }
+
+      // Index into p_grid:
+      const Index this_p_grid_index = plag[0].pos + pi;
+
+      // The cross sections of this level, dimension [T, H2O, frequency]:
+      const ConstTensor3View level_xsec =
+          XsecLevel(level_buffer, this_p_grid_index, f_first, f_last);
+
+      // Determine temperature grid position. This is only done if we
+      // want temperature interpolation, but the variable tgp has to
+      // be visible also outside for later use:
+      if (do_T) {
+        // Temperature in the atmosphere is altitude
+        // dependent. When we do the interpolation for the pressure level
+        // below and above our point, we should correct the target value of
+        // the interpolation to the altitude (pressure) difference. This
+        // ensures that there is for example no T interpolation if the
+        // desired T is right on the reference profile curve.
+        //
+        // I explicitly compared this with the old option to calculate
+        // the temperature offset relative to the temperature at
+        // this level. The performance in both cases is very
+        // similar. The reason, why I decided to keep this new
+        // version, is that it avoids the problem of needing
+        // oversized temperature perturbations if the pressure
+        // grid is coarse.
+        //
+        // No! The above approach leads to problems when combined with
+        // higher order pressure interpolation. The problem is that
+        // the reference T and VMR profiles may be very
+        // irregular. (For example the H2O profile often has a big
+        // jump near the bottom.) That sometimes leads to negative
+        // effective reference values when the reference profile is
+        // interpolated. I therefore reverted back to the original
+        // version of using the real temperature and humidity, not
+        // the interpolated one.
+
+        //          const Numeric effective_T_ref = interp(pitw,t_ref,pgp);
+        const Numeric effective_T_ref = t_ref[this_p_grid_index];
+
+        // Convert temperature to offset from t_ref:
+        const Numeric T_offset = T - effective_T_ref;
+
+        //          cout << "T_offset = " << T_offset << endl;
+
+        // Check that temperature offset is inside the allowed range.
+        {
+          const Numeric t_min = t_pert[0] - extpolfac * (t_pert[1] - t_pert[0]);
+          const Numeric t_max =
+              t_pert[n_t_pert - 1] +
+              extpolfac * (t_pert[n_t_pert - 1] - t_pert[n_t_pert - 2]);
+          if ((T_offset > t_max) || (T_offset < t_min)) {
+            ostringstream os;
+            os << "Problem with gas absorption lookup table.\n"
+               << "Temperature T is outside the range covered by the lookup table.\n"
+               << "Your temperature was " << T << " K at a pressure of " << p
+               << " Pa.\n"
+               << "The temperature offset value is " << T_offset << ".\n"
+               << "The allowed range is " << t_min << " to " << t_max << ".\n"
+               << "The temperature perturbation grid range in the table is "
+               << t_pert[0] << " to " << t_pert[n_t_pert - 1] << ".\n"
+               << "We allow a bit of extrapolation, but NOT SO MUCH!";
+            throw runtime_error(os.str());
+          }
+        }
+
+        tlag_withT[0] = LagrangeInterpolation(0, T_offset, t_pert, t_interp_order);
+      }
+
+      // Determine the H2O VMR grid position. We need to do this only
+      // once, since the only species who's VMR is interpolated is
+      // H2O. We do this only if there are nonlinear species, but the
+      // variable has to be visible later.
+      if (n_nls > 0) {
+        // Similar to the T case, we first interpolate the reference
+        // VMR to the pressure of extraction, then compare with
+        // the extraction VMR to determine the offset/fractional
+        // difference for the VMR interpolation.
+        //
+        // No! The above approach leads to problems when combined with
+        // higher order pressure interpolation. The problem is that
+        // the reference T and VMR profiles may be very
+        // irregular. (For example the H2O profile often has a big
+        // jump near the bottom.) That sometimes leads to negative
+        // effective reference values when the reference profile is
+        // interpolated. I therefore reverted back to the original
+        // version of using the real temperature and humidity, not
+        // the interpolated one.
+
+        //           const Numeric effective_vmr_ref = interp(pitw,
+        //                                                    vmrs_ref(h2o_index, Range(joker)),
+        //                                                    pgp);
+        const Numeric effective_vmr_ref = vmrs_ref(h2o_index, this_p_grid_index);
+
+        // Fractional VMR:
+        const Numeric VMR_frac = abs_vmrs[h2o_index] / effective_vmr_ref;
+
+        // Check that VMR_frac is inside the allowed range.
+        {
+          // FIXME: This check depends on how I interpolate VMR.
+          const Numeric x_min =
+              nls_pert[0] - extpolfac * (nls_pert[1] - nls_pert[0]);
+          const Numeric x_max =
+              nls_pert[n_nls_pert - 1] +
+              extpolfac * (nls_pert[n_nls_pert - 1] - nls_pert[n_nls_pert - 2]);
+
+          if ((VMR_frac > x_max) || (VMR_frac < x_min)) {
+            ostringstream os;
+            os << "Problem with gas absorption lookup table.\n"
+               << "VMR for H2O (species " << h2o_index
+               << ") is outside the range covered by the lookup table.\n"
+               << "Your VMR was " << abs_vmrs[h2o_index] << " at a pressure of "
+               << p << " Pa.\n"
+               << "The reference VMR value there is " << effective_vmr_ref << "\n"
+               << "The fractional VMR relative to the reference value is "
+               << VMR_frac << ".\n"
+               << "The allowed range is " << x_min << " to " << x_max << ".\n"
+               << "The fractional VMR perturbation grid range in the table is "
+               << nls_pert[0] << " to " << nls_pert[n_nls_pert - 1] << ".\n"
+               << "We allow a bit of extrapolation, but NOT SO MUCH!";
+            throw runtime_error(os.str());
+          }
         }
+
+        // For now, do linear interpolation in the fractional VMR.
+        vlag_h2o[0] = LagrangeInterpolation(0, VMR_frac, nls_pert, h2o_interp_order);
       }
 
-      // For now, do linear interpolation in the fractional VMR.
-      vlag_h2o[0] = LagrangeInterpolation(0, VMR_frac, nls_pert, h2o_interp_order);
-    }
+      // Precalculate interpolation weights.
+      if (do_T && n_nls < n_species) {
+        // Precalculate weights without H2O interpolation if there are less
+        // nonlinear species than total species. (So at least one species
+        // without H2O interpolation.)
+        itw_noH2O = interpweights(*tlag, lag_trivial, *flag);
+      }
+      if (n_nls > 0) {
+        // Precalculate weights with H2O interpolation if there is at least
+        // one nonlinear species.
+        itw_withH2O = interpweights(*tlag, vlag_h2o, *flag);
+      }
 
-    // Precalculate interpolation weights.
-    if (n_nls < n_species) {
-      // Precalculate weights without H2O interpolation if there are less
-      // nonlinear species than total species. (So at least one species
-      // without H2O interpolation.)
-      itw_noH2O = interpweights(*tlag, lag_trivial, *flag);
-    }
-    if (n_nls > 0) {
-      // Precalculate weights with H2O interpolation if there is at least
-      // one nonlinear species.
-      itw_withH2O = interpweights(*tlag, vlag_h2o, *flag);
-    }
+      // 7. Loop species:
+      Index fpi = 0;
+      for (Index si = 0; si < n_species; ++si) {
+        // Flag for VMR interpolation, if this is not 0 we want to
+        // do VMR interpolation:
+        const Index do_VMR = non_linear[si];
+
+        // For interpolation result.
+        // Fixed pressure level and species.
+        // Free dimension is T, H2O, and frequency.
+        Tensor3View res(xsec_pre_interpolated(
+            pi, si, Range(joker), Range(joker), Range(joker)));
+
+        // Ignore species such as Zeeman and free_electrons which are not
+        // stored in the lookup table. For those the result is set to 0.
+        if (is_zeeman(species[si]) ||
+            species[si][0].Type() == SpeciesTag::TYPE_FREE_ELECTRONS ||
+            species[si][0].Type() == SpeciesTag::TYPE_PARTICLES) {
+          if (do_VMR) {
+            ostringstream os;
+            os << "Problem with gas absorption lookup table.\n"
+               << "VMR interpolation is not allowed for species \""
+               << species[si][0].Name() << "\"";
+            throw runtime_error(os.str());
+          }
+          res = 0.;
+          fpi++;
+          continue;
+        }
 
-    // 7. Loop species:
-    Index fpi = 0;
-    for (Index si = 0; si < n_species; ++si) {
-      // Flag for VMR interpolation, if this is not 0 we want to
-      // do VMR interpolation:
-      const Index do_VMR = non_linear[si];
-
-      // For interpolation result.
-      // Fixed pressure level and species.
-      // Free dimension is T, H2O, and frequency.
-      Tensor3View res(xsec_pre_interpolated(
-          pi, si, Range(joker), Range(joker), Range(joker)));
-
-      // Ignore species such as Zeeman and free_electrons which are not
-      // stored in the lookup table. For those the result is set to 0.
-      if (is_zeeman(species[si]) ||
-          species[si][0].Type() == SpeciesTag::TYPE_FREE_ELECTRONS ||
-          species[si][0].Type() == SpeciesTag::TYPE_PARTICLES) {
+        // Set h2o related interpolation parameters:
+        Index this_h2o_extent;  // Range of H2O interpolation
         if (do_VMR) {
-          ostringstream os;
-          os << "Problem with gas absorption lookup table.\n"
-             << "VMR interpolation is not allowed for species \""
-             << species[si][0].Name() << "\"";
-          throw runtime_error(os.str());
+          vlag = &vlag_h2o;
+          this_h2o_extent = n_nls_pert;
+          itw = &itw_withH2O;
+        } else {
+          vlag = &lag_trivial;
+          this_h2o_extent = 1;
+          itw = &itw_noH2O;
         }
-        res = 0.;
-        fpi++;
-        continue;
-      }
 
-      // Set h2o related interpolation parameters:
-      Index this_h2o_extent;  // Range of H2O interpolation
-      if (do_VMR) {
-        vlag = &vlag_h2o;
-        this_h2o_extent = n_nls_pert;
-        itw = &itw_withH2O;
-      } else {
-        vlag = &lag_trivial;
-        this_h2o_extent = 1;
-        itw = &itw_noH2O;
+        // Get the right view on xsec.
+        ConstTensor3View this_xsec =
+            level_xsec(Range(joker),                 // Temperature range
+                       Range(fpi, this_h2o_extent),  // VMR profile range
+                       Range(joker));                // Frequency range
+
+        // Do interpolation.
+        reinterp(res,        // result
+                 this_xsec,  // input
+                 *itw,       // weights
+                 *tlag,
+                 *vlag,
+                 *flag);  // grid positions
+
+        // Increase fpi. fpi marks the position of the first profile
+        // of the current species in xsec. This is needed to find
+        // the right subsection of xsec in the presence of nonlinear species.
+        if (do_VMR)
+          fpi += n_nls_pert;
+        else
+          fpi++;
+
+      }  // End of species loop
+
+      // fpi should have reached the end of that dimension of xsec. Check
+      // this with an assertion:
+      ARTS_ASSERT(fpi == level_xsec.npages());
+
+    }  // End of pressure index loop (below and above gp)
+
+    // Now we have to interpolate between the p_interp_order+1 pressure levels
+
+    // It is a "red" 1D interpolation case we are talking about here.
+    // (But for a matrix in frequency and species.) Doing a loop over
+    // frequency and species with an interp call inside would be
+    // unefficient, so we do this by hand here.
+    sga = 0;
+    for (Index pi = 0; pi < p_interp_order + 1; ++pi) {
+      // Multiply pre interpolated quantities with pressure interpolation weights.
+      // Dimensions of pre_interpolated are:
+      //   Pressure    (interpolation points)
+      //   Species
+      //   Temperature (always 1)
+      //   H2O         (always 1)
+      //   Frequency
+      xsec_pre_interpolated(
+          pi, Range(joker), Range(joker), Range(joker), Range(joker)) *= pitw[pi];
+
+      // Add up in sga.
+      // Dimensions of sga are (species, frequency)
+      sga += xsec_pre_interpolated(pi, Range(joker), 0, 0, Range(joker));
+    }
+
+    // Watch out, this is not yet the final result, we
+    // need to multiply with the number density of the species, i.e.,
+    // with the total number density n, times the VMR of the
+    // species:
+    for (Index si = 0; si < n_species; ++si)
+      sga(si, Range(joker)) *= (n * abs_vmrs[si]);
+  }  // End of loop over atmospheric points
+
+  // That's it, we're done!
+}
+
+//=== Memory-mapped lookup tables ===========================================
+
+namespace {
+static_assert(std::is_same_v<Numeric, double>,
+              "Memory-mapped lookup tables assume that Numeric is double");
+
+//! First bytes of a memory-mapped lookup table file.
+constexpr char mapped_magic[8] = {'A', 'R', 'T', 'S', 'G', 'A', 'L', '\0'};
+
+//! Written as is, to detect files from machines with other byte order.
+constexpr std::uint64_t mapped_byte_order = 0x0102030405060708;
+
+//! Version of the file layout.
+constexpr std::uint64_t mapped_version = 1;
+
+//! Alignment of the cross sections in the file.
+constexpr std::uint64_t mapped_alignment = 4096;
+
+//! ScaledInt16 value of NaN cross sections.
+constexpr std::int16_t mapped_int16_nan = INT16_MIN;
+
+//! Header of a memory-mapped lookup table file.
+/*! The header is followed by the table without cross sections as XML, the
+  exact values of the numeric grids of the table in the order they appear
+  in the XML, and the cross sections themselves, stored pressure level by
+  pressure level with dimension [T, H2O, frequency] per level. For
+  ScaledInt16 storage the cross sections are followed by one scale factor
+  per frequency row, dimension [pressure, T, H2O]. Offsets and sizes are in
+  bytes. */
+struct MappedHeader {
+  char magic[8];
+  std::uint64_t byte_order;
+  std::uint64_t version;
+  std::uint64_t storage;
+  std::uint64_t nbooks, npages, nrows, ncols;  // Dimension of xsec
+  std::uint64_t meta_offset, meta_size;
+  std::uint64_t grid_offset, grid_size;
+  std::uint64_t data_offset, data_size;
+  std::uint64_t scale_offset, scale_size;
+};
+
+std::uint64_t mapped_element_size(const LookupStorage storage) {
+  switch (storage) {
+    case LookupStorage::Float64:
+      return sizeof(double);
+    case LookupStorage::Float32:
+      return sizeof(float);
+    case LookupStorage::ScaledInt16:
+      return sizeof(std::int16_t);
+    case LookupStorage::FINAL:
+      break;
+  }
+  ARTS_ASSERT(false, "Bad storage type");
+  return 0;
+}
+
+std::uint64_t mapped_align(const std::uint64_t offset,
+                           const std::uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+//! A ConstTensor3View of memory that is not owned by a Tensor3.
+class MappedTensor3View : public ConstTensor3View {
+ public:
+  MappedTensor3View(const Numeric* data, Index np, Index nr, Index nc)
+      : ConstTensor3View(const_cast<Numeric*>(data),
+                         Range(0, np, nr * nc),
+                         Range(0, nr, nc),
+                         Range(0, nc)) {}
+};
+}  // namespace
+
+//! Read-only memory mapping of a lookup table file.
+/*! The file is mapped shared, so that all processes reading the same table
+  share one copy of it in the page cache. Pages are only read from disk
+  when a pressure level is first accessed. */
+class GasAbsLookupMapping {
+ public:
+  explicit GasAbsLookupMapping(const String& filename) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    ARTS_USER_ERROR_IF(fd < 0, "Cannot open input file: ", filename);
+
+    struct stat st;
+    size = fstat(fd, &st) == 0 ? st.st_size : 0;
+    addr = size >= sizeof(MappedHeader)
+               ? mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)
+               : MAP_FAILED;
+    close(fd);  // The mapping stays valid without the descriptor
+    ARTS_USER_ERROR_IF(addr == MAP_FAILED,
+                       "Cannot map lookup table file to memory: ",
+                       filename);
+
+    const String error = check();
+    if (error.size()) {
+      munmap(addr, size);
+      ARTS_USER_ERROR(
+          "Not a valid memory-mapped lookup table: ", filename, '\n', error);
+    }
+  }
+
+  GasAbsLookupMapping(const GasAbsLookupMapping&) = delete;
+  GasAbsLookupMapping& operator=(const GasAbsLookupMapping&) = delete;
+
+  ~GasAbsLookupMapping() { munmap(addr, size); }
+
+  const MappedHeader& Header() const {
+    return *static_cast<const MappedHeader*>(addr);
+  }
+
+  LookupStorage Storage() const { return LookupStorage(Header().storage); }
+
+  //! The table without cross sections as XML
+  String Meta() const {
+    const MappedHeader& h = Header();
+    return String(std::string_view(bytes(h.meta_offset), h.meta_size));
+  }
+
+  //! The exact values of the grids in the XML
+  const double* Grids(Index& n) const {
+    const MappedHeader& h = Header();
+    n = h.grid_size / sizeof(double);
+    return reinterpret_cast<const double*>(bytes(h.grid_offset));
+  }
+
+  //! Cross sections of pressure level ip, decoded to buffer if needed.
+  /*!
+    Only the frequencies f_first to f_last (inclusive) are returned, so
+    buffer only holds these frequencies.
+  */
+  ConstTensor3View Level(Tensor3& buffer,
+                         const Index ip,
+                         const Index f_first,
+                         const Index f_last) const {
+    const MappedHeader& h = Header();
+    const Index nt = h.nbooks, ns = h.npages, nf = h.nrows;
+    const Index nrow = nt * ns;
+    const Index n = nrow * nf;
+    const Index nsel = f_last - f_first + 1;
+    ARTS_ASSERT(ip >= 0 and ip < Index(h.ncols));
+    ARTS_ASSERT(f_first >= 0 and f_first <= f_last and f_last < nf);
+
+    switch (Storage()) {
+      case LookupStorage::Float64:
+        return MappedTensor3View(
+            reinterpret_cast<const double*>(bytes(h.data_offset)) + ip * n,
+            nt,
+            ns,
+            nf)(joker, joker, Range(f_first, nsel));
+      case LookupStorage::Float32: {
+        buffer.resize(nt, ns, nsel);
+        const float* src =
+            reinterpret_cast<const float*>(bytes(h.data_offset)) + ip * n;
+        Numeric* dst = buffer.get_c_array();
+        for (Index r = 0; r < nrow; r++)
+          std::copy(src + r * nf + f_first,
+                    src + r * nf + f_last + 1,
+                    dst + r * nsel);
+        return buffer;
+      }
+      case LookupStorage::ScaledInt16: {
+        buffer.resize(nt, ns, nsel);
+        const std::int16_t* src =
+            reinterpret_cast<const std::int16_t*>(bytes(h.data_offset)) +
+            ip * n;
+        const double* scale =
+            reinterpret_cast<const double*>(bytes(h.scale_offset)) +
+            ip * nrow;
+        Numeric* dst = buffer.get_c_array();
+        for (Index r = 0; r < nrow; r++)
+          for (Index i = 0; i < nsel; i++) {
+            const std::int16_t v = src[r * nf + f_first + i];
+            dst[r * nsel + i] = v == mapped_int16_nan ? NAN : scale[r] * v;
+          }
+        return buffer;
       }
+      case LookupStorage::FINAL:
+        break;
+    }
+    ARTS_ASSERT(false, "Bad storage type");
+    return buffer;
+  }
 
-      // Get the right view on xsec.
-      ConstTensor3View this_xsec =
-          xsec(Range(joker),                 // Temperature range
-               Range(fpi, this_h2o_extent),  // VMR profile range
-               Range(joker),                 // Frequency range
-               this_p_grid_index);           // Pressure index
-
-      // Do interpolation.
-      reinterp(res,        // result
-               this_xsec,  // input
-               *itw,       // weights
-               *tlag,
-               *vlag,
-               *flag);  // grid positions
-
-      // Increase fpi. fpi marks the position of the first profile
-      // of the current species in xsec. This is needed to find
-      // the right subsection of xsec in the presence of nonlinear species.
-      if (do_VMR)
-        fpi += n_nls_pert;
-      else
-        fpi++;
-
-    }  // End of species loop
-
-    // fpi should have reached the end of that dimension of xsec. Check
-    // this with an assertion:
-    ARTS_ASSERT(fpi == xsec.npages());
-
-  }  // End of pressure index loop (below and above gp)
-
-  // Now we have to interpolate between the p_interp_order+1 pressure levels
-
-  // It is a "red" 1D interpolation case we are talking about here.
-  // (But for a matrix in frequency and species.) Doing a loop over
-  // frequency and species with an interp call inside would be
-  // unefficient, so we do this by hand here.
-  sga.resize(n_species, n_new_f_grid);
-  sga = 0;
-  for (Index pi = 0; pi < p_interp_order + 1; ++pi) {
-    // Multiply pre interpolated quantities with pressure interpolation weights.
-    // Dimensions of pre_interpolated are:
-    //   Pressure    (interpolation points)
-    //   Species
-    //   Temperature (always 1)
-    //   H2O         (always 1)
-    //   Frequency
-    xsec_pre_interpolated(
-        pi, Range(joker), Range(joker), Range(joker), Range(joker)) *= pitw[pi];
-
-    // Add up in sga.
-    // Dimensions of sga are (species, frequency)
-    sga += xsec_pre_interpolated(pi, Range(joker), 0, 0, Range(joker));
+ private:
+  const char* bytes(const std::uint64_t offset) const {
+    return static_cast<const char*>(addr) + offset;
   }
 
-  // Watch out, this is not yet the final result, we
-  // need to multiply with the number density of the species, i.e.,
-  // with the total number density n, times the VMR of the
-  // species:
-  for (Index si = 0; si < n_species; ++si)
-    sga(si, Range(joker)) *= (n * abs_vmrs[si]);
+  //! Returns an error message if the header does not match the file
+  String check() const {
+    const MappedHeader& h = Header();
+    if (not std::equal(h.magic, h.magic + 8, mapped_magic))
+      return "The file does not start with the right identifier.";
+    if (h.byte_order != mapped_byte_order)
+      return "The file was written on a machine with different byte order.";
+    if (h.version != mapped_version)
+      return var_string("Unsupported file version ", h.version, '.');
+    if (h.storage >= std::uint64_t(LookupStorage::FINAL))
+      return var_string("Unknown storage type ", h.storage, '.');
+
+    const std::uint64_t nrow = h.nbooks * h.npages * h.ncols;
+    if (h.data_size != nrow * h.nrows * mapped_element_size(Storage()))
+      return "The size of the cross sections does not match their dimension.";
+    if (h.scale_size !=
+        (Storage() == LookupStorage::ScaledInt16 ? nrow * sizeof(double) : 0))
+      return "The size of the scale factors does not match the dimension.";
+    if (h.grid_offset % sizeof(double) or h.data_offset % sizeof(double) or
+        h.scale_offset % sizeof(double))
+      return "The grids or cross sections are not aligned.";
+    if (h.meta_offset + h.meta_size > size or
+        h.grid_offset + h.grid_size > size or
+        h.data_offset + h.data_size > size or
+        h.scale_offset + h.scale_size > size)
+      return "The file is truncated.";
+    return "";
+  }
 
-  // That's it, we're done!
+  void* addr;
+  std::size_t size;
+};
+
+//! Cross sections of one pressure level.
+/*!
+  \param[in,out] buffer Used to decode the level if the table is mapped
+                        with reduced precision.
+  \param[in] ip         Index in p_grid.
+  \param[in] f_first    First frequency index that is needed.
+  \param[in] f_last     Last frequency index that is needed, -1 for the
+                        last frequency of the table.
+
+  \return The cross sections, dimension [T, H2O, frequency] as for xsec,
+          but only for the frequencies f_first to f_last. Frequency index
+          0 of the result is f_first.
+*/
+ConstTensor3View GasAbsLookup::XsecLevel(Tensor3& buffer,
+                                         const Index ip,
+                                         const Index f_first,
+                                         const Index f_last) const {
+  const Index last = f_last < 0 ? f_grid.nelem() - 1 : f_last;
+  if (mapped_xsec) return mapped_xsec->Level(buffer, ip, f_first, last);
+  return xsec(joker, joker, Range(f_first, last - f_first + 1), ip);
+}
+
+//! Write the lookup table in a format that can be memory-mapped.
+/*!
+  See ReadMapped. The file is written in the byte order of this machine.
+
+  \param[in] filename  Name of the file.
+  \param[in] storage   How to store the cross sections.
+  \param[in] verbosity Verbosity settings.
+*/
+void GasAbsLookup::WriteMapped(const String& filename,
+                               const LookupStorage storage,
+                               const Verbosity& verbosity) const {
+  CREATE_OUT2;
+
+  const Index n_p_grid = p_grid.nelem();
+  ARTS_USER_ERROR_IF(not n_p_grid, "The lookup table is empty.")
+
+  // Everything but the cross sections is stored as XML:
+  GasAbsLookup meta;
+  meta.species = species;
+  meta.nonlinear_species = nonlinear_species;
+  meta.f_grid = f_grid;
+  meta.p_grid = p_grid;
+  meta.vmrs_ref = vmrs_ref;
+  meta.t_ref = t_ref;
+  meta.t_pert = t_pert;
+  meta.nls_pert = nls_pert;
+  ostringstream meta_xml;
+  xml_write_to_stream(meta_xml, meta, nullptr, "", verbosity);
+
+  // ASCII XML is not exact, so the grids are also stored in binary:
+  std::vector<double> grids;
+  const auto add_grid = [&grids](ConstVectorView g) {
+    for (Index i = 0; i < g.nelem(); i++) grids.push_back(g[i]);
+  };
+  add_grid(f_grid);
+  add_grid(p_grid);
+  for (Index i = 0; i < vmrs_ref.nrows(); i++) add_grid(vmrs_ref(i, joker));
+  add_grid(t_ref);
+  add_grid(t_pert);
+  add_grid(nls_pert);
+
+  Tensor3 level_buffer;
+  const ConstTensor3View level0 = XsecLevel(level_buffer, 0);
+  const Index nrow = level0.npages() * level0.nrows();
+  const Index n = nrow * level0.ncols();
+
+  MappedHeader h;
+  std::copy(mapped_magic, mapped_magic + 8, h.magic);
+  h.byte_order = mapped_byte_order;
+  h.version = mapped_version;
+  h.storage = std::uint64_t(storage);
+  h.nbooks = level0.npages();
+  h.npages = level0.nrows();
+  h.nrows = level0.ncols();
+  h.ncols = n_p_grid;
+  h.meta_offset = sizeof(MappedHeader);
+  h.meta_size = meta_xml.str().size();
+  h.grid_offset = mapped_align(h.meta_offset + h.meta_size, sizeof(double));
+  h.grid_size = grids.size() * sizeof(double);
+  h.data_offset =
+      mapped_align(h.grid_offset + h.grid_size, mapped_alignment);
+  h.data_size = n * n_p_grid * mapped_element_size(storage);
+  h.scale_offset = mapped_align(h.data_offset + h.data_size, sizeof(double));
+  h.scale_size = storage == LookupStorage::ScaledInt16
+                     ? nrow * n_p_grid * sizeof(double)
+                     : 0;
+
+  ofstream file;
+  open_output_file(file, filename);
+  const auto pad_to = [&file](const std::uint64_t offset) {
+    while (std::uint64_t(file.tellp()) < offset) file.put('\0');
+  };
+
+  file.write(reinterpret_cast<const char*>(&h), sizeof(MappedHeader));
+  file << meta_xml.str();
+  pad_to(h.grid_offset);
+  file.write(reinterpret_cast<const char*>(grids.data()), h.grid_size);
+  pad_to(h.data_offset);
+
+  std::vector<float> f32(storage == LookupStorage::Float32 ? n : 0);
+  std::vector<std::int16_t> i16(storage == LookupStorage::ScaledInt16 ? n : 0);
+  std::vector<double> scales(h.scale_size / sizeof(double));
+  for (Index ip = 0; ip < n_p_grid; ip++) {
+    // Copy the level to make it contiguous
+    const Tensor3 level = XsecLevel(level_buffer, ip);
+    const Numeric* src = level.get_c_array();
+
+    switch (storage) {
+      case LookupStorage::Float64:
+        file.write(reinterpret_cast<const char*>(src), n * sizeof(double));
+        break;
+      case LookupStorage::Float32:
+        std::copy(src, src + n, f32.begin());
+        file.write(reinterpret_cast<const char*>(f32.data()),
+                   n * sizeof(float));
+        break;
+      case LookupStorage::ScaledInt16:
+        for (Index r = 0; r < nrow; r++) {
+          const Index nf = h.nrows;
+          Numeric max_abs = 0;
+          for (Index i = r * nf; i < (r + 1) * nf; i++)
+            if (not std::isnan(src[i])) max_abs = max(max_abs, abs(src[i]));
+
+          const Numeric scale = max_abs / INT16_MAX;
+          for (Index i = r * nf; i < (r + 1) * nf; i++)
+            if (std::isnan(src[i]))
+              i16[i] = mapped_int16_nan;
+            else
+              i16[i] = scale > 0 ? std::int16_t(std::lround(src[i] / scale)) : 0;
+          scales[ip * nrow + r] = scale;
+        }
+        file.write(reinterpret_cast<const char*>(i16.data()),
+                   n * sizeof(std::int16_t));
+        break;
+      case LookupStorage::FINAL:
+        break;
+    }
+  }
+
+  pad_to(h.scale_offset);
+  file.write(reinterpret_cast<const char*>(scales.data()), h.scale_size);
+
+  out2 << "  Wrote memory-mapped lookup table with "
+       << toString(storage) << " cross sections to " << filename << " ("
+       << (h.scale_offset + h.scale_size) / (1024 * 1024) << " MiB).\n";
+}
+
+//! Read a lookup table written by WriteMapped.
+/*!
+  The file is memory-mapped, so reading is almost instantaneous and the
+  cross sections are only read from disk when they are used by Extract.
+  Processes on one machine that map the same file share its memory.
+
+  The table stays mapped as long as any copy of it exists, also after
+  Adapt if the table already has the species and frequencies of the
+  calculation. Otherwise Adapt copies the selected part to memory.
+
+  \param[in] filename  Name of the file.
+  \param[in] verbosity Verbosity settings.
+*/
+void GasAbsLookup::ReadMapped(const String& filename,
+                              const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  String efilename = filename;
+  find_xml_file(efilename, verbosity);
+  const auto mapping = std::make_shared<const GasAbsLookupMapping>(efilename);
+
+  GasAbsLookup table;
+  istringstream meta_xml(mapping->Meta());
+  xml_read_from_stream(meta_xml, table, nullptr, verbosity);
+
+  const MappedHeader& h = mapping->Header();
+  const Index n_nls = table.nonlinear_species.nelem();
+  ARTS_USER_ERROR_IF(
+      Index(h.nbooks) != max(table.t_pert.nelem(), Index(1)) or
+          Index(h.npages) != table.species.nelem() +
+                                 n_nls * (table.nls_pert.nelem() - 1) or
+          Index(h.nrows) != table.f_grid.nelem() or
+          Index(h.ncols) != table.p_grid.nelem(),
+      "The dimension of the cross sections in ",
+      efilename,
+      "\ndoes not match the grids of the table.")
+
+  Index n_grids;
+  const double* grids = mapping->Grids(n_grids);
+  ARTS_USER_ERROR_IF(
+      n_grids != table.f_grid.nelem() + table.p_grid.nelem() +
+                     table.vmrs_ref.nrows() * table.vmrs_ref.ncols() +
+                     table.t_ref.nelem() + table.t_pert.nelem() +
+                     table.nls_pert.nelem(),
+                     "The size of the grids in ",
+                     efilename,
+                     "\ndoes not match the table.")
+  const auto get_grid = [&grids](VectorView g) {
+    for (Index i = 0; i < g.nelem(); i++) g[i] = *grids++;
+  };
+  get_grid(table.f_grid);
+  get_grid(table.p_grid);
+  for (Index i = 0; i < table.vmrs_ref.nrows(); i++)
+    get_grid(table.vmrs_ref(i, joker));
+  get_grid(table.t_ref);
+  get_grid(table.t_pert);
+  get_grid(table.nls_pert);
+
+  table.mapped_xsec = mapping;
+  *this = table;
+
+  out2 << "  Mapped lookup table with " << toString(mapping->Storage())
+       << " cross sections from " << efilename << ".\n";
+}
+
+//! Copy memory-mapped cross sections to xsec.
+/*!
+  Does nothing if the table is not mapped. Afterwards the table no longer
+  depends on the file.
+*/
+void GasAbsLookup::Unmap() {
+  if (not mapped_xsec) return;
+
+  const MappedHeader& h = mapped_xsec->Header();
+  xsec.resize(h.nbooks, h.npages, h.nrows, h.ncols);
+
+  Tensor3 level_buffer;
+  for (Index ip = 0; ip < xsec.ncols(); ip++)
+    xsec(joker, joker, joker, ip) = XsecLevel(level_buffer, ip);
+
+  mapped_xsec.reset();
 }
 
 const Vector& GasAbsLookup::GetFgrid() const { return f_grid; }
@@ -26,8 +26,10 @@
 #ifndef gas_abs_lookup_h
 #define gas_abs_lookup_h
 
+#include <memory>
 #include "abs_species_tags.h"
 #include "absorption.h"
+#include "enums.h"
 #include "interpolation_lagrange.h"
 #include "matpackIV.h"
 #include "messages.h"
@@ -37,6 +39,13 @@ class bifstream;
 class bofstream;
 class Agenda;
 class Workspace;
+class GasAbsLookupMapping;
+
+//! Storage type of the cross sections in a memory-mapped lookup table.
+/*! ScaledInt16 stores every frequency row of the table as 16 bit integers
+    times one scale factor per row. This is lossy for rows with a large
+    dynamic range, e.g., strong lines next to window regions. */
+ENUMCLASS(LookupStorage, char, Float64, Float32, ScaledInt16)
 
 //! An absorption lookup table.
 /*! This class holds an absorption lookup table, as well as all
@@ -53,7 +62,8 @@ class GasAbsLookup {
         t_ref(),
         t_pert(),
         nls_pert(),
-        xsec() { /* Nothing to do here */
+        xsec(),
+        mapped_xsec() { /* Nothing to do here */
   }
 
   // Documentation is with the implementation!
@@ -73,6 +83,32 @@ class GasAbsLookup {
                ConstVectorView new_f_grid,
                const Numeric& extpolfac) const;
 
+  // Documentation is with the implementation!
+  void Extract(Tensor3View sga_path,
+               const Index& p_interp_order,
+               const Index& t_interp_order,
+               const Index& h2o_interp_order,
+               const Index& f_interp_order,
+               ConstVectorView p_path,
+               ConstVectorView t_path,
+               ConstMatrixView abs_vmrs_path,
+               ConstVectorView new_f_grid,
+               const Numeric& extpolfac) const;
+
+  // Documentation is with the implementation!
+  void WriteMapped(const String& filename,
+                   const LookupStorage storage,
+                   const Verbosity& verbosity) const;
+
+  // Documentation is with the implementation!
+  void ReadMapped(const String& filename, const Verbosity& verbosity);
+
+  // Documentation is with the implementation!
+  void Unmap();
+
+  /** True if the cross sections are read from a memory-mapped file */
+  bool IsMapped() const { return bool(mapped_xsec); }
+
   const Vector& GetFgrid() const;
 
   const Vector& GetPgrid() const;
@@ -188,8 +224,8 @@ class GasAbsLookup {
   /** The vector of perturbations for the VMRs of the nonlinear species */
   Vector& NLSPert() {return nls_pert;}
   
-  /** Absorption cross sections */
-  Tensor4& Xsec() {return xsec;}
+  /** Absorption cross sections (copied to memory if the table is mapped) */
+  Tensor4& Xsec() {Unmap(); return xsec;}
   
  private:
   //! The species tags for which the table is valid.
@@ -307,6 +343,18 @@ class GasAbsLookup {
     dimensions of abs_per_tg in ARTS-1-0. This should simplify
     computation of the lookup table with the old ARTS version.  */
   Tensor4 xsec;
+
+  //! Memory-mapped absorption cross sections.
+  /*! If set, xsec is empty and the cross sections are read from a file
+    written by WriteMapped. The mapping is shared by all copies of the
+    table. */
+  std::shared_ptr<const GasAbsLookupMapping> mapped_xsec;
+
+  // Documentation is with the implementation!
+  ConstTensor3View XsecLevel(Tensor3& buffer,
+                             const Index ip,
+                             const Index f_first = 0,
+                             const Index f_last = -1) const;
 };
 
 ostream& operator<<(ostream& os, const GasAbsLookup& gal);
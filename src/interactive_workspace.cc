@@ -10,9 +10,10 @@
 #include "workspace_memory_handler.h"
 #include "agenda_class.h"
 #include "agenda_record.h"
+#include "parser.h"
 
 extern Verbosity verbosity_at_launch;
-extern std::string string_buffer;
+extern thread_local std::string string_buffer;
 
 namespace global_data {
 extern map<String, Index> AgendaMap;
@@ -365,6 +366,9 @@ void InteractiveWorkspace::erase_variable(Index i, Index group_id) {
   WsvMap.erase(wsv_data[i].Name());
   wsv_data.erase(wsv_data.begin() + i);
   --n_anonymous_variables_;
+
+  // Parsed controlfiles refer to variables by index
+  ArtsParser::clear_cache();
 }
 
 void InteractiveWorkspace::swap(Index i, Index j) {
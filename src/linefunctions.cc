@@ -34,6 +34,8 @@
 
 #include "linefunctions.h"
 #include <Eigen/Core>
+#include <algorithm>
+#include <numeric>
 #include <Faddeeva/Faddeeva.hh>
 #include "constants.h"
 #include "linescaling.h"
@@ -84,6 +86,155 @@ constexpr Complex pCqSDHC_to_arts_D2_deriv(Complex x) noexcept {
   pow4(c);
 }
 
+/** Coefficients of Weideman's N-term rational approximation of w(z)
+ *
+ * J.A.C. Weideman, SIAM J. Numer. Anal. 31, 1497-1518, 1994
+ *
+ * The coefficients are the cosine transform of the Weideman kernel and
+ * are computed once on first use
+ */
+template <Index N>
+struct WeidemanCoefficients {
+  std::array<Numeric, N> a;
+  Numeric L;
+
+  WeidemanCoefficients() noexcept : a(), L(std::sqrt(N / std::sqrt(2.0))) {
+    constexpr Index M = 2 * N;
+    std::array<Numeric, 2 * M - 1> f;
+    for (Index k = -M + 1; k < M; k++) {
+      const Numeric t = L * std::tan(0.5 * Constant::pi * Numeric(k) / M);
+      f[k + M - 1] = std::exp(-t * t) * (L * L + t * t);
+    }
+
+    for (Index n = 0; n < N; n++) {
+      Numeric s = 0;
+      for (Index k = -M + 1; k < M; k++)
+        s += f[k + M - 1] * std::cos(Constant::pi * Numeric(k * (n + 1)) / M);
+      a[n] = s / (2 * M);
+    }
+  }
+};
+
+/** Region-split Humlicek/Weideman approximation of the Faddeeva function
+ *
+ * Evaluates both the asymptotic Humlicek region I expression and the
+ * Weideman expression for every point and selects between them without
+ * branching, so the loop vectorizes.  Real and imaginary parts are kept
+ * apart to avoid the C99 complex multiplication/division rules
+ *
+ * @param[out] W Output, points with z.imag() < 0 must be fixed by caller
+ * @param[in]  z Input
+ * @param[in]  n Number of points
+ * @param[in]  s0 Border of region I in |x| + y
+ */
+template <Index N, bool two_term_asymptote>
+void humlicek_weideman(Complex* W, const Complex* z, const Index n, const Numeric s0) noexcept {
+  static const WeidemanCoefficients<N> c;
+  const Numeric L = c.L;
+
+  // Points are handled in blocks so that the polynomial loop runs over points
+  constexpr Index B = 64;
+  std::array<Numeric, B> x, y, rr, ri, Zr, Zi, pr, pi;
+
+  for (Index i0 = 0; i0 < n; i0 += B) {
+    const Index m = std::min(B, n - i0);
+
+    // r = 1 / (L - iz) and Z = (L + iz) / (L - iz)
+    for (Index j = 0; j < m; j++) {
+      x[j] = z[i0 + j].real();
+      y[j] = z[i0 + j].imag();
+      const Numeric dr = L + y[j];
+      const Numeric inv = 1.0 / (dr * dr + x[j] * x[j]);
+      rr[j] = dr * inv;
+      ri[j] = x[j] * inv;
+      Zr[j] = ((L - y[j]) * dr - x[j] * x[j]) * inv;
+      Zi[j] = (x[j] * dr + (L - y[j]) * x[j]) * inv;
+      pr[j] = c.a[N - 1];
+      pi[j] = 0;
+    }
+
+    // Polynomial in Z by Horner's scheme
+    for (Index k = N - 2; k >= 0; k--) {
+      for (Index j = 0; j < m; j++) {
+        const Numeric tr = pr[j] * Zr[j] - pi[j] * Zi[j] + c.a[k];
+        pi[j] = pr[j] * Zi[j] + pi[j] * Zr[j];
+        pr[j] = tr;
+      }
+    }
+
+    for (Index j = 0; j < m; j++) {
+      // w = 2 p r^2 + r / sqrt(pi)
+      const Numeric qr = rr[j] * rr[j] - ri[j] * ri[j];
+      const Numeric qi = 2 * rr[j] * ri[j];
+      const Numeric wr = 2 * (pr[j] * qr - pi[j] * qi) + Constant::inv_sqrt_pi * rr[j];
+      const Numeric wi = 2 * (pr[j] * qi + pi[j] * qr) + Constant::inv_sqrt_pi * ri[j];
+
+      // Region I: i z / sqrt(pi) / (z^2 - 1/2) or the next Laplace continued fraction term
+      const Numeric z2r = x[j] * x[j] - y[j] * y[j];
+      const Numeric z2i = 2 * x[j] * y[j];
+      Numeric nr = -y[j] * Constant::inv_sqrt_pi, ni = x[j] * Constant::inv_sqrt_pi;
+      Numeric hr = z2r - 0.5, hi = z2i;
+      if constexpr (two_term_asymptote) {
+        const Numeric tr = nr * (z2r - 2.5) - ni * z2i;
+        ni = nr * z2i + ni * (z2r - 2.5);
+        nr = tr;
+        hr = z2r * (z2r - 3) - z2i * z2i + 0.75;
+        hi = z2i * (z2r - 3) + z2r * z2i;
+      }
+      const Numeric invh = 1.0 / (hr * hr + hi * hi);
+      const Numeric ar = (nr * hr + ni * hi) * invh;
+      const Numeric ai = (ni * hr - nr * hi) * invh;
+
+      const bool region_one = std::abs(x[j]) + y[j] > s0;
+      W[i0 + j] = Complex(region_one ? ar : wr, region_one ? ai : wi);
+    }
+  }
+}
+
+/** Approximate half width at half maximum of the Voigt profile
+ *
+ * J.J. Olivero and R.L. Longbothum, JQSRT 17, 233-236, 1977
+ *
+ * @param[in] GL Lorentz half width at half maximum
+ * @param[in] GD Doppler half width at 1/e of maximum
+ * @return Voigt half width at half maximum
+ */
+inline Numeric voigt_halfwidth(Numeric GL, Numeric GD) noexcept {
+  using Constant::pow2;
+  const Numeric GG = Constant::sqrt_ln_2 * std::abs(GD);
+  return 0.5346 * GL + std::sqrt(0.2166 * pow2(GL) + pow2(GG));
+}
+
+void Linefunctions::set_faddeeva(Eigen::Ref<Eigen::VectorXcd> W,
+                                 const Eigen::Ref<const Eigen::VectorXcd> z,
+                                 const FaddeevaAlgorithm algorithm) {
+  const Index n = z.size();
+
+  switch (algorithm) {
+    case FaddeevaAlgorithm::Faddeeva:
+      for (Index i = 0; i < n; i++) W[i] = w(z[i]);
+      return;
+    case FaddeevaAlgorithm::HumlicekWeideman32:
+      humlicek_weideman<32, true>(W.data(), z.data(), n, 8.0);
+      break;
+    case FaddeevaAlgorithm::HumlicekWeideman24:
+      humlicek_weideman<24, false>(W.data(), z.data(), n, 15.0);
+      break;
+    case FaddeevaAlgorithm::FINAL:
+      ARTS_ASSERT(false, "Bad FaddeevaAlgorithm");
+  }
+
+  // The approximations are only valid in the upper half-plane
+  for (Index i = 0; i < n; i++)
+    if (z[i].imag() < 0) W[i] = w(z[i]);
+}
+
+void Linefunctions::set_dfaddeeva(Eigen::Ref<Eigen::VectorXcd> dW,
+                                  const Eigen::Ref<const Eigen::VectorXcd> z,
+                                  const Eigen::Ref<const Eigen::VectorXcd> W) {
+  dW.noalias() = 2 * (Complex(0, Constant::inv_sqrt_pi) - z.cwiseProduct(W).array()).matrix();
+}
+
 void Linefunctions::set_lineshape(
     Eigen::Ref<Eigen::VectorXcd> F,
     const Eigen::Ref<const Eigen::VectorXd> f_grid,
@@ -316,7 +467,8 @@ void Linefunctions::set_voigt(
     const ArrayOfRetrievalQuantity& derivatives_data,
     const Numeric& dGD_div_F0_dT,
     const LineShape::Output& dT,
-    const LineShape::Output& dVMR) {
+    const LineShape::Output& dVMR,
+    const FaddeevaAlgorithm faddeeva_algorithm) {
   constexpr Complex iz(0.0, 1.0);
 
   // Size of problem
@@ -339,12 +491,15 @@ void Linefunctions::set_voigt(
   z.noalias() = invGD * (Complex(-F0, lso.G0) + f_grid.array()).matrix();
 
   // Line shape
-  F.noalias() = fac * z.unaryExpr(&w);
+  set_faddeeva(F, z, faddeeva_algorithm);
+
+  if (nppd) {
+    set_dfaddeeva(dw, z, F);
+    dw *= fac;
+  }
+  F *= fac;
 
   if (nppd) {
-    dw.noalias() = 2 * (Complex(0, fac * Constant::inv_sqrt_pi) -
-                        z.cwiseProduct(F).array())
-                           .matrix();
 
     for (auto iq = 0; iq < nppd; iq++) {
       if (not propmattype_index(derivatives_data, iq)) continue;
@@ -830,24 +985,56 @@ void Linefunctions::find_cutoff_ranges(
 
   const bool need_cutoff = (fmax > fmin);
   if (need_cutoff) {
-    // Find range of simulations
-    start_cutoff = 0;
-    Index i_f_max = nf - 1;
-
-    // Loop over positions to compute the line shape cutoff point
-    while (start_cutoff < nf and fmin > f_grid[start_cutoff])
-      ++start_cutoff;
-    while (i_f_max >= start_cutoff and fmax < f_grid[i_f_max])
-      --i_f_max;
-
-    //  The extent is one more than the difference between the indices of interest
-    nelem_cutoff = i_f_max - start_cutoff + 1;  // min is 0, max is nf
+    // Bisect for the first position not below fmin and the first above fmax
+    const Numeric* f = f_grid.data();
+    start_cutoff = std::lower_bound(f, f + nf, fmin) - f;
+    nelem_cutoff = std::upper_bound(f + start_cutoff, f + nf, fmax) - f - start_cutoff;  // min is 0, max is nf
   } else {
     start_cutoff = 0;
     nelem_cutoff = nf;
   }
 }
 
+Linefunctions::BandFrequencyIndex::BandFrequencyIndex(
+    const Eigen::Ref<const Eigen::VectorXd> f_grid,
+    const AbsorptionLines& band) {
+  const Index nl = band.NumLines();
+  const Index nf = f_grid.size();
+  if (not nl or not nf) return;
+  
+  // Lines in order of F0, catalogs are normally sorted already
+  std::vector<Index> order(nl);
+  std::iota(order.begin(), order.end(), 0);
+  auto F0_less = [&](Index a, Index b) {return band.F0(a) < band.F0(b);};
+  if (not std::is_sorted(order.cbegin(), order.cend(), F0_less))
+    std::stable_sort(order.begin(), order.end(), F0_less);
+  
+  auto first = order.cbegin();
+  auto last = order.cend();
+  
+  // The cutoff follows F0 so the lines out of reach of f_grid are found by bisection
+  if (band.Cutoff() == Absorption::CutoffType::ByLine and band.CutoffFreqValue() > 0) {
+    first = std::partition_point(first, last,
+      [&](Index i) {return band.CutoffFreq(i) < f_grid[0];});
+    last = std::partition_point(first, last,
+      [&](Index i) {return band.CutoffFreqMinus(i, 0) <= f_grid[nf - 1];});
+  }
+  
+  const Numeric fmean = (band.Cutoff() == Absorption::CutoffType::ByBand) ? band.F_mean() : 0;
+  line.reserve(last - first);
+  start.reserve(last - first);
+  nelem.reserve(last - first);
+  for (; first not_eq last; ++first) {
+    Index s, n;
+    find_cutoff_ranges(s, n, f_grid, band.CutoffFreqMinus(*first, fmean), band.CutoffFreq(*first));
+    if (not n) continue;
+    
+    line.push_back(*first);
+    start.push_back(s);
+    nelem.push_back(n);
+  }
+}
+
 void Linefunctions::apply_linestrength_from_nlte_level_distributions(
     Eigen::Ref<Eigen::VectorXcd> F,
     Eigen::Ref<Eigen::MatrixXcd> dF,
@@ -1313,7 +1500,39 @@ void Linefunctions::set_cross_section_of_band(
     const Numeric& QT0,
     const bool no_negatives,
     const bool zeeman,
-    const Zeeman::Polarization zeeman_polarization)
+    const Zeeman::Polarization zeeman_polarization,
+    const FaddeevaAlgorithm faddeeva_algorithm)
+{
+  set_cross_section_of_band(scratch, sum, f_grid, band,
+                            BandFrequencyIndex(MapToEigen(f_grid), band),
+                            derivatives_data, vmrs, nlte, P, T, isot_ratio, H,
+                            DC, dDCdT, QT, dQTdT, QT0, no_negatives, zeeman,
+                            zeeman_polarization, faddeeva_algorithm);
+}
+
+void Linefunctions::set_cross_section_of_band(
+    InternalData& scratch,
+    InternalData& sum,
+    const ConstVectorView& f_grid,
+    const AbsorptionLines& band,
+    const BandFrequencyIndex& index,
+    const ArrayOfRetrievalQuantity& derivatives_data,
+    const Vector& vmrs,
+    const EnergyLevelMap& nlte,
+    const Numeric& P,
+    const Numeric& T,
+    const Numeric& isot_ratio,
+    const Numeric& H,
+    const Numeric& DC,
+    const Numeric& dDCdT,
+    const Numeric& QT,
+    const Numeric& dQTdT,
+    const Numeric& QT0,
+    const bool no_negatives,
+    const bool zeeman,
+    const Zeeman::Polarization zeeman_polarization,
+    const FaddeevaAlgorithm faddeeva_algorithm,
+    const Numeric lineshape_window)
 {
   const Index nj = derivatives_data.nelem();
   const bool do_temperature = do_temperature_jacobian(derivatives_data);
@@ -1336,32 +1555,35 @@ void Linefunctions::set_cross_section_of_band(
   // Frequency grid as Eigen type
   const auto f_full = MapToEigen(f_grid);
   
-  // Cut off range
-  const Numeric fmean = (band.Cutoff() == Absorption::CutoffType::ByBand) ? band.F_mean() : 0;
-  Numeric fcut_upp, fcut_low;
-  Index start, nelem;
-  fcut_upp = band.CutoffFreq(0);
-  fcut_low = band.CutoffFreqMinus(0, fmean);
-  find_cutoff_ranges(start, nelem, f_full, fcut_low, fcut_upp);
-  fc[0] = fcut_upp;
-  
   // VMR Jacobian check
   auto do_vmr = do_vmr_jacobian(derivatives_data, band.QuantumIdentity());
   
   // Placeholder nothingness
   constexpr LineShape::Output empty_output = {0, 0, 0, 0, 0, 0, 0, 0, 0};
   
-  for (Index i=0; i<band.NumLines(); i++) {
+  // Only lines that reach f_grid are in the index
+  for (Index k=0; k<index.size(); k++) {
+    const Index i = index.line[k];
+    Index start = index.start[k];
+    Index nelem = index.nelem[k];
+    fc[0] = band.CutoffFreq(i);
     
-    // Select the range of cutoff if different for each line
-    if (band.Cutoff() == Absorption::CutoffType::ByLine and i>0) {
-      fcut_upp = band.CutoffFreq(i);
-      fcut_low = band.CutoffFreqMinus(i, fmean);
-      find_cutoff_ranges(start, nelem, f_full, fcut_low, fcut_upp);
-      fc[0] = fcut_upp;
+    // Pressure broadening and line mixing terms
+    const auto X = band.ShapeParameters(i, T, P, vmrs);
+    
+    // Narrow the range to the window around the line center
+    if (lineshape_window > 0 and not zeeman) {
+      const Numeric F0 = band.F0(i) + X.D0 + X.DV;
+      const Numeric hw = lineshape_window * voigt_halfwidth(
+        band.LineShapeType() == LineShape::Type::DP ? 0 : X.G0, DC * F0);
+      Index s, n;
+      find_cutoff_ranges(s, n, f_full.middleRows(start, nelem), F0 - hw, F0 + hw);
+      if (not n) continue;
+      start += s;
+      nelem = n;
     }
     
-    // Relevant range FIXME: By Band and no-cutoff does not need this...
+    // Relevant range
     auto F = scratch.F.segment(start, nelem);
     auto N = scratch.N.segment(start, nelem);
     auto dF = scratch.dF.middleRows(start, nelem);
@@ -1369,9 +1591,6 @@ void Linefunctions::set_cross_section_of_band(
     auto data = scratch.data.middleRows(start, nelem);
     const auto f = f_full.middleRows(start, nelem);
     
-    // Pressure broadening and line mixing terms
-    const auto X = band.ShapeParameters(i, T, P, vmrs);
-    
     // Partial derivatives for temperature
     const auto dXdT = do_temperature ?
       band.ShapeParameters_dT(i, T, P, vmrs) : empty_output;
@@ -1411,9 +1630,9 @@ void Linefunctions::set_cross_section_of_band(
             set_lorentz(Fc, dFc, datac, fc, dfdH, H, band.F0(i), X, band, i, derivatives_data, dXdT, dXdVMR);
           break;
         case LineShape::Type::VP:
-          set_voigt(F, dF, data, f, dfdH, H, band.F0(i), DC, X, band, i, derivatives_data, dDCdT, dXdT, dXdVMR);
+          set_voigt(F, dF, data, f, dfdH, H, band.F0(i), DC, X, band, i, derivatives_data, dDCdT, dXdT, dXdVMR, faddeeva_algorithm);
           if (band.Cutoff() not_eq Absorption::CutoffType::None)
-            set_voigt(Fc, dFc, datac, fc, dfdH, H, band.F0(i), DC, X, band, i, derivatives_data, dDCdT, dXdT, dXdVMR);
+            set_voigt(Fc, dFc, datac, fc, dfdH, H, band.F0(i), DC, X, band, i, derivatives_data, dDCdT, dXdT, dXdVMR, faddeeva_algorithm);
           break;
         case LineShape::Type::FINAL: break;
       }
@@ -1453,9 +1672,9 @@ void Linefunctions::set_cross_section_of_band(
                 set_lorentz(Nc, dNc, datac, fc, -dfdH, H, -band.F0(i), LineShape::mirroredOutput(X), band, i, derivatives_data, do_temperature ? LineShape::mirroredOutput(dXdT) : empty_output, do_vmr.test ? LineShape::mirroredOutput(dXdVMR) : empty_output);
               break;
             case LineShape::Type::VP:
-              set_voigt(N, dN, data, f, -dfdH, H, -band.F0(i), -DC, LineShape::mirroredOutput(X), band, i, derivatives_data, -dDCdT, do_temperature ? LineShape::mirroredOutput(dXdT) : empty_output, do_vmr.test ? LineShape::mirroredOutput(dXdVMR) : empty_output);
+              set_voigt(N, dN, data, f, -dfdH, H, -band.F0(i), -DC, LineShape::mirroredOutput(X), band, i, derivatives_data, -dDCdT, do_temperature ? LineShape::mirroredOutput(dXdT) : empty_output, do_vmr.test ? LineShape::mirroredOutput(dXdVMR) : empty_output, faddeeva_algorithm);
               if (band.Cutoff() not_eq Absorption::CutoffType::None)
-                set_voigt(Nc, dNc, datac, fc, -dfdH, H, -band.F0(i), -DC, LineShape::mirroredOutput(X), band, i, derivatives_data, -dDCdT, do_temperature ? LineShape::mirroredOutput(dXdT) : empty_output, do_vmr.test ? LineShape::mirroredOutput(dXdVMR) : empty_output);
+                set_voigt(Nc, dNc, datac, fc, -dfdH, H, -band.F0(i), -DC, LineShape::mirroredOutput(X), band, i, derivatives_data, -dDCdT, do_temperature ? LineShape::mirroredOutput(dXdT) : empty_output, do_vmr.test ? LineShape::mirroredOutput(dXdVMR) : empty_output, faddeeva_algorithm);
               break;
             case LineShape::Type::HTP:
             case LineShape::Type::SDVP:
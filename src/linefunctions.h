@@ -41,6 +41,45 @@ namespace Linefunctions {
 /** Size required for data buffer */
 constexpr Index ExpectedDataSize() { return 2; }
 
+/** Algorithms for evaluating the Faddeeva function on a frequency slice
+ *
+ * Faddeeva: Reference implementation, one point at a time (3rdparty/Faddeeva)
+ * HumlicekWeideman32: Two-term Humlicek region I for |x|+y>8, 32-term
+ *   Weideman rational approximation otherwise.  Relative error below 1e-6
+ * HumlicekWeideman24: One-term Humlicek region I for |x|+y>15, 24-term
+ *   Weideman rational approximation otherwise.  Relative error below 1e-4
+ *
+ * The approximations are evaluated branch-free over the whole slice so
+ * that the compiler can vectorize them.  Points in the lower half-plane
+ * always use the reference implementation.
+ */
+ENUMCLASS(FaddeevaAlgorithm, char,
+          Faddeeva,
+          HumlicekWeideman32,
+          HumlicekWeideman24)
+
+/** Sets the Faddeeva function for all points of a slice
+ *
+ * @param[out] W The Faddeeva function.  Must be same size as z
+ * @param[in]  z The complex arguments
+ * @param[in]  algorithm The algorithm used for the evaluation
+ */
+void set_faddeeva(Eigen::Ref<Eigen::VectorXcd> W,
+                  const Eigen::Ref<const Eigen::VectorXcd> z,
+                  const FaddeevaAlgorithm algorithm);
+
+/** Sets the derivative of the Faddeeva function for all points of a slice
+ *
+ * Uses dw/dz = 2i/sqrt(pi) - 2zw, so W must already be set by set_faddeeva
+ *
+ * @param[out] dW The derivative of the Faddeeva function.  Must be same size as z
+ * @param[in]  z The complex arguments
+ * @param[in]  W The Faddeeva function at z
+ */
+void set_dfaddeeva(Eigen::Ref<Eigen::VectorXcd> dW,
+                   const Eigen::Ref<const Eigen::VectorXcd> z,
+                   const Eigen::Ref<const Eigen::VectorXcd> W);
+
 /** Sets the lineshape normalized to unity.
  * 
  * No line mixing or linestrength is computed.
@@ -154,6 +193,7 @@ void set_htp(Eigen::Ref<Eigen::VectorXcd> F,
  * @param[in]     dGD_div_F0_dT Temperature derivative of GD_div_F0
  * @param[in]     dT Temperature derivatives of line shape parameters
  * @param[in]     dVMR VMR derivatives of line shape parameters
+ * @param[in]     faddeeva_algorithm Algorithm for the Faddeeva function
  */
 void set_voigt(
     Eigen::Ref<Eigen::VectorXcd> F,
@@ -171,7 +211,8 @@ void set_voigt(
         ArrayOfRetrievalQuantity(),
     const Numeric& dGD_div_F0_dT = 0.0,
     const LineShape::Output& dT = {0, 0, 0, 0, 0, 0, 0, 0, 0},
-    const LineShape::Output& dVMR = {0, 0, 0, 0, 0, 0, 0, 0, 0});
+    const LineShape::Output& dVMR = {0, 0, 0, 0, 0, 0, 0, 0, 0},
+    const FaddeevaAlgorithm faddeeva_algorithm = FaddeevaAlgorithm::Faddeeva);
 
 /** Sets the Doppler line shape. Normalization is unity.
  * 
@@ -439,6 +480,8 @@ Numeric DopplerConstant(Numeric T, Numeric mass);
 Numeric dDopplerConstant_dT(const Numeric& T, const Numeric& dc);
 
 /** Sets cutoff frequency indices
+ * 
+ * The range is found by bisection, so f_grid must be increasing
  * 
  * @param[out]    start_cutoff Start pos of cutoff frequency
  * @param[out]    end_cutoff End pos of cutoff frequency
@@ -528,6 +571,38 @@ public:
   }
 };  // InternalData
 
+/** Frequency index of the lines of a band
+ * 
+ * Holds the lines of a band in order of increasing F0 together with the
+ * range of f_grid inside the cutoff of each line.  Lines whose cutoff
+ * range does not contain a single f_grid point are left out.
+ * 
+ * The index only depends on the band and the frequency grid, so it is
+ * meant to be built once and then reused for all atmospheric levels
+ */
+class BandFrequencyIndex {
+public:
+  /** Position of the line in the band */
+  std::vector<Index> line;
+  
+  /** First f_grid position inside the cutoff of the line */
+  std::vector<Index> start;
+  
+  /** Number of f_grid positions inside the cutoff of the line */
+  std::vector<Index> nelem;
+  
+  /** Builds the index
+   * 
+   * @param[in] f_grid Frequency grid of computations, increasing
+   * @param[in] band The absorption band
+   */
+  BandFrequencyIndex(const Eigen::Ref<const Eigen::VectorXd> f_grid,
+                     const AbsorptionLines& band);
+  
+  /** Number of lines that reach f_grid */
+  Index size() const noexcept {return Index(line.size());}
+};  // BandFrequencyIndex
+
 /** Computes the cross-section of an absorption band
  * 
  * @param[in,out] scratch Data that is overwritten by every line
@@ -549,6 +624,7 @@ public:
  * @param[in] no_negatives Check sum.F before output of any real negative values, and removes them if present
  * @param[in] zeeman Attempts adding up the fine Zeeman lines
  * @param[in] zeeman_polarization The polarization of Zeeman model (to know how many Zeeman lines there will be)
+ * @param[in] faddeeva_algorithm Algorithm for the Faddeeva function of Voigt lines
  */
 void set_cross_section_of_band(
   InternalData& scratch,
@@ -569,7 +645,42 @@ void set_cross_section_of_band(
   const Numeric& QT0,
   const bool no_negatives=false,
   const bool zeeman=false,
-  const Zeeman::Polarization zeeman_polarization=Zeeman::Polarization::Pi);
+  const Zeeman::Polarization zeeman_polarization=Zeeman::Polarization::Pi,
+  const FaddeevaAlgorithm faddeeva_algorithm=FaddeevaAlgorithm::Faddeeva);
+
+/** Computes the cross-section of an absorption band
+ * 
+ * As above but with a prebuilt frequency index of the band, so that only
+ * the lines and frequencies that matter are visited
+ * 
+ * @param[in] index Frequency index of band on f_grid
+ * @param[in] lineshape_window If positive, every line is only evaluated
+ *   within this many (approximate) Voigt half-widths of its center, on
+ *   top of its cutoff.  Not applied to Zeeman lines
+ */
+void set_cross_section_of_band(
+  InternalData& scratch,
+  InternalData& sum,
+  const ConstVectorView& f_grid,
+  const AbsorptionLines& band,
+  const BandFrequencyIndex& index,
+  const ArrayOfRetrievalQuantity& derivatives_data,
+  const Vector& vmrs,
+  const EnergyLevelMap& nlte,
+  const Numeric& P,
+  const Numeric& T,
+  const Numeric& isot_ratio,
+  const Numeric& H,
+  const Numeric& DC,
+  const Numeric& dDCdT,
+  const Numeric& QT,
+  const Numeric& dQTdT,
+  const Numeric& QT0,
+  const bool no_negatives=false,
+  const bool zeeman=false,
+  const Zeeman::Polarization zeeman_polarization=Zeeman::Polarization::Pi,
+  const FaddeevaAlgorithm faddeeva_algorithm=FaddeevaAlgorithm::Faddeeva,
+  const Numeric lineshape_window=0);
 };  // namespace Linefunctions
 
 #endif  //linefunctions_h
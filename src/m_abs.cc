@@ -1704,9 +1704,17 @@ void abs_xsec_per_speciesAddLines(
     const SpeciesAuxData& isotopologue_ratios,
     const SpeciesAuxData& partition_functions,
     const Index& lbl_checked,
+    const String& faddeeva_algorithm,
+    const Numeric& lineshape_window,
     const Verbosity&) {
   if (not abs_lines_per_species.nelem()) return;
   
+  const auto faddeeva_type =
+      Linefunctions::toFaddeevaAlgorithmOrThrow(faddeeva_algorithm);
+  
+  ARTS_USER_ERROR_IF (lineshape_window < 0,
+    "The line shape window must be non-negative, got: ", lineshape_window)
+  
   ARTS_USER_ERROR_IF (not lbl_checked,
     "Please set lbl_checked true to use this function");
 
@@ -1755,7 +1763,9 @@ void abs_xsec_per_speciesAddLines(
           lines,
           isotopologue_ratios.getIsotopologueRatio(lines.QuantumIdentity()),
           partition_functions.getParamType(lines.QuantumIdentity()),
-          partition_functions.getParam(lines.QuantumIdentity()));
+          partition_functions.getParam(lines.QuantumIdentity()),
+          faddeeva_type,
+          lineshape_window);
     }
   }  // End of species for loop.
 }
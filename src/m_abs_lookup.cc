@@ -31,6 +31,7 @@
 #include "agenda_class.h"
 #include "arts.h"
 #include "arts_omp.h"
+#include "artstime.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "cloudbox.h"
@@ -56,6 +57,21 @@ void abs_lookupInit(GasAbsLookup& x, const Verbosity& verbosity) {
   out2 << "  Created an empty gas absorption lookup table.\n";
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lookupReadMapped(GasAbsLookup& abs_lookup,
+                          const String& filename,
+                          const Verbosity& verbosity) {
+  abs_lookup.ReadMapped(filename, verbosity);
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lookupWriteMapped(const GasAbsLookup& abs_lookup,
+                           const String& filename,
+                           const String& storage,
+                           const Verbosity& verbosity) {
+  abs_lookup.WriteMapped(filename, toLookupStorageOrThrow(storage), verbosity);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void abs_lookupCalc(  // Workspace reference:
     Workspace& ws,
@@ -77,20 +93,12 @@ void abs_lookupCalc(  // Workspace reference:
   CREATE_OUT2;
   CREATE_OUT3;
 
-  // We need this temporary variable to make a local copy of all VMRs,
-  // where we then perturb the H2O profile as needed
-  Matrix these_all_vmrs = abs_vmrs;
-
   // We will be calling an absorption agenda one species at a
   // time. This is better than doing all simultaneously, because is
   // saves memory and allows for consistent treatment of nonlinear
   // species. But it means we need local copies of species, line list,
   // and line shapes for agenda communication.
 
-  // Absorption cross sections per tag group.
-  ArrayOfMatrix abs_xsec_per_species, src_xsec_per_species;
-  ArrayOfArrayOfMatrix dabs_xsec_per_species_dx, dsrc_xsec_per_species_dx;
-
   // 2. Determine various important sizes:
   const Index n_species = abs_species.nelem();  // Number of abs species
   const Index n_nls = abs_nls.nelem();          // Number of nonlinear species
@@ -100,23 +108,9 @@ void abs_lookupCalc(  // Workspace reference:
   const Index n_nls_pert = abs_nls_pert.nelem();  // Number of VMR pert. for NLS
 
   // 3. Input to absorption calculations:
-
-  // Absorption vmrs and temperature:
-  Matrix this_vmr(1, n_p_grid);
-  Vector abs_h2o(n_p_grid);
-  Vector this_t;  // Has same dimension, but is
-                  // initialized by assignment later.
   const EnergyLevelMap this_nlte_dummy;
 
-  // Species list, lines, and line shapes, all with only 1 element:
-  ArrayOfArrayOfSpeciesTag this_species(1);
-
-  // List of active species for agenda call. Will always be filled with only
-  // one species.
-  ArrayOfIndex abs_species_active(1);
-
-  // Local copy of nls_pert and t_pert:
-  Vector these_nls_pert;  // Is resized every time when used
+  // Local copy of t_pert:
   Vector these_t_pert;    // Is resized later on
 
   // 4. Checks of input parameter correctness:
@@ -229,6 +223,7 @@ void abs_lookupCalc(  // Workspace reference:
 
     abs_lookup.xsec.resize(a, b, c, d);
     abs_lookup.xsec = NAN;
+    abs_lookup.mapped_xsec.reset();
   }
 
   // 6.a. Set up these_t_pert. This is done so that we can use the
@@ -247,16 +242,24 @@ void abs_lookupCalc(  // Workspace reference:
   const Index these_t_pert_nelem = these_t_pert.nelem();
 
   // 7. Now we have to fill abs_lookup.xsec with the right values!
-
-  String fail_msg;
-  bool failed = false;
-
-  // We have to make a local copy of the Workspace and the agenda because
-  // only non-reference types can be declared firstprivate in OpenMP
-  Workspace l_ws(ws);
-  Agenda l_abs_xsec_agenda(abs_xsec_agenda);
-
-  // Loop species:
+  //
+  // Every combination of species, H2O VMR perturbation and temperature
+  // perturbation is an independent agenda call.  If there are fewer of
+  // these than threads, the pressure grid is split as well, since the
+  // absorption of different pressure levels is also independent.  All
+  // combinations are put in one flat list of work items that the threads
+  // pick from dynamically, so that cheap and expensive species mix.
+
+  // A single agenda call and where its output goes in abs_lookup.xsec
+  struct WorkItem {
+    Index species;  // Position in abs_species
+    Index spec;     // Second dimension of abs_lookup.xsec
+    Index nls;      // Position in abs_nls_pert (if non-linear)
+    Index t;        // First dimension of abs_lookup.xsec
+    Range p;        // Pressure levels
+  };
+
+  Array<WorkItem> work_items;
   for (Index i = 0, spec = 0; i < n_species; ++i) {
     // Skipping Zeeman and free_electrons species.
     // (Mixed tag groups between those and other species are not allowed.)
@@ -268,173 +271,148 @@ void abs_lookupCalc(  // Workspace reference:
     }
 
     // spec is the index for the second dimension of abs_lookup.xsec.
+    const Index this_n_nls_pert = non_linear[i] ? n_nls_pert : 1;
+    for (Index s = 0; s < this_n_nls_pert; ++s, ++spec)
+      for (Index j = 0; j < these_t_pert_nelem; ++j)
+        work_items.push_back({i, spec, s, j, Range(0, n_p_grid)});
+  }
 
-    // Prepare absorption agenda input for this species:
-    out2 << "  Doing species " << i + 1 << " of " << n_species << ": "
-         << abs_species[i] << ".\n";
+  const bool do_parallel = not arts_omp_in_parallel() and arts_omp_get_max_threads() > 1;
+  const Index n_p_chunks =
+      do_parallel and work_items.nelem()
+          ? std::min(n_p_grid,
+                     (arts_omp_get_max_threads() + work_items.nelem() - 1) /
+                         work_items.nelem())
+          : 1;
+  if (n_p_chunks > 1) {
+    Array<WorkItem> chunked_items;
+    for (auto& item : work_items) {
+      for (Index c = 0; c < n_p_chunks; c++) {
+        const Index p0 = (c * n_p_grid) / n_p_chunks;
+        const Index p1 = ((c + 1) * n_p_grid) / n_p_chunks;
+        chunked_items.push_back(item);
+        chunked_items.back().p = Range(p0, p1 - p0);
+      }
+    }
+    work_items = std::move(chunked_items);
+  }
+  const Index n_items = work_items.nelem();
+
+  out2 << "  Computing " << n_items << " work items";
+  if (n_p_chunks > 1) out2 << " (pressure grid split in " << n_p_chunks << ")";
+  out2 << ".\n";
 
-    // Set active species:
-    abs_species_active[0] = i;
+  String fail_msg;
+  bool failed = false;
+  Vector item_seconds(n_items, 0);
+  const Time start_all;
 
-    // Get a dummy list of tag groups with only the current element:
-    this_species[0].resize(abs_species[i].nelem());
-    this_species[0] = abs_species[i];
+#pragma omp parallel for schedule(dynamic) if (do_parallel)
+  for (Index k = 0; k < n_items; ++k) {
+    // Skip remaining iterations if an error occurred
+    if (failed) continue;
 
-    // Set up these_nls_pert. This is done so that we can use the
-    // same loop over the perturbations, independent of
-    // whether we have nonlinear species or not.
-    if (non_linear[i]) {
-      out2 << "  This is a species with H2O VMR perturbations.\n";
-      these_nls_pert.resize(n_nls_pert);
-      these_nls_pert = abs_nls_pert;
-    } else {
-      these_nls_pert.resize(1);
-      these_nls_pert = 1;
-    }
+    // The try block here is necessary to correctly handle
+    // exceptions inside the parallel region.
+    try {
+      const Time start_item;
+      const WorkItem& item = work_items[k];
 
-    // Loop these_nls_pert:
-    for (Index s = 0; s < these_nls_pert.nelem(); ++s, ++spec) {
-      // Remember, spec is the index for the second dimension of
-      // abs_lookup.xsec
+      // Each item needs its own copy of the workspace
+      PooledWorkspace l_ws(ws);
+      const Index np = item.p.get_extent();
 
-      if (non_linear[i]) {
-        out2 << "  Doing H2O VMR variant " << s + 1 << " of " << n_nls_pert
-             << ": " << abs_nls_pert[s] << ".\n";
-      }
+      // Absorption cross sections per tag group.
+      ArrayOfMatrix abs_xsec_per_species, src_xsec_per_species;
+      ArrayOfArrayOfMatrix dabs_xsec_per_species_dx, dsrc_xsec_per_species_dx;
+
+      // Set active species:
+      const ArrayOfIndex abs_species_active(1, item.species);
 
       // Make a local copy of the VMRs, and manipulate the H2O VMR within it.
       // Note: We do not need a runtime error check that h2o_index is ok here,
       // because earlier on we throw an error if there is no H2O species although we
       // need it. So, if h2o_indes is -1, we here simply assume that there
       // should not be a perturbation
-      if (h2o_index >= 0) {
-        these_all_vmrs(h2o_index, joker) = abs_vmrs(h2o_index, joker);
-        these_all_vmrs(h2o_index, joker) *=
-            these_nls_pert[s];  // Add perturbation
+      Matrix these_all_vmrs = abs_vmrs(joker, item.p);
+      if (h2o_index >= 0 and non_linear[item.species])
+        these_all_vmrs(h2o_index, joker) *= abs_nls_pert[item.nls];
+
+      // Create perturbed temperature profile:
+      Vector this_t = abs_lookup.t_ref[item.p];
+      this_t += these_t_pert[item.t];
+
+      // Call agenda to calculate absorption:
+      abs_xsec_agendaExecute(*l_ws,
+                             abs_xsec_per_species,
+                             src_xsec_per_species,
+                             dabs_xsec_per_species_dx,
+                             dsrc_xsec_per_species_dx,
+                             abs_species,
+                             ArrayOfRetrievalQuantity(0),
+                             abs_species_active,
+                             f_grid,
+                             abs_p[item.p],
+                             this_t,
+                             this_nlte_dummy,
+                             these_all_vmrs,
+                             abs_xsec_agenda);
+
+      // Store in the right place:
+      // Loop through all altitudes
+      for (Index p = 0; p < np; ++p) {
+        abs_lookup.xsec(item.t, item.spec, joker, item.p.get_start() + p) =
+            abs_xsec_per_species[item.species](joker, p);
+
+        // There used to be a division by the number density
+        // n here. This is no longer necessary, since
+        // abs_xsec_per_species now contains true absorption
+        // cross sections.
+
+        // IMPORTANT: There was a bug in my old Matlab
+        // function "create_lookup.m" to generate the lookup
+        // table. (The number density was always the
+        // reference one, and did not change for different
+        // temperatures.) Patricks Atmlab function
+        // "arts_abstable_from_arts1.m" did *not* have this bug.
       }
 
-      // VMR for this species (still needed by interfact to continua):
-      // FIXME: This variable may go away eventually, when the continuum
-      // part no longer needs it.
-      this_vmr(0, joker) = these_all_vmrs(i, joker);
-
-      // For abs_h2o, we can always add the perturbations (it will
-      // not make a difference if the species itself is also H2O).
-      // Attention, we need to treat here also the case that there
-      // is no H2O species. We will then set abs_h2o to
-      // -1. Absorption routines that do not really need abs_h2o
-      // will still run.
-      //
-      // FIXME: abs_h2o is currently still needed by the continuum part.
-      // Should go away eventually.
-      if (h2o_index == -1) {
-        // The case without H2O species.
-        abs_h2o.resize(1);
-        abs_h2o = -1;
-      } else {
-        // The normal case.
-        abs_h2o = these_all_vmrs(h2o_index, joker);
-      }
+      item_seconds[k] = TimeStep(Time() - start_item).count();
 
-      // Loop temperature perturbations
-      // ------------------------------
-
-      // We use a parallel for loop for this.
-
-      // There is something strange here: abs_lookup seems to be
-      // "shared" by default, although I have set default(none). I
-      // suspect that the reason for this behavior is that
-      // abs_lookup is a return by reference parameter of this
-      // function. Anyway, shared is the correct setting for
-      // abs_lookup, so there is no problem.
-
-#pragma omp parallel for if (                                         \
-    !arts_omp_in_parallel() &&                                        \
-    these_t_pert_nelem >=                                             \
-        arts_omp_get_max_threads()) private(this_t,                   \
-                                            abs_xsec_per_species,     \
-                                            src_xsec_per_species,     \
-                                            dabs_xsec_per_species_dx, \
-                                            dsrc_xsec_per_species_dx) \
-    firstprivate(l_ws, l_abs_xsec_agenda)
-      for (Index j = 0; j < these_t_pert_nelem; ++j) {
-        // Skip remaining iterations if an error occurred
-        if (failed) continue;
-
-        // The try block here is necessary to correctly handle
-        // exceptions inside the parallel region.
-        try {
-          if (0 != n_t_pert) {
-            // We first prepare the output in a string here,
-            // so that we can write it to out3 with a single
-            // operation. This avoids messy output from
-            // multiple threads.
-            ostringstream os;
-
-            os << "  Doing temperature variant " << j + 1 << " of " << n_t_pert
-               << ": " << these_t_pert[j] << ".\n";
-
-            out3 << os.str();
-          }
-
-          // Create perturbed temperature profile:
-          this_t = abs_lookup.t_ref;
-          this_t += these_t_pert[j];
-
-          // Call agenda to calculate absorption:
-          abs_xsec_agendaExecute(l_ws,
-                                 abs_xsec_per_species,
-                                 src_xsec_per_species,
-                                 dabs_xsec_per_species_dx,
-                                 dsrc_xsec_per_species_dx,
-                                 abs_species,
-                                 ArrayOfRetrievalQuantity(0),
-                                 abs_species_active,
-                                 f_grid,
-                                 abs_p,
-                                 this_t,
-                                 this_nlte_dummy,
-                                 these_all_vmrs,
-                                 l_abs_xsec_agenda);
-
-          // Store in the right place:
-          // Loop through all altitudes
-          for (Index p = 0; p < n_p_grid; ++p) {
-            abs_lookup.xsec(j, spec, Range(joker), p) =
-                abs_xsec_per_species[i](Range(joker), p);
-
-            // There used to be a division by the number density
-            // n here. This is no longer necessary, since
-            // abs_xsec_per_species now contains true absorption
-            // cross sections.
-
-            // IMPORTANT: There was a bug in my old Matlab
-            // function "create_lookup.m" to generate the lookup
-            // table. (The number density was always the
-            // reference one, and did not change for different
-            // temperatures.) Patricks Atmlab function
-            // "arts_abstable_from_arts1.m" did *not* have this bug.
-
-            // Calculate the number density for the given pressure and
-            // temperature:
-            // n = n0*T0/p0 * p/T or n = p/kB/t, ideal gas law
-            //                  const Numeric n = number_density( abs_lookup.p_grid[p],
-            //                                                    this_t[p]   );
-            //                  abs_lookup.xsec( j, spec, Range(joker), p ) /= n;
-          }
-        }  // end of try block
-        catch (const std::runtime_error& e) {
+      // We first prepare the output in a string here,
+      // so that we can write it to out3 with a single
+      // operation. This avoids messy output from
+      // multiple threads.
+      ostringstream os;
+      os << "  Work item " << k + 1 << " of " << n_items << ": species "
+         << item.species + 1 << " (" << abs_species[item.species] << ")";
+      if (non_linear[item.species])
+        os << ", H2O VMR variant " << item.nls + 1 << " of " << n_nls_pert;
+      if (0 != n_t_pert)
+        os << ", temperature variant " << item.t + 1 << " of " << n_t_pert;
+      if (n_p_chunks > 1)
+        os << ", pressure levels " << item.p.get_start() + 1 << "-"
+           << item.p.get_start() + np << " of " << n_p_grid;
+      os << " done by thread " << arts_omp_get_thread_num() << " in "
+         << item_seconds[k] << " s.\n";
+      out3 << os.str();
+    }  // end of try block
+    catch (const std::runtime_error& e) {
 #pragma omp critical(abs_lookupCalc_fail)
-          {
-            fail_msg = e.what();
-            failed = true;
-          }
-        }
-      }  // end of parallel for loop
-
-      if (failed) throw runtime_error(fail_msg);
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
     }
-  }
+  }  // end of parallel for loop
+
+  if (failed) throw runtime_error(fail_msg);
+
+  if (n_items)
+    out2 << "  Work items took " << min(item_seconds) << "-"
+         << max(item_seconds) << " s each, " << item_seconds.sum()
+         << " s in total and " << TimeStep(Time() - start_all).count()
+         << " s wall time.\n";
 
   // 6. Initialize fgp_default.
   abs_lookup.flag_default = Interpolation::LagrangeVector(abs_lookup.f_grid, abs_lookup.f_grid, 0);
@@ -2026,7 +2004,7 @@ void propmat_clearskyAddFromLookup(
   CREATE_OUT3;
 
   // Variables needed by abs_lookup.Extract:
-  Matrix abs_scalar_gas, dabs_scalar_gas_df, dabs_scalar_gas_dt;
+  Matrix dabs_scalar_gas_df;
 
   // Check if the table has been adapted:
   if (1 != abs_lookup_is_adapted)
@@ -2050,20 +2028,34 @@ void propmat_clearskyAddFromLookup(
 			     "order frequency interpolation in the lookup table.  Please use\n"
 			     "abs_f_interp_order>0 or remove wind/frequency Jacobian.");
   
-  // The function we are going to call here is one of the few helper
-  // functions that adjust the size of their output argument
-  // automatically.
-  abs_lookup.Extract(abs_scalar_gas,
+  // The unperturbed and the temperature perturbed absorption are
+  // extracted together, as a path of one or two points. The
+  // interpolation setup is then shared between the two.
+  const Index n_t = do_temp_jac ? 2 : 1;
+  Vector t_points(n_t, a_temperature);
+  if (do_temp_jac) t_points[1] += dt;
+  Matrix vmr_points(a_vmr_list.nelem(), n_t);
+  for (Index it = 0; it < n_t; ++it) vmr_points(joker, it) = a_vmr_list;
+
+  Tensor3 sga_points(n_t, a_vmr_list.nelem(), f_grid.nelem());
+  abs_lookup.Extract(sga_points,
                      abs_p_interp_order,
                      abs_t_interp_order,
                      abs_nls_interp_order,
                      abs_f_interp_order,
-                     a_pressure,
-                     a_temperature,
-                     a_vmr_list,
+                     Vector(n_t, a_pressure),
+                     t_points,
+                     vmr_points,
                      f_grid,
                      extpolfac);
+  const ConstMatrixView abs_scalar_gas = sga_points(0, joker, joker);
+  const ConstMatrixView dabs_scalar_gas_dt =
+      sga_points(n_t - 1, joker, joker);
+
   if (do_freq_jac) {
+    // The function we are going to call here is one of the few helper
+    // functions that adjust the size of their output argument
+    // automatically.
     Vector dfreq = f_grid;
     dfreq += df;
     abs_lookup.Extract(dabs_scalar_gas_df,
@@ -2077,19 +2069,6 @@ void propmat_clearskyAddFromLookup(
                        dfreq,
                        extpolfac);
   }
-  if (do_temp_jac) {
-    const Numeric dtemp = a_temperature + dt;
-    abs_lookup.Extract(dabs_scalar_gas_dt,
-                       abs_p_interp_order,
-                       abs_t_interp_order,
-                       abs_nls_interp_order,
-                       abs_f_interp_order,
-                       a_pressure,
-                       dtemp,
-                       a_vmr_list,
-                       f_grid,
-                       extpolfac);
-  }
 
   // Now add to the right place in the absorption matrix.
 
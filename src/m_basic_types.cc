@@ -1313,6 +1313,32 @@ void VectorMatrixMultiply(  // WS Generic Output:
   y = dummy;
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void VectorSparseMultiply(  // WS Generic Output:
+    Vector& y,
+    // WS Generic Input:
+    const Sparse& M,
+    const Vector& x,
+    const Verbosity&) {
+  // Check that dimensions are right, x must match columns of M:
+  if (M.ncols() != x.nelem()) {
+    ostringstream os;
+    os << "Sparse and vector dimensions must be consistent!\n"
+       << "Sparse.ncols() = " << M.ncols() << "\n"
+       << "Vector.nelem() = " << x.nelem();
+    throw runtime_error(os.str());
+  }
+
+  // Temporary for the result:
+  Vector dummy(M.nrows());
+
+  mult(dummy, M, x);
+
+  y.resize(dummy.nelem());
+
+  y = dummy;
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void VectorNLinSpace(Vector& x,
                      const Index& n,
@@ -41,6 +41,7 @@ using namespace std;
 
 #include "arts.h"
 #include "arts_omp.h"
+#include "artstime.h"
 #include "auto_md.h"
 #include "math_funcs.h"
 #include "physics_funcs.h"
@@ -117,107 +118,139 @@ void ybatchCalc(Workspace& ws,
     ybatch_jacobians[i].resize(0, 0);
   }
 
-  // We have to make a local copy of the Workspace and the agendas because
-  // only non-reference types can be declared firstprivate in OpenMP
-  Workspace l_ws(ws);
-  Agenda l_ybatch_calc_agenda(ybatch_calc_agenda);
+  // Calculation of a single batch case, using the workspace l_ws.
+  // job_seconds stays negative for cases that are not run.
+  Vector job_seconds(ybatch_n, -1);
+  const Time start_all;
+  auto job_body = [&](Workspace& l_ws, const Index ybatch_index) {
+    Index l_job_counter;  // Thread-local copy of job counter.
 
-  // Go through the batch:
-
-  if (ybatch_n)
-#pragma omp parallel for schedule(dynamic) if (!arts_omp_in_parallel() && \
-                                               ybatch_n > 1)              \
-    firstprivate(l_ws, l_ybatch_calc_agenda)
-    for (Index ybatch_index = first_ybatch_index; ybatch_index < ybatch_n;
-         ybatch_index++) {
-      Index l_job_counter;  // Thread-local copy of job counter.
-
-      if (do_abort) continue;
+    if (do_abort) return;
 #pragma omp critical(ybatchCalc_job_counter)
-      { l_job_counter = ++job_counter; }
+    { l_job_counter = ++job_counter; }
+
+    {
+      ostringstream os;
+      os << "  Job " << l_job_counter << " of " << ybatch_n << ", Index "
+         << ybatch_start + ybatch_index << ", Thread-Id "
+         << arts_omp_get_thread_num() << "\n";
+      out2 << os.str();
+    }
 
-      {
-        ostringstream os;
-        os << "  Job " << l_job_counter << " of " << ybatch_n << ", Index "
-           << ybatch_start + ybatch_index << ", Thread-Id "
-           << arts_omp_get_thread_num() << "\n";
-        out2 << os.str();
-      }
+    const Time start_job;
+    try {
+      Vector y;
+      ArrayOfVector y_aux;
+      Matrix jacobian;
 
-      try {
-        Vector y;
-        ArrayOfVector y_aux;
-        Matrix jacobian;
-
-        ybatch_calc_agendaExecute(l_ws,
-                                  y,
-                                  y_aux,
-                                  jacobian,
-                                  ybatch_start + ybatch_index,
-                                  l_ybatch_calc_agenda);
-
-        if (y.nelem()) {
+      ybatch_calc_agendaExecute(l_ws,
+                                y,
+                                y_aux,
+                                jacobian,
+                                ybatch_start + ybatch_index,
+                                ybatch_calc_agenda);
+
+      if (y.nelem()) {
 #pragma omp critical(ybatchCalc_assign_y)
-          ybatch[ybatch_index] = y;
+        ybatch[ybatch_index] = y;
 #pragma omp critical(ybatchCalc_assign_y_aux)
-          ybatch_aux[ybatch_index] = y_aux;
-
-          // Dimensions of Jacobian:
-          const Index Knr = jacobian.nrows();
-          const Index Knc = jacobian.ncols();
-
-          if (Knr != 0 || Knc != 0) {
-            if (Knr != y.nelem()) {
-              ostringstream os;
-              os << "First dimension of Jacobian must have same length as the measurement *y*.\n"
-                 << "Length of *y*: " << y.nelem() << "\n"
-                 << "Dimensions of *jacobian*: (" << Knr << ", " << Knc
-                 << ")\n";
-              // A mismatch of the Jacobian dimension is a fatal error
-              // and should result in program termination. By setting abort
-              // to true, this will result in a runtime error in the catch
-              // block even if robust == 1
+        ybatch_aux[ybatch_index] = y_aux;
+
+        // Dimensions of Jacobian:
+        const Index Knr = jacobian.nrows();
+        const Index Knc = jacobian.ncols();
+
+        if (Knr != 0 || Knc != 0) {
+          if (Knr != y.nelem()) {
+            ostringstream os;
+            os << "First dimension of Jacobian must have same length as the measurement *y*.\n"
+               << "Length of *y*: " << y.nelem() << "\n"
+               << "Dimensions of *jacobian*: (" << Knr << ", " << Knc
+               << ")\n";
+            // A mismatch of the Jacobian dimension is a fatal error
+            // and should result in program termination. By setting abort
+            // to true, this will result in a runtime error in the catch
+            // block even if robust == 1
 #pragma omp critical(ybatchCalc_setabort)
-              do_abort = true;
+            do_abort = true;
 
-              throw runtime_error(os.str());
-            }
+            throw runtime_error(os.str());
+          }
 
-            ybatch_jacobians[ybatch_index] = jacobian;
+          ybatch_jacobians[ybatch_index] = jacobian;
 
-            // After creation, all individual Jacobi matrices in the array will be
-            // empty (size zero). No need for explicit initialization.
-          }
+          // After creation, all individual Jacobi matrices in the array will be
+          // empty (size zero). No need for explicit initialization.
         }
-      } catch (const std::exception& e) {
-        if (robust && !do_abort) {
-          ostringstream os;
-          os << "WARNING! Job at ybatch_index " << ybatch_start + ybatch_index
-             << " failed.\n"
-             << "y Vector in output variable ybatch will be empty for this job.\n"
-             << "The runtime error produced was:\n"
-             << e.what() << "\n";
-          out0 << os.str();
-        } else {
-          // The user wants the batch job to fail if one of the
-          // jobs goes wrong.
+      }
+    } catch (const std::exception& e) {
+      if (robust && !do_abort) {
+        ostringstream os;
+        os << "WARNING! Job at ybatch_index " << ybatch_start + ybatch_index
+           << " failed.\n"
+           << "y Vector in output variable ybatch will be empty for this job.\n"
+           << "The runtime error produced was:\n"
+           << e.what() << "\n";
+        out0 << os.str();
+      } else {
+        // The user wants the batch job to fail if one of the
+        // jobs goes wrong.
 #pragma omp critical(ybatchCalc_setabort)
-          do_abort = true;
+        do_abort = true;
 
-          ostringstream os;
-          os << "  Job at ybatch_index " << ybatch_start + ybatch_index
-             << " failed. Aborting...\n";
-          out1 << os.str();
-        }
         ostringstream os;
-        os << "Run-time error at ybatch_index " << ybatch_start + ybatch_index
-           << ": \n"
-           << e.what();
-#pragma omp critical(ybatchCalc_push_fail_msg)
-        fail_msg.push_back(os.str());
+        os << "  Job at ybatch_index " << ybatch_start + ybatch_index
+           << " failed. Aborting...\n";
+        out1 << os.str();
       }
+      ostringstream os;
+      os << "Run-time error at ybatch_index " << ybatch_start + ybatch_index
+         << ": \n"
+         << e.what();
+#pragma omp critical(ybatchCalc_push_fail_msg)
+      fail_msg.push_back(os.str());
     }
 
+    job_seconds[ybatch_index] = TimeStep(Time() - start_job).count();
+
+    ostringstream os;
+    os << "  Job at ybatch_index " << ybatch_start + ybatch_index
+       << " done by thread " << arts_omp_get_thread_num() << " in "
+       << job_seconds[ybatch_index] << " s.\n";
+    out3 << os.str();
+  };
+
+  // Go through the batch. The cases are run as tasks, so a thread that
+  // is done with a cheap case takes the next one, and threads without a
+  // case left help with the measurement blocks and los of the cases still
+  // running (see yCalc).
+  if (ybatch_n > 1) {
+    arts_omp_taskloop(ybatch_n - first_ybatch_index, [&](const Index i) {
+      // Each task needs its own copy of the workspace
+      PooledWorkspace l_ws(ws);
+      job_body(*l_ws, first_ybatch_index + i);
+    });
+  } else if (ybatch_n) {
+    PooledWorkspace l_ws(ws);
+    job_body(*l_ws, first_ybatch_index);
+  }
+
+  if (ybatch_n > 1) {
+    Numeric min_seconds = 0, max_seconds = 0, sum_seconds = 0;
+    Index n_run = 0;
+    for (const Numeric& s : job_seconds) {
+      if (s < 0) continue;
+      min_seconds = n_run ? min(min_seconds, s) : s;
+      max_seconds = max(max_seconds, s);
+      sum_seconds += s;
+      n_run++;
+    }
+    out2 << "  " << n_run << " batch cases took " << min_seconds << "-"
+         << max_seconds << " s each, " << sum_seconds
+         << " s in total and " << TimeStep(Time() - start_all).count()
+         << " s wall time.\n";
+  }
+
   if (fail_msg.nelem()) {
     ostringstream os;
 
@@ -684,17 +717,11 @@ void DOBatchCalc(Workspace& ws,
   dobatch_irradiance_field.resize(ybatch_n);
   dobatch_spectral_irradiance_field.resize(ybatch_n);
 
-  // We have to make a local copy of the Workspace and the agendas because
-  // only non-reference types can be declared firstprivate in OpenMP
-  Workspace l_ws(ws);
-  Agenda l_dobatch_calc_agenda(dobatch_calc_agenda);
-
   // Go through the batch:
 
   if (ybatch_n)
 #pragma omp parallel for schedule(dynamic) if (!arts_omp_in_parallel() && \
-                                               ybatch_n > 1)              \
-    firstprivate(l_ws, l_dobatch_calc_agenda)
+                                               ybatch_n > 1)
     for (Index ybatch_index = first_ybatch_index; ybatch_index < ybatch_n;
          ybatch_index++) {
       Index l_job_counter;  // Thread-local copy of job counter.
@@ -717,13 +744,15 @@ void DOBatchCalc(Workspace& ws,
         Tensor4 irradiance_field;
         Tensor5 spectral_irradiance_field;
 
-        dobatch_calc_agendaExecute(l_ws,
+        // Each job needs its own copy of the workspace
+        PooledWorkspace l_ws(ws);
+        dobatch_calc_agendaExecute(*l_ws,
                                    cloudbox_field,
                                    radiance_field,
                                    irradiance_field,
                                    spectral_irradiance_field,
                                    ybatch_start + ybatch_index,
-                                   l_dobatch_calc_agenda);
+                                   dobatch_calc_agenda);
 
 #pragma omp critical(dobatchCalc_assign_cloudbox_field)
         dobatch_cloudbox_field[ybatch_index] = cloudbox_field;
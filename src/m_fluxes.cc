@@ -639,6 +639,7 @@ void spectral_radiance_fieldClearskyPlaneParallel(
                            iy_transmittance,
                            rte_alonglos_v,
                            surface_props_data,
+                           0,
                            verbosity);
         ARTS_ASSERT(iy.ncols() == stokes_dim);
 
@@ -895,6 +896,7 @@ void spectral_radiance_fieldExpandCloudboxField(
                            iy_transmittance,
                            rte_alonglos_v,
                            surface_props_data,
+                           0,
                            verbosity);
         ARTS_ASSERT(iy.ncols() == stokes_dim);
 
@@ -962,6 +962,7 @@ void iyHybrid(Workspace& ws,
                        iy_transmittance,
                        rte_alonglos_v,
                        surface_props_data,
+                       0,
                        verbosity);
     return;
   }
@@ -46,7 +46,14 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
 #include "array.h"
+#include "arts_omp.h"
+#include "artstime.h"
 #include "check_input.h"
 #include "m_general.h"
 #include "messages.h"
@@ -393,6 +400,79 @@ void timerStop(  // WS Input
 }
 #endif
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void Benchmark(Workspace& ws,
+               const Agenda& benchmark_agenda,
+               const String& name,
+               const Index& nrepeat,
+               const Index& nwarmup,
+               const String& filename,
+               const Verbosity& verbosity) {
+  CREATE_OUT1;
+  CREATE_OUT2;
+
+  ARTS_USER_ERROR_IF(nrepeat < 1, "*nrepeat* must be at least 1.");
+  ARTS_USER_ERROR_IF(nwarmup < 0, "*nwarmup* can not be negative.");
+
+  const Time start_benchmark;
+
+  for (Index i = 0; i < nwarmup; i++) {
+    benchmark_agendaExecute(ws, benchmark_agenda);
+    out2 << "  " << name << ": warm-up run " << i + 1 << " of " << nwarmup
+         << " done.\n";
+  }
+
+  std::vector<Numeric> seconds(nrepeat);
+  for (Index i = 0; i < nrepeat; i++) {
+    const Time start;
+    benchmark_agendaExecute(ws, benchmark_agenda);
+    seconds[i] = TimeStep(Time() - start).count();
+    out2 << "  " << name << ": run " << i + 1 << " of " << nrepeat
+         << " took " << seconds[i] << " s.\n";
+  }
+
+  // Statistics of the run times
+  std::vector<Numeric> sorted(seconds);
+  std::sort(sorted.begin(), sorted.end());
+  const Numeric t_min = sorted.front();
+  const Numeric t_max = sorted.back();
+  const Numeric t_median =
+      nrepeat % 2 ? sorted[nrepeat / 2]
+                  : 0.5 * (sorted[nrepeat / 2 - 1] + sorted[nrepeat / 2]);
+  const Numeric t_mean =
+      std::accumulate(sorted.begin(), sorted.end(), Numeric(0)) /
+      Numeric(nrepeat);
+  Numeric t_std = 0;
+  if (nrepeat > 1) {
+    for (const Numeric t : sorted) t_std += (t - t_mean) * (t - t_mean);
+    t_std = sqrt(t_std / Numeric(nrepeat - 1));
+  }
+
+  out1 << "  " << name << ": " << t_median << " s median, " << t_min << "-"
+       << t_max << " s range, " << t_mean << " +- " << t_std << " s mean ("
+       << nrepeat << " runs, " << arts_omp_get_max_threads() << " threads)\n";
+
+  // Append the result as one line of JSON
+  String ofilename = filename;
+  if (ofilename == "") {
+    extern const String out_basename;
+    ofilename = out_basename + ".benchmark.jsonl";
+  }
+
+  std::ofstream ofs(ofilename.c_str(), std::ios::app);
+  ARTS_USER_ERROR_IF(!ofs, "Cannot open file ", ofilename, " for writing.");
+
+  ofs << std::setprecision(9) << "{\"name\": \"" << name << "\", \"time\": \""
+      << start_benchmark << "\", \"threads\": " << arts_omp_get_max_threads()
+      << ", \"nwarmup\": " << nwarmup << ", \"nrepeat\": " << nrepeat
+      << ", \"min\": " << t_min << ", \"median\": " << t_median
+      << ", \"mean\": " << t_mean << ", \"std\": " << t_std
+      << ", \"max\": " << t_max << ", \"seconds\": [";
+  for (Index i = 0; i < nrepeat; i++)
+    ofs << (i ? ", " : "") << seconds[i];
+  ofs << "]}\n";
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void Error(const String& msg, const Verbosity& verbosity) {
   CREATE_OUT0;
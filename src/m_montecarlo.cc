@@ -33,6 +33,7 @@
 #include <fstream>
 #include <stdexcept>
 #include "arts.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "lin_alg.h"
@@ -129,6 +130,8 @@ void MCGeneral(Workspace& ws,
                const Numeric& taustep_limit,
                const Index& l_mc_scat_order,
                const Index& t_interp_order,
+               const Index& optprop_cache,
+               const ArrayOfString& variance_reduction,
                const Verbosity& verbosity) {
   // Checks of input
   //
@@ -199,12 +202,28 @@ void MCGeneral(Workspace& ws,
     throw runtime_error(os.str());
   }
 
-  Ppath ppath_step;
-  Rng rng;  //Random Number generator
+  bool forced_collision = false;
+  bool phase_importance = false;
+  bool roulette = false;
+  for (const auto& vr : variance_reduction) {
+    if (vr == "forced_collision") {
+      forced_collision = true;
+    } else if (vr == "phase_importance") {
+      phase_importance = true;
+    } else if (vr == "roulette") {
+      roulette = true;
+    } else {
+      ostringstream os;
+      os << "Unknown variance reduction: " << vr << "\n"
+         << "Valid options are \"forced_collision\", \"phase_importance\" "
+         << "and \"roulette\".";
+      throw runtime_error(os.str());
+    }
+  }
+
   time_t start_time = time(NULL);
+  const clock_t start_clock = clock();
   Index N_se = pnd_field.nbooks();  //Number of scattering elements
-  Vector pnd_vec(
-      N_se);  //Vector of particle number densities used at each point
   Vector Z11maxvector(
       N_se);  //Vector holding the maximum phase function for each
 
@@ -219,19 +238,11 @@ void MCGeneral(Workspace& ws,
     }
   }
 
-  rng.seed(mc_seed, verbosity);
-  Numeric g, temperature, albedo, g_los_csc_theta;
-  Matrix A(stokes_dim, stokes_dim), Q(stokes_dim, stokes_dim);
-  Matrix evol_op(stokes_dim, stokes_dim), ext_mat_mono(stokes_dim, stokes_dim);
-  Matrix q(stokes_dim, stokes_dim), newQ(stokes_dim, stokes_dim);
-  Matrix Z(stokes_dim, stokes_dim);
-  Matrix R_ant2enu(3, 3),
-      R_stokes(stokes_dim, stokes_dim);  // Needed for antenna rotations
-  q = 0.0;
-  newQ = 0.0;
-  Vector vector1(stokes_dim), abs_vec_mono(stokes_dim), I_i(stokes_dim);
-  Vector Isum(stokes_dim), Isquaredsum(stokes_dim);
-  Index termination_flag = 0;
+  // Phase function moments for the importance sampling of directions
+  Vector Z11intvector, Z11cosvector;
+  if (phase_importance)
+    Z11_moments(Z11intvector, Z11cosvector, scat_data, f_index);
+
   const Numeric f_mono = f_grid[f_index];
   const Numeric prop_dir =
       -1.0;  // propagation direction opposite of los angles
@@ -250,17 +261,7 @@ void MCGeneral(Workspace& ws,
   mc_source_domain.resize(4);
   mc_source_domain = 0;
 
-  //local versions of workspace
-  Numeric local_surface_skin_t;
-  Matrix local_iy(1, stokes_dim), local_surface_emission(1, stokes_dim);
-  Matrix local_surface_los;
-  Tensor4 local_surface_rmatrix;
-  Vector local_rte_pos(3);  // Fixed this (changed from 2 to 3)
-  Vector local_rte_los(2);
-  Vector new_rte_los(2);
-  Index np;
-  Isum = 0.0;
-  Isquaredsum = 0.0;
+  Vector Isum(stokes_dim, 0.0), Isquaredsum(stokes_dim, 0.0);
   Numeric std_err_i;
   bool convert_to_rjbt = false;
   if (iy_unit == "RJBT") {
@@ -276,264 +277,562 @@ void MCGeneral(Workspace& ws,
     throw runtime_error(os.str());
   }
 
+  // Optical properties at the grid points, shared by all streams
+  MCOptPropCache optprop;
+  if (optprop_cache)
+    mc_optprop_cache_calc(ws,
+                          optprop,
+                          propmat_clearsky_agenda,
+                          stokes_dim,
+                          f_index,
+                          f_grid,
+                          p_grid,
+                          t_field,
+                          vmr_field,
+                          cloudbox_limits,
+                          pnd_field,
+                          scat_data);
+
   // Calculate rotation matrix for boresight
+  Matrix R_ant2enu(3, 3);
   rotmat_enu(R_ant2enu, sensor_los(0, joker));
 
-  //Begin Main Loop
-  //
-  bool keepgoing, oksampling;
-  Index nfails = 0;
-  //
-  while (true) {
-    // Complete content of while inside try/catch to handle occasional
-    // failures in the ppath calculations
-    try {
-      bool inside_cloud;
-
-      mc_iteration_count += 1;
-      Index scattering_order = 0;
-
-      keepgoing = true;   // indicating whether to continue tracing a photon
-      oksampling = true;  // gets false if g becomes zero
-
-      //Sample a FOV direction
-      Matrix R_prop(3, 3);
-      mc_antenna.draw_los(
-          local_rte_los, R_prop, rng, R_ant2enu, sensor_los(0, joker));
-
-      // Get stokes rotation matrix for rotating polarization
-      rotmat_stokes(
-          R_stokes, stokes_dim, prop_dir, prop_dir, R_prop, R_ant2enu);
-      id_mat(Q);
-      local_rte_pos = sensor_pos(0, joker);
-      I_i = 0.0;
-
-      while (keepgoing) {
-        mcPathTraceGeneral(ws,
-                           evol_op,
-                           abs_vec_mono,
-                           temperature,
-                           ext_mat_mono,
-                           rng,
-                           local_rte_pos,
-                           local_rte_los,
-                           pnd_vec,
-                           g,
-                           ppath_step,
-                           termination_flag,
-                           inside_cloud,
-                           ppath_step_agenda,
-                           ppath_lmax,
-                           ppath_lraytrace,
-                           taustep_limit,
-                           propmat_clearsky_agenda,
-                           stokes_dim,
-                           f_index,
-                           f_grid,
-                           p_grid,
-                           lat_grid,
-                           lon_grid,
-                           z_field,
-                           refellipsoid,
-                           z_surface,
-                           t_field,
-                           vmr_field,
-                           cloudbox_limits,
-                           pnd_field,
-                           scat_data,
-                           verbosity);
+  // The photons are traced in rounds. In each round, every stream traces
+  // its share of the photons with its own random number generator and
+  // accumulators. The streams are run in parallel and merged in stream
+  // order at the end of the round, where the stop criteria are checked on
+  // the merged statistics. For a given seed and number of threads the
+  // result is thus reproducible.
+  struct PhotonStream {
+    Rng rng;
+    Index count;
+    Index nfails;
+    Vector Isum;
+    Vector Isquaredsum;
+    Tensor3 points;
+    ArrayOfIndex scat_order;
+    ArrayOfIndex source_domain;
+    // Forced collisions are still applied, see trans_min
+    bool force_collision;
+  };
+
+  const Index nstreams =
+      arts_omp_in_parallel() ? 1 : arts_omp_get_max_threads();
+  Array<PhotonStream> streams(nstreams);
+
+  streams[0].rng.seed(mc_seed, verbosity);
+  for (Index s = 1; s < nstreams; s++)
+    streams[s].rng.seed_stream(streams[0].rng.showseed(), s);
+  for (auto& stream : streams) stream.force_collision = forced_collision;
+
+  // Forced collisions only pay off if a substantial part of the photons
+  // reaches the boundary without collision. The path without collision
+  // is only traced while the transmission is above this limit. If it
+  // drops below, the photon is traced as usual and the stream stops
+  // forcing collisions, as the scene is too thick for them.
+  const Numeric trans_min = 0.1;
+
+  // Trace photons until nphotons are counted, the time is up or the
+  // number of failures gets too high
+  auto trace_photons = [&](Workspace& l_ws,
+                           PhotonStream& stream,
+                           const Index nphotons) {
+    Rng& rng = stream.rng;
+    Ppath ppath_step;
+    Vector pnd_vec(
+        N_se);  //Vector of particle number densities used at each point
+    Numeric g, temperature, albedo, g_los_csc_theta;
+    Matrix Q(stokes_dim, stokes_dim);
+    Matrix evol_op(stokes_dim, stokes_dim),
+        ext_mat_mono(stokes_dim, stokes_dim);
+    Matrix q(stokes_dim, stokes_dim), newQ(stokes_dim, stokes_dim);
+    Matrix Z(stokes_dim, stokes_dim);
+    Matrix R_stokes(stokes_dim, stokes_dim);  // Needed for antenna rotations
+    q = 0.0;
+    newQ = 0.0;
+    Vector vector1(stokes_dim), abs_vec_mono(stokes_dim), I_i(stokes_dim);
+    Index termination_flag = 0;
+
+    //local versions of workspace
+    Numeric local_surface_skin_t;
+    Matrix local_iy(1, stokes_dim), local_surface_emission(1, stokes_dim);
+    Matrix local_surface_los;
+    Tensor4 local_surface_rmatrix;
+    Vector local_rte_pos(3);  // Fixed this (changed from 2 to 3)
+    Vector local_rte_los(2);
+    Vector new_rte_los(2);
+    Index np;
+
+    // Parts of a photon still to be traced. They are only created by
+    // forced collisions and splitting.
+    struct PhotonBranch {
+      Vector rte_pos;
+      Vector rte_los;
+      Matrix Q;
+      Index scattering_order;
+      Numeric r_forced;
+    };
+    std::vector<PhotonBranch> branches;
+    Vector I_photon(stokes_dim);
+
+    // Russian roulette for photons with a low weight, splitting for
+    // photons with a high weight. The expected weight is kept, so the
+    // result stays unbiased.
+    const Numeric weight_low = 0.25;
+    const Numeric weight_high = 4;
+    const Index max_split = 16;
+    auto roulette_and_split = [&](const Index scattering_order,
+                                  bool& keep) {
+      const Numeric w = Q(0, 0);
+      if (w < weight_low) {
+        if (rng.draw() < w) {
+          Q /= w;
+        } else {
+          keep = false;
+        }
+      } else if (w > weight_high) {
+        const Index nsplit = min((Index)ceil(w), max_split);
+        Q /= (Numeric)nsplit;
+        for (Index i = 1; i < nsplit; i++)
+          branches.push_back(
+              {local_rte_pos, local_rte_los, Q, scattering_order, -1});
+      }
+    };
+
+    bool keepgoing, oksampling;
+    //
+    while (stream.count < nphotons) {
+      if (max_time > 0 && (Index)(time(NULL) - start_time) >= max_time) break;
+
+      // Complete content of while inside try/catch to handle occasional
+      // failures in the ppath calculations
+      try {
+        bool inside_cloud;
+
+        stream.count += 1;
+        Index scattering_order = 0;
+        bool first_path = true;  // no collision yet
+        Numeric r_forced = -1;   // draw end point of path
+
+        keepgoing = true;   // indicating whether to continue tracing a photon
+        oksampling = true;  // gets false if g becomes zero
+        branches.clear();
+
+        //Sample a FOV direction
+        Matrix R_prop(3, 3);
+        mc_antenna.draw_los(
+            local_rte_los, R_prop, rng, R_ant2enu, sensor_los(0, joker));
+
+        // Get stokes rotation matrix for rotating polarization
+        rotmat_stokes(
+            R_stokes, stokes_dim, prop_dir, prop_dir, R_prop, R_ant2enu);
+        id_mat(Q);
+        local_rte_pos = sensor_pos(0, joker);
+        I_i = 0.0;
+        I_photon = 0.0;
+
+        // Trace the photon and the branches split off from it
+        while (true) {
+          while (keepgoing) {
+            // Forced first collision: the photon is split into the part
+            // reaching the boundary without collision and the part colliding
+            // before. The end point of the latter is drawn from the remaining
+            // range of the transmission.
+            if (stream.force_collision && first_path) {
+              first_path = false;
+              const Vector start_pos = local_rte_pos;
+              const Vector start_los = local_rte_los;
+              mcPathTraceGeneral(l_ws,
+                                 evol_op,
+                                 abs_vec_mono,
+                                 temperature,
+                                 ext_mat_mono,
+                                 rng,
+                                 local_rte_pos,
+                                 local_rte_los,
+                                 pnd_vec,
+                                 g,
+                                 ppath_step,
+                                 termination_flag,
+                                 inside_cloud,
+                                 ppath_step_agenda,
+                                 ppath_lmax,
+                                 ppath_lraytrace,
+                                 taustep_limit,
+                                 propmat_clearsky_agenda,
+                                 stokes_dim,
+                                 f_index,
+                                 f_grid,
+                                 p_grid,
+                                 lat_grid,
+                                 lon_grid,
+                                 z_field,
+                                 refellipsoid,
+                                 z_surface,
+                                 t_field,
+                                 vmr_field,
+                                 cloudbox_limits,
+                                 pnd_field,
+                                 scat_data,
+                                 verbosity,
+                                 optprop_cache ? &optprop : nullptr,
+                                 trans_min);
+
+              // Transmission to the boundary below trans_min, trace this
+              // photon as usual from the start
+              if (!termination_flag) {
+                stream.force_collision = false;
+                local_rte_pos = start_pos;
+                local_rte_los = start_los;
+                continue;
+              }
 
-        // GH 2011-09-08: if the lowest layer has large
-        // extent and a thick cloud, g may be 0 due to
-        // underflow, but then I_i should be 0 as well.
-        // Don't turn it into nan for no reason.
-        // If reaching underflow, no point in going on;
-        // hence new photon.
-        // GH 2011-09-14: moved this check to outside the different
-        // scenarios, as this goes wrong regardless of the scenario.
-        if (g == 0) {
-          keepgoing = false;
-          oksampling = false;
-          mc_iteration_count -= 1;
-          out0 << "WARNING: A rejected path sampling (g=0)!\n(if this"
-               << "happens repeatedly, try to decrease *ppath_lmax*)";
-        } else if (termination_flag == 1) {
-          iy_space_agendaExecute(ws,
-                                 local_iy,
-                                 Vector(1, f_mono),
+              const Numeric trans = g;
+              if (trans < 1) {
+                Matrix Q_collided = Q;
+                Q_collided *= 1 - trans;
+                branches.push_back({start_pos,
+                                    start_los,
+                                    Q_collided,
+                                    scattering_order,
+                                    trans + (1 - trans) * rng.draw()});
+              }
+              g = 1;
+            } else {
+              mcPathTraceGeneral(l_ws,
+                                 evol_op,
+                                 abs_vec_mono,
+                                 temperature,
+                                 ext_mat_mono,
+                                 rng,
                                  local_rte_pos,
                                  local_rte_los,
-                                 iy_space_agenda);
-          mult(vector1, evol_op, local_iy(0, joker));
-          mult(I_i, Q, vector1);
-          I_i /= g;
-          keepgoing = false;  //stop here. New photon.
-          mc_source_domain[0] += 1;
-        } else if (termination_flag == 2) {
-          //Calculate surface properties
-          surface_rtprop_agendaExecute(ws,
-                                       local_surface_skin_t,
-                                       local_surface_emission,
-                                       local_surface_los,
-                                       local_surface_rmatrix,
-                                       Vector(1, f_mono),
-                                       local_rte_pos,
-                                       local_rte_los,
-                                       surface_rtprop_agenda);
-
-          //if( local_surface_los.nrows() > 1 )
-          // throw runtime_error(
-          //                "The method handles only specular reflections." );
-
-          //deal with blackbody case
-          if (local_surface_los.empty()) {
-            mult(vector1, evol_op, local_surface_emission(0, joker));
-            mult(I_i, Q, vector1);
-            I_i /= g;
-            keepgoing = false;
-            mc_source_domain[1] += 1;
-          } else
-          //decide between reflection and emission
-          {
-            const Numeric rnd = rng.draw();
-
-            Numeric R11 = 0;
-            for (Index i = 0; i < local_surface_rmatrix.nbooks(); i++) {
-              R11 += local_surface_rmatrix(i, 0, 0, 0);
+                                 pnd_vec,
+                                 g,
+                                 ppath_step,
+                                 termination_flag,
+                                 inside_cloud,
+                                 ppath_step_agenda,
+                                 ppath_lmax,
+                                 ppath_lraytrace,
+                                 taustep_limit,
+                                 propmat_clearsky_agenda,
+                                 stokes_dim,
+                                 f_index,
+                                 f_grid,
+                                 p_grid,
+                                 lat_grid,
+                                 lon_grid,
+                                 z_field,
+                                 refellipsoid,
+                                 z_surface,
+                                 t_field,
+                                 vmr_field,
+                                 cloudbox_limits,
+                                 pnd_field,
+                                 scat_data,
+                                 verbosity,
+                                 optprop_cache ? &optprop : nullptr,
+                                 r_forced);
+              r_forced = -1;
             }
 
-            if (rnd > R11) {
-              //then we have emission
-              mult(vector1, evol_op, local_surface_emission(0, joker));
-              mult(I_i, Q, vector1);
-              I_i /= g * (1 - R11);
+            // GH 2011-09-08: if the lowest layer has large
+            // extent and a thick cloud, g may be 0 due to
+            // underflow, but then I_i should be 0 as well.
+            // Don't turn it into nan for no reason.
+            // If reaching underflow, no point in going on;
+            // hence new photon.
+            // GH 2011-09-14: moved this check to outside the different
+            // scenarios, as this goes wrong regardless of the scenario.
+            if (g == 0) {
               keepgoing = false;
-              mc_source_domain[1] += 1;
-            } else {
-              //we have reflection
-              // determine which reflection los to use
-              Index i = 0;
-              Numeric rsum = local_surface_rmatrix(i, 0, 0, 0);
-              while (rsum < rnd) {
-                i++;
-                rsum += local_surface_rmatrix(i, 0, 0, 0);
+              oksampling = false;
+              stream.count -= 1;
+              out0 << "WARNING: A rejected path sampling (g=0)!\n(if this"
+                   << "happens repeatedly, try to decrease *ppath_lmax*)";
+            } else if (termination_flag == 1) {
+              iy_space_agendaExecute(l_ws,
+                                     local_iy,
+                                     Vector(1, f_mono),
+                                     local_rte_pos,
+                                     local_rte_los,
+                                     iy_space_agenda);
+              mult(vector1, evol_op, local_iy(0, joker));
+              mult(I_i, Q, vector1);
+              I_i /= g;
+              keepgoing = false;  //stop here. New photon.
+              stream.source_domain[0] += 1;
+            } else if (termination_flag == 2) {
+              //Calculate surface properties
+              surface_rtprop_agendaExecute(l_ws,
+                                           local_surface_skin_t,
+                                           local_surface_emission,
+                                           local_surface_los,
+                                           local_surface_rmatrix,
+                                           Vector(1, f_mono),
+                                           local_rte_pos,
+                                           local_rte_los,
+                                           surface_rtprop_agenda);
+
+              //if( local_surface_los.nrows() > 1 )
+              // throw runtime_error(
+              //                "The method handles only specular reflections." );
+
+              //deal with blackbody case
+              if (local_surface_los.empty()) {
+                mult(vector1, evol_op, local_surface_emission(0, joker));
+                mult(I_i, Q, vector1);
+                I_i /= g;
+                keepgoing = false;
+                stream.source_domain[1] += 1;
+              } else
+              //decide between reflection and emission
+              {
+                const Numeric rnd = rng.draw();
+
+                Numeric R11 = 0;
+                for (Index i = 0; i < local_surface_rmatrix.nbooks(); i++) {
+                  R11 += local_surface_rmatrix(i, 0, 0, 0);
+                }
+
+                if (rnd > R11) {
+                  //then we have emission
+                  mult(vector1, evol_op, local_surface_emission(0, joker));
+                  mult(I_i, Q, vector1);
+                  I_i /= g * (1 - R11);
+                  keepgoing = false;
+                  stream.source_domain[1] += 1;
+                } else {
+                  //we have reflection
+                  // determine which reflection los to use
+                  Index i = 0;
+                  Numeric rsum = local_surface_rmatrix(i, 0, 0, 0);
+                  while (rsum < rnd) {
+                    i++;
+                    rsum += local_surface_rmatrix(i, 0, 0, 0);
+                  }
+
+                  local_rte_los = local_surface_los(i, joker);
+
+                  mult(q, evol_op, local_surface_rmatrix(i, 0, joker, joker));
+                  mult(newQ, Q, q);
+                  Q = newQ;
+                  Q /= g * local_surface_rmatrix(i, 0, 0, 0);
+                  if (roulette) roulette_and_split(scattering_order, keepgoing);
+                }
               }
+            } else if (inside_cloud) {
+              //we have another scattering/emission point
+              //Estimate single scattering albedo
+              albedo = 1 - abs_vec_mono[0] / ext_mat_mono(0, 0);
+
+              //determine whether photon is emitted or scattered
+              if (rng.draw() > albedo) {
+                //Calculate emission
+                Numeric planck_value = planck(f_mono, temperature);
+                Vector emission = abs_vec_mono;
+                emission *= planck_value;
+                Vector emissioncontri(stokes_dim);
+                mult(emissioncontri, evol_op, emission);
+                emissioncontri /= (g * (1 - albedo));  //yuck!
+                mult(I_i, Q, emissioncontri);
+                keepgoing = false;
+                stream.source_domain[3] += 1;
+              } else {
+                //we have a scattering event
+                if (phase_importance) {
+                  Sample_los_importance(new_rte_los,
+                                        g_los_csc_theta,
+                                        Z,
+                                        rng,
+                                        local_rte_los,
+                                        scat_data,
+                                        f_index,
+                                        stokes_dim,
+                                        pnd_vec,
+                                        Z11intvector,
+                                        Z11cosvector,
+                                        temperature,
+                                        t_interp_order);
+                } else {
+                  Sample_los(new_rte_los,
+                             g_los_csc_theta,
+                             Z,
+                             rng,
+                             local_rte_los,
+                             scat_data,
+                             f_index,
+                             stokes_dim,
+                             pnd_vec,
+                             Z11maxvector,
+                             ext_mat_mono(0, 0) - abs_vec_mono[0],
+                             temperature,
+                             t_interp_order);
+                }
 
-              local_rte_los = local_surface_los(i, joker);
+                Z /= g * g_los_csc_theta * albedo;
 
-              mult(q, evol_op, local_surface_rmatrix(i, 0, joker, joker));
-              mult(newQ, Q, q);
-              Q = newQ;
-              Q /= g * local_surface_rmatrix(i, 0, 0, 0);
+                mult(q, evol_op, Z);
+                mult(newQ, Q, q);
+                Q = newQ;
+                scattering_order += 1;
+                local_rte_los = new_rte_los;
+                if (roulette) roulette_and_split(scattering_order, keepgoing);
+              }
+            } else {
+              //Must be clear sky emission point
+              //Calculate emission
+              Numeric planck_value = planck(f_mono, temperature);
+              Vector emission = abs_vec_mono;
+              emission *= planck_value;
+              Vector emissioncontri(stokes_dim);
+              mult(emissioncontri, evol_op, emission);
+              emissioncontri /= g;
+              mult(I_i, Q, emissioncontri);
+              keepgoing = false;
+              stream.source_domain[2] += 1;
             }
+          }  // keepgoing
+
+          if (!oksampling) break;
+
+          // Set spome of the bookkeeping variables
+          np = ppath_step.np;
+          stream.points(ppath_step.gp_p[np - 1].idx,
+                        ppath_step.gp_lat[np - 1].idx,
+                        ppath_step.gp_lon[np - 1].idx) += 1;
+          if (scattering_order < l_mc_scat_order) {
+            stream.scat_order[scattering_order] += 1;
           }
-        } else if (inside_cloud) {
-          //we have another scattering/emission point
-          //Estimate single scattering albedo
-          albedo = 1 - abs_vec_mono[0] / ext_mat_mono(0, 0);
-
-          //determine whether photon is emitted or scattered
-          if (rng.draw() > albedo) {
-            //Calculate emission
-            Numeric planck_value = planck(f_mono, temperature);
-            Vector emission = abs_vec_mono;
-            emission *= planck_value;
-            Vector emissioncontri(stokes_dim);
-            mult(emissioncontri, evol_op, emission);
-            emissioncontri /= (g * (1 - albedo));  //yuck!
-            mult(I_i, Q, emissioncontri);
-            keepgoing = false;
-            mc_source_domain[3] += 1;
-          } else {
-            //we have a scattering event
-            Sample_los(new_rte_los,
-                       g_los_csc_theta,
-                       Z,
-                       rng,
-                       local_rte_los,
-                       scat_data,
-                       f_index,
-                       stokes_dim,
-                       pnd_vec,
-                       Z11maxvector,
-                       ext_mat_mono(0, 0) - abs_vec_mono[0],
-                       temperature,
-                       t_interp_order);
-
-            Z /= g * g_los_csc_theta * albedo;
-
-            mult(q, evol_op, Z);
-            mult(newQ, Q, q);
-            Q = newQ;
-            scattering_order += 1;
-            local_rte_los = new_rte_los;
+          I_photon += I_i;
+
+          if (branches.empty()) break;
+
+          local_rte_pos = branches.back().rte_pos;
+          local_rte_los = branches.back().rte_los;
+          Q = branches.back().Q;
+          scattering_order = branches.back().scattering_order;
+          r_forced = branches.back().r_forced;
+          branches.pop_back();
+          I_i = 0.0;
+          keepgoing = true;
+        }  // branches
+
+        if (oksampling) {
+          // Rotate into antenna polarization frame
+          Vector I_hold(stokes_dim);
+          mult(I_hold, R_stokes, I_photon);
+          stream.Isum += I_photon;
+
+          for (Index j = 0; j < stokes_dim; j++) {
+            ARTS_ASSERT(!std::isnan(I_photon[j]));
+            stream.Isquaredsum[j] += I_photon[j] * I_photon[j];
           }
-        } else {
-          //Must be clear sky emission point
-          //Calculate emission
-          Numeric planck_value = planck(f_mono, temperature);
-          Vector emission = abs_vec_mono;
-          emission *= planck_value;
-          Vector emissioncontri(stokes_dim);
-          mult(emissioncontri, evol_op, emission);
-          emissioncontri /= g;
-          mult(I_i, Q, emissioncontri);
-          keepgoing = false;
-          mc_source_domain[2] += 1;
-        }
-      }  // keepgoing
-
-      if (oksampling) {
-        // Set spome of the bookkeeping variables
-        np = ppath_step.np;
-        mc_points(ppath_step.gp_p[np - 1].idx,
-                  ppath_step.gp_lat[np - 1].idx,
-                  ppath_step.gp_lon[np - 1].idx) += 1;
-        if (scattering_order < l_mc_scat_order) {
-          mc_scat_order[scattering_order] += 1;
         }
+      }  // Try
+
+      catch (const std::runtime_error& e) {
+        stream.count += 1;
+        stream.nfails += 1;
+        ostringstream os;
+        os << "WARNING: A MC path sampling failed! Error was:\n"
+           << e.what() << "\n";
+        out0 << os.str();
+        // The limit applies to all streams together, see below
+        if (stream.nfails >= 5) break;
+      }
+    }  // while
+  };
 
-        // Rotate into antenna polarization frame
-        Vector I_hold(stokes_dim);
-        mult(I_hold, R_stokes, I_i);
-        Isum += I_i;
-
-        for (Index j = 0; j < stokes_dim; j++) {
-          ARTS_ASSERT(!std::isnan(I_i[j]));
-          Isquaredsum[j] += I_i[j] * I_i[j];
-        }
-        y = Isum;
-        y /= (Numeric)mc_iteration_count;
-        for (Index j = 0; j < stokes_dim; j++) {
-          mc_error[j] = sqrt(
-              (Isquaredsum[j] / (Numeric)mc_iteration_count - y[j] * y[j]) /
-              (Numeric)mc_iteration_count);
-        }
-        if (std_err > 0 && mc_iteration_count >= min_iter &&
-            mc_error[0] < std_err_i) {
-          break;
-        }
-        if (max_time > 0 && (Index)(time(NULL) - start_time) >= max_time) {
-          break;
-        }
-        if (max_iter > 0 && mc_iteration_count >= max_iter) {
-          break;
+  //Begin Main Loop
+  //
+  Index nfails = 0;
+  String fail_msg;
+  bool failed = false;
+  //
+  while (true) {
+    // Photons of this round, at least mc_min_iter in total before the
+    // error is checked and then a tenth of the photons so far. The streams
+    // are synchronized at the end of every round, so rounds must not be
+    // too short.
+    Index nround = max(min_iter - mc_iteration_count,
+                       max(nstreams, mc_iteration_count / 10));
+    if (max_iter > 0) nround = min(nround, max_iter - mc_iteration_count);
+
+#pragma omp parallel for schedule(static, 1) if (nstreams > 1)
+    for (Index s = 0; s < nstreams; s++) {
+      PhotonStream& stream = streams[s];
+      stream.count = 0;
+      stream.nfails = 0;
+      stream.Isum.resize(stokes_dim);
+      stream.Isum = 0.0;
+      stream.Isquaredsum.resize(stokes_dim);
+      stream.Isquaredsum = 0.0;
+      stream.points.resize(
+          p_grid.nelem(), lat_grid.nelem(), lon_grid.nelem());
+      stream.points = 0;
+      stream.scat_order.resize(l_mc_scat_order);
+      stream.scat_order = 0;
+      stream.source_domain.resize(4);
+      stream.source_domain = 0;
+
+      try {
+        // Each stream needs its own copy of the workspace
+        PooledWorkspace l_ws(ws);
+        trace_photons(*l_ws,
+                      stream,
+                      nround / nstreams + (s < nround % nstreams ? 1 : 0));
+      } catch (const std::exception& e) {
+#pragma omp critical(MCGeneral_fail)
+        {
+          fail_msg = e.what();
+          failed = true;
         }
       }
-    }  // Try
-
-    catch (const std::runtime_error& e) {
-      mc_iteration_count += 1;
-      nfails += 1;
-      out0 << "WARNING: A MC path sampling failed! Error was:\n";
-      cout << e.what() << endl;
-      if (nfails >= 5) {
-        throw runtime_error(
-            "The MC path sampling has failed five times. A few failures "
-            "should be OK, but this number is suspiciously high and the "
-            "reason to these failures should be tracked down.");
+    }
+
+    if (failed) throw runtime_error(fail_msg);
+
+    // Merge the streams
+    for (const auto& stream : streams) {
+      mc_iteration_count += stream.count;
+      nfails += stream.nfails;
+      Isum += stream.Isum;
+      Isquaredsum += stream.Isquaredsum;
+      mc_points += stream.points;
+      for (Index i = 0; i < l_mc_scat_order; i++)
+        mc_scat_order[i] += stream.scat_order[i];
+      for (Index i = 0; i < 4; i++)
+        mc_source_domain[i] += stream.source_domain[i];
+    }
+
+    if (nfails >= 5) {
+      throw runtime_error(
+          "The MC path sampling has failed five times. A few failures "
+          "should be OK, but this number is suspiciously high and the "
+          "reason to these failures should be tracked down.");
+    }
+
+    if (mc_iteration_count) {
+      y = Isum;
+      y /= (Numeric)mc_iteration_count;
+      for (Index j = 0; j < stokes_dim; j++) {
+        mc_error[j] = sqrt(
+            (Isquaredsum[j] / (Numeric)mc_iteration_count - y[j] * y[j]) /
+            (Numeric)mc_iteration_count);
       }
     }
+    if (std_err > 0 && mc_iteration_count >= min_iter &&
+        mc_error[0] < std_err_i) {
+      break;
+    }
+    if (max_time > 0 && (Index)(time(NULL) - start_time) >= max_time) {
+      break;
+    }
+    if (max_iter > 0 && mc_iteration_count >= max_iter) {
+      break;
+    }
   }  // while
 
   if (convert_to_rjbt) {
@@ -542,6 +841,19 @@ void MCGeneral(Workspace& ws,
       mc_error[j] = invrayjean(mc_error[j], f_mono);
     }
   }
+
+  // Efficiency of the calculation, to compare variance reduction options
+  CREATE_OUT1;
+  const Numeric cpu_time = (Numeric)(clock() - start_clock) / CLOCKS_PER_SEC;
+  out1 << "  MCGeneral: " << mc_iteration_count << " photons, error "
+       << mc_error[0] << ", " << cpu_time << " CPU seconds";
+  if (mc_error[0] > 0 && cpu_time > 0)
+    out1 << ", figure of merit 1/(error^2*CPU time) "
+         << 1 / (mc_error[0] * mc_error[0] * cpu_time);
+  out1 << "\n  Variance reduction:";
+  if (variance_reduction.empty()) out1 << " none";
+  for (const auto& vr : variance_reduction) out1 << " " << vr;
+  out1 << "\n";
 }
 
 
@@ -671,49 +983,11 @@ void MCRadar(  // Workspace reference:
         "Gaussian antenna patterns.");
   }
 
-  Ppath ppath_step;
-  Rng rng;                          //Random Number generator
   Index N_se = pnd_field.nbooks();  //Number of scattering elements
-  Vector pnd_vec(
-      N_se);  //Vector of particle number densities used at each point
   bool anyptype_nonTotRan = is_anyptype_nonTotRan(scat_data);
   bool is_dist = max(range_bins) > 1;  // Is it round trip time or distance
-  rng.seed(mc_seed, verbosity);
-  Numeric ppath_lraytrace_var;
-  //Numeric temperature, albedo;
-  Numeric albedo;
-  Numeric Csca, Cext;
-  Numeric antenna_wgt;
-  Matrix evol_op(stokes_dim, stokes_dim), ext_mat_mono(stokes_dim, stokes_dim);
-  Matrix trans_mat(stokes_dim, stokes_dim);
-  Matrix Z(stokes_dim, stokes_dim);
-  Matrix R_ant2enu(3, 3), R_enu2ant(3, 3), R_stokes(stokes_dim, stokes_dim);
-  Vector abs_vec_mono(stokes_dim), I_i(stokes_dim), I_i_rot(stokes_dim);
-  Vector Isum(nbins * stokes_dim), Isquaredsum(nbins * stokes_dim);
-  Index termination_flag = 0;
+  Matrix R_ant2enu(3, 3), R_enu2ant(3, 3);
   Vector bin_height(nbins);
-  Vector range_bin_count(nbins);
-  Index mc_iter;
-  Index scat_order;
-
-  // allocating variables needed for pha_mat extraction (don't want to do this
-  // in every loop step again).
-  ArrayOfArrayOfTensor6 pha_mat_Nse;
-  ArrayOfArrayOfIndex ptypes_Nse;
-  Matrix t_ok;
-  ArrayOfTensor6 pha_mat_ssbulk;
-  ArrayOfIndex ptype_ssbulk;
-  Tensor6 pha_mat_bulk;
-  Index ptype_bulk;
-  Matrix pdir_array(1, 2), idir_array(1, 2);
-  Vector t_array(1);
-  Matrix pnds(N_se, 1);
-
-  // for pha_mat handling, at the moment we still need scat_data_mono. Hence,
-  // extract that here (but in its local container, not into the WSV
-  // scat_data_mono).
-  //ArrayOfArrayOfSingleScatteringData this_scat_data_mono;
-  //scat_data_monoExtract( this_scat_data_mono, scat_data, f_index, verbosity );
 
   const Numeric f_mono = f_grid[f_index];
   const Numeric tx_dir = 1.0;
@@ -729,26 +1003,9 @@ void MCRadar(  // Workspace reference:
   y.resize(nbins * stokes_dim);
   y = 0;
 
-  range_bin_count = 0;
-
-  mc_iter = 0;
   // this will need to be reshaped differently for range gates
   mc_error.resize(stokes_dim * nbins);
 
-  //local versions of workspace
-  Matrix local_iy(1, stokes_dim), local_surface_emission(1, stokes_dim);
-  Matrix local_surface_los;
-  Tensor4 local_surface_rmatrix;
-  Vector local_rte_pos(3);
-  Vector local_rte_los(2);
-  Vector new_rte_los(2);
-  Vector Ipath(stokes_dim), Ihold(stokes_dim), Ipath_norm(stokes_dim);
-  Isum = 0.0;
-  Isquaredsum = 0.0;
-  Numeric s_tot, s_return;  // photon distance traveled
-  Numeric t_tot, t_return;  // photon time traveled
-  Numeric r_trav, r_bin;  // range traveled (1-way distance) or round-trip time
-
   Numeric fac;
   if (iy_unit_radar == "1") {
     fac = 1.0;
@@ -770,311 +1027,414 @@ void MCRadar(  // Workspace reference:
   rotmat_enu(R_ant2enu, sensor_los(0, joker));
   R_enu2ant = transpose(R_ant2enu);
 
-  //Begin Main Loop
-  bool keepgoing, firstpass, integrity;
-  while (mc_iter < mc_max_iter) {
-    bool inside_cloud;
-
-    mc_iter += 1;
-
-    integrity = true;  // intensity is not nan or below threshold
-    keepgoing = true;  // indicating whether to continue tracing a photon
-    firstpass = true;  // ensure backscatter is properly calculated
-
-    //Sample a FOV direction
-    Matrix R_tx(3, 3);
-    mc_antenna.draw_los(
-        local_rte_los, R_tx, rng, R_ant2enu, sensor_los(0, joker));
-    rotmat_stokes(R_stokes, stokes_dim, tx_dir, tx_dir, R_ant2enu, R_tx);
-    mult(Ihold, R_stokes, mc_y_tx);
-
-    // Initialize other variables
-    local_rte_pos = sensor_pos(0, joker);
-    s_tot = 0.0;
-    t_tot = 0.0;
-    scat_order = 0;
-    while (keepgoing) {
-      Numeric s_path, t_path;
-
-      mcPathTraceRadar(ws,
-                       evol_op,
-                       abs_vec_mono,
-                       t_array[0],
-                       ext_mat_mono,
-                       rng,
-                       local_rte_pos,
-                       local_rte_los,
-                       pnd_vec,  //pnds(joker,0),
-                       s_path,
-                       t_path,
-                       ppath_step,
-                       termination_flag,
-                       inside_cloud,
-                       ppath_step_agenda,
-                       ppath_lmax,
-                       ppath_lraytrace,
-                       propmat_clearsky_agenda,
-                       anyptype_nonTotRan,
-                       stokes_dim,
-                       f_index,
-                       f_grid,
-                       Ihold,
-                       p_grid,
-                       lat_grid,
-                       lon_grid,
-                       z_field,
-                       refellipsoid,
-                       z_surface,
-                       t_field,
-                       vmr_field,
-                       cloudbox_limits,
-                       pnd_field,
-                       scat_data,
-                       verbosity);
-      pnds(joker, 0) = pnd_vec;
-      if (!inside_cloud || termination_flag != 0) {
-        keepgoing = false;
-      } else {
-        s_tot += s_path;
-        t_tot += t_path;
-
-        //
-        Csca = ext_mat_mono(0, 0) - abs_vec_mono[0];
-        Cext = ext_mat_mono(0, 0);
-        if (anyptype_nonTotRan) {
-          const Numeric Irat = Ihold[1] / Ihold[0];
-          Csca += Irat * (ext_mat_mono(1, 0) - abs_vec_mono[1]);
-          Cext += Irat * ext_mat_mono(0, 1);
-        }
-        albedo = Csca / Cext;
+  // The photons are split over streams with their own random number
+  // generator and accumulators, as in MCGeneral. The streams are merged in
+  // stream order, so that the result is reproducible for a given seed and
+  // number of threads.
+  struct PhotonStream {
+    Rng rng;
+    Vector Isum;
+    Vector Isquaredsum;
+    Vector range_bin_count;
+  };
+
+  const Index nstreams =
+      arts_omp_in_parallel() ? 1 : arts_omp_get_max_threads();
+  Array<PhotonStream> streams(nstreams);
+
+  streams[0].rng.seed(mc_seed, verbosity);
+  for (Index s = 1; s < nstreams; s++)
+    streams[s].rng.seed_stream(streams[0].rng.showseed(), s);
+
+  auto trace_photons = [&](Workspace& l_ws,
+                           PhotonStream& stream,
+                           const Index nphotons) {
+    Rng& rng = stream.rng;
+    Ppath ppath_step;
+    Vector pnd_vec(
+        N_se);  //Vector of particle number densities used at each point
+    Numeric ppath_lraytrace_var;
+    Numeric albedo;
+    Numeric Csca, Cext;
+    Numeric antenna_wgt;
+    Matrix evol_op(stokes_dim, stokes_dim),
+        ext_mat_mono(stokes_dim, stokes_dim);
+    Matrix trans_mat(stokes_dim, stokes_dim);
+    Matrix Z(stokes_dim, stokes_dim);
+    Matrix R_stokes(stokes_dim, stokes_dim);
+    Vector abs_vec_mono(stokes_dim), I_i(stokes_dim), I_i_rot(stokes_dim);
+    Index termination_flag = 0;
+    Index scat_order;
+
+    // allocating variables needed for pha_mat extraction (don't want to do
+    // this in every loop step again).
+    ArrayOfArrayOfTensor6 pha_mat_Nse;
+    ArrayOfArrayOfIndex ptypes_Nse;
+    Matrix t_ok;
+    ArrayOfTensor6 pha_mat_ssbulk;
+    ArrayOfIndex ptype_ssbulk;
+    Tensor6 pha_mat_bulk;
+    Index ptype_bulk;
+    Matrix pdir_array(1, 2), idir_array(1, 2);
+    Vector t_array(1);
+    Matrix pnds(N_se, 1);
+
+    //local versions of workspace
+    Vector local_rte_pos(3);
+    Vector local_rte_los(2);
+    Vector new_rte_los(2);
+    Vector Ipath(stokes_dim), Ihold(stokes_dim);
+    Numeric s_tot, s_return;  // photon distance traveled
+    Numeric t_tot, t_return;  // photon time traveled
+    Numeric r_trav,
+        r_bin;  // range traveled (1-way distance) or round-trip time
+
+    bool keepgoing, firstpass, integrity;
+    for (Index iphoton = 0; iphoton < nphotons; iphoton++) {
+      bool inside_cloud;
 
-        // Terminate if absorption event, outside cloud, or surface
-        Numeric rn = rng.draw();
-        if (rn > albedo) {
-          keepgoing = false;
-          continue;
-        }
+      integrity = true;  // intensity is not nan or below threshold
+      keepgoing = true;  // indicating whether to continue tracing a photon
+      firstpass = true;  // ensure backscatter is properly calculated
 
-        Vector rte_los_geom(2);
-
-        // Compute reflectivity contribution based on local-to-sensor
-        // geometry, path attenuation
-        // Get los angles at atmospheric locale to determine
-        // scattering angle
-        if (firstpass) {
-          // Use this to ensure that the difference in azimuth angle
-          // between incident and scattered lines-of-sight is 180
-          // degrees
-          mirror_los(rte_los_geom, local_rte_los, atmosphere_dim);
-          firstpass = false;
-        } else {
-          // Replace with ppath_agendaExecute??
-          rte_losGeometricFromRtePosToRtePos2(rte_los_geom,
-                                              atmosphere_dim,
-                                              lat_grid,
-                                              lon_grid,
-                                              refellipsoid,
-                                              local_rte_pos,
-                                              sensor_pos(0, joker),
-                                              verbosity);
-        }
+      //Sample a FOV direction
+      Matrix R_tx(3, 3);
+      mc_antenna.draw_los(
+          local_rte_los, R_tx, rng, R_ant2enu, sensor_los(0, joker));
+      rotmat_stokes(R_stokes, stokes_dim, tx_dir, tx_dir, R_ant2enu, R_tx);
+      mult(Ihold, R_stokes, mc_y_tx);
 
-        // Get los angles at sensor to determine antenna pattern
-        // weighting of return signal and ppath to determine
-        // propagation path back to sensor
-        // Replace with ppath_agendaExecute??
-        Ppath ppath;
-        Vector rte_los_antenna(2);
-        ppath_lraytrace_var = ppath_lraytrace;
-        Numeric za_accuracy = 2e-5;
-        Numeric pplrt_factor = 5;
-        Numeric pplrt_lowest = 0.5;
-
-        rte_losGeometricFromRtePosToRtePos2(rte_los_antenna,
-                                            atmosphere_dim,
-                                            lat_grid,
-                                            lon_grid,
-                                            refellipsoid,
-                                            sensor_pos(0, joker),
-                                            local_rte_pos,
-                                            verbosity);
-
-        ppathFromRtePos2(ws,
-                         ppath,
-                         rte_los_antenna,
-                         ppath_lraytrace_var,
+      // Initialize other variables
+      local_rte_pos = sensor_pos(0, joker);
+      s_tot = 0.0;
+      t_tot = 0.0;
+      scat_order = 0;
+      while (keepgoing) {
+        Numeric s_path, t_path;
+
+        mcPathTraceRadar(l_ws,
+                         evol_op,
+                         abs_vec_mono,
+                         t_array[0],
+                         ext_mat_mono,
+                         rng,
+                         local_rte_pos,
+                         local_rte_los,
+                         pnd_vec,  //pnds(joker,0),
+                         s_path,
+                         t_path,
+                         ppath_step,
+                         termination_flag,
+                         inside_cloud,
                          ppath_step_agenda,
-                         atmosphere_dim,
+                         ppath_lmax,
+                         ppath_lraytrace,
+                         propmat_clearsky_agenda,
+                         anyptype_nonTotRan,
+                         stokes_dim,
+                         f_index,
+                         f_grid,
+                         Ihold,
                          p_grid,
                          lat_grid,
                          lon_grid,
                          z_field,
-                         f_grid,
                          refellipsoid,
                          z_surface,
-                         sensor_pos(0, joker),
-                         local_rte_pos,
-                         ppath_lmax,
-                         za_accuracy,
-                         pplrt_factor,
-                         pplrt_lowest,
+                         t_field,
+                         vmr_field,
+                         cloudbox_limits,
+                         pnd_field,
+                         scat_data,
                          verbosity);
+        pnds(joker, 0) = pnd_vec;
+        if (!inside_cloud || termination_flag != 0) {
+          keepgoing = false;
+        } else {
+          s_tot += s_path;
+          t_tot += t_path;
+
+          //
+          Csca = ext_mat_mono(0, 0) - abs_vec_mono[0];
+          Cext = ext_mat_mono(0, 0);
+          if (anyptype_nonTotRan) {
+            const Numeric Irat = Ihold[1] / Ihold[0];
+            Csca += Irat * (ext_mat_mono(1, 0) - abs_vec_mono[1]);
+            Cext += Irat * ext_mat_mono(0, 1);
+          }
+          albedo = Csca / Cext;
 
-        // Return distance
-        const Index np2 = ppath.np;
-        s_return = ppath.end_lstep;
-        t_return = s_return / SPEED_OF_LIGHT;
-        for (Index ip = 1; ip < np2; ip++) {
-          s_return += ppath.lstep[ip - 1];
-          t_return += ppath.lstep[ip - 1] * 0.5 *
-                      (ppath.ngroup[ip - 1] + ppath.ngroup[ip]) /
-                      SPEED_OF_LIGHT;
-        }
+          // Terminate if absorption event, outside cloud, or surface
+          Numeric rn = rng.draw();
+          if (rn > albedo) {
+            keepgoing = false;
+            continue;
+          }
 
-        // One-way distance
-        if (is_dist) {
-          r_trav = 0.5 * (s_tot + s_return);
-        }
+          Vector rte_los_geom(2);
+
+          // Compute reflectivity contribution based on local-to-sensor
+          // geometry, path attenuation
+          // Get los angles at atmospheric locale to determine
+          // scattering angle
+          if (firstpass) {
+            // Use this to ensure that the difference in azimuth angle
+            // between incident and scattered lines-of-sight is 180
+            // degrees
+            mirror_los(rte_los_geom, local_rte_los, atmosphere_dim);
+            firstpass = false;
+          } else {
+            // Replace with ppath_agendaExecute??
+            rte_losGeometricFromRtePosToRtePos2(rte_los_geom,
+                                                atmosphere_dim,
+                                                lat_grid,
+                                                lon_grid,
+                                                refellipsoid,
+                                                local_rte_pos,
+                                                sensor_pos(0, joker),
+                                                verbosity);
+          }
 
-        // Round trip travel time
-        else {
-          r_trav = t_tot + t_return;
-        }
+          // Get los angles at sensor to determine antenna pattern
+          // weighting of return signal and ppath to determine
+          // propagation path back to sensor
+          // Replace with ppath_agendaExecute??
+          Ppath ppath;
+          Vector rte_los_antenna(2);
+          ppath_lraytrace_var = ppath_lraytrace;
+          Numeric za_accuracy = 2e-5;
+          Numeric pplrt_factor = 5;
+          Numeric pplrt_lowest = 0.5;
+
+          rte_losGeometricFromRtePosToRtePos2(rte_los_antenna,
+                                              atmosphere_dim,
+                                              lat_grid,
+                                              lon_grid,
+                                              refellipsoid,
+                                              sensor_pos(0, joker),
+                                              local_rte_pos,
+                                              verbosity);
 
-        // Still within max range of radar?
-        if (r_trav <= r_max) {
-          // Compute path extinction as with radio link
-          get_ppath_transmat(ws,
-                             trans_mat,
-                             ppath,
-                             propmat_clearsky_agenda,
-                             stokes_dim,
-                             f_index,
-                             f_grid,
-                             p_grid,
-                             t_field,
-                             vmr_field,
-                             cloudbox_limits,
-                             pnd_field,
-                             scat_data,
-                             verbosity);
+          ppathFromRtePos2(l_ws,
+                           ppath,
+                           rte_los_antenna,
+                           ppath_lraytrace_var,
+                           ppath_step_agenda,
+                           atmosphere_dim,
+                           p_grid,
+                           lat_grid,
+                           lon_grid,
+                           z_field,
+                           f_grid,
+                           refellipsoid,
+                           z_surface,
+                           sensor_pos(0, joker),
+                           local_rte_pos,
+                           ppath_lmax,
+                           za_accuracy,
+                           pplrt_factor,
+                           pplrt_lowest,
+                           verbosity);
 
-          // Obtain scattering matrix given incident and scattered angles
-          Matrix P(stokes_dim, stokes_dim);
+          // Return distance
+          const Index np2 = ppath.np;
+          s_return = ppath.end_lstep;
+          t_return = s_return / SPEED_OF_LIGHT;
+          for (Index ip = 1; ip < np2; ip++) {
+            s_return += ppath.lstep[ip - 1];
+            t_return += ppath.lstep[ip - 1] * 0.5 *
+                        (ppath.ngroup[ip - 1] + ppath.ngroup[ip]) /
+                        SPEED_OF_LIGHT;
+          }
 
-          pdir_array(0, joker) = rte_los_geom;
-          idir_array(0, joker) = local_rte_los;
-          pha_mat_NScatElems(pha_mat_Nse,
-                             ptypes_Nse,
-                             t_ok,
-                             scat_data,
-                             stokes_dim,
-                             t_array,
-                             pdir_array,
-                             idir_array,
-                             f_index,
-                             t_interp_order);
-          pha_mat_ScatSpecBulk(pha_mat_ssbulk,
-                               ptype_ssbulk,
-                               pha_mat_Nse,
-                               ptypes_Nse,
-                               pnds,
-                               t_ok);
-          pha_mat_Bulk(pha_mat_bulk, ptype_bulk, pha_mat_ssbulk, ptype_ssbulk);
-          P = pha_mat_bulk(0, 0, 0, 0, joker, joker);
-
-          P *= 4 * PI;
-          P /= Csca;
-
-          // Compute reflectivity contribution here
-          mult(Ipath, evol_op, Ihold);
-          Ipath /= Ipath[0];
-          Ipath *= Ihold[0];
-          mult(Ihold, P, Ipath);
-          mult(I_i, trans_mat, Ihold);
-          Ihold = Ipath;
-          if (Ihold[0] < 1e-40 || std::isnan(Ihold[0]) ||
-              std::isnan(Ihold[1]) ||
-              (stokes_dim > 2 && std::isnan(Ihold[2])) ||
-              (stokes_dim > 3 && std::isnan(Ihold[3]))) {
-            integrity = false;
+          // One-way distance
+          if (is_dist) {
+            r_trav = 0.5 * (s_tot + s_return);
+          }
+
+          // Round trip travel time
+          else {
+            r_trav = t_tot + t_return;
           }
 
-          if (r_trav > r_min && integrity) {
-            // Add reflectivity to proper range bin
-            Index ibin = 0;
-            r_bin = 0.0;
-            while (r_bin < r_trav && ibin <= nbins + 1) {
-              ibin++;
-              r_bin = range_bins[ibin];
+          // Still within max range of radar?
+          if (r_trav <= r_max) {
+            // Compute path extinction as with radio link
+            get_ppath_transmat(l_ws,
+                               trans_mat,
+                               ppath,
+                               propmat_clearsky_agenda,
+                               stokes_dim,
+                               f_index,
+                               f_grid,
+                               p_grid,
+                               t_field,
+                               vmr_field,
+                               cloudbox_limits,
+                               pnd_field,
+                               scat_data,
+                               verbosity);
+
+            // Obtain scattering matrix given incident and scattered angles
+            Matrix P(stokes_dim, stokes_dim);
+
+            pdir_array(0, joker) = rte_los_geom;
+            idir_array(0, joker) = local_rte_los;
+            pha_mat_NScatElems(pha_mat_Nse,
+                               ptypes_Nse,
+                               t_ok,
+                               scat_data,
+                               stokes_dim,
+                               t_array,
+                               pdir_array,
+                               idir_array,
+                               f_index,
+                               t_interp_order);
+            pha_mat_ScatSpecBulk(pha_mat_ssbulk,
+                                 ptype_ssbulk,
+                                 pha_mat_Nse,
+                                 ptypes_Nse,
+                                 pnds,
+                                 t_ok);
+            pha_mat_Bulk(
+                pha_mat_bulk, ptype_bulk, pha_mat_ssbulk, ptype_ssbulk);
+            P = pha_mat_bulk(0, 0, 0, 0, joker, joker);
+
+            P *= 4 * PI;
+            P /= Csca;
+
+            // Compute reflectivity contribution here
+            mult(Ipath, evol_op, Ihold);
+            Ipath /= Ipath[0];
+            Ipath *= Ihold[0];
+            mult(Ihold, P, Ipath);
+            mult(I_i, trans_mat, Ihold);
+            Ihold = Ipath;
+            if (Ihold[0] < 1e-40 || std::isnan(Ihold[0]) ||
+                std::isnan(Ihold[1]) ||
+                (stokes_dim > 2 && std::isnan(Ihold[2])) ||
+                (stokes_dim > 3 && std::isnan(Ihold[3]))) {
+              integrity = false;
             }
-            ibin -= 1;
-
-            // Calculate rx antenna weight and polarization rotation
-            Matrix R_rx(3, 3);
-            rotmat_enu(R_rx, rte_los_antenna);
-            mc_antenna.return_los(antenna_wgt, R_rx, R_enu2ant);
-            rotmat_stokes(
-                R_stokes, stokes_dim, rx_dir, tx_dir, R_rx, R_ant2enu);
-            mult(I_i_rot, R_stokes, I_i);
-
-            for (Index istokes = 0; istokes < stokes_dim; istokes++) {
-              Index ibiny = ibin * stokes_dim + istokes;
-              ARTS_ASSERT(!std::isnan(I_i_rot[istokes]));
-              Isum[ibiny] += antenna_wgt * I_i_rot[istokes];
-              Isquaredsum[ibiny] += antenna_wgt * antenna_wgt *
-                                    I_i_rot[istokes] * I_i_rot[istokes];
+
+            if (r_trav > r_min && integrity) {
+              // Add reflectivity to proper range bin
+              Index ibin = 0;
+              r_bin = 0.0;
+              while (r_bin < r_trav && ibin <= nbins + 1) {
+                ibin++;
+                r_bin = range_bins[ibin];
+              }
+              ibin -= 1;
+
+              // Calculate rx antenna weight and polarization rotation
+              Matrix R_rx(3, 3);
+              rotmat_enu(R_rx, rte_los_antenna);
+              mc_antenna.return_los(antenna_wgt, R_rx, R_enu2ant);
+              rotmat_stokes(
+                  R_stokes, stokes_dim, rx_dir, tx_dir, R_rx, R_ant2enu);
+              mult(I_i_rot, R_stokes, I_i);
+
+              for (Index istokes = 0; istokes < stokes_dim; istokes++) {
+                Index ibiny = ibin * stokes_dim + istokes;
+                ARTS_ASSERT(!std::isnan(I_i_rot[istokes]));
+                stream.Isum[ibiny] += antenna_wgt * I_i_rot[istokes];
+                stream.Isquaredsum[ibiny] += antenna_wgt * antenna_wgt *
+                                      I_i_rot[istokes] * I_i_rot[istokes];
+              }
+              stream.range_bin_count[ibin] += 1;
             }
-            range_bin_count[ibin] += 1;
-          }
 
-          scat_order++;
+            scat_order++;
             
-          Sample_los_uniform(new_rte_los, rng);
-          pdir_array(0, joker) = new_rte_los;
-          // alt:
-          // Sample_los_uniform( pdir_array(0,joker), rng );
-          pha_mat_NScatElems(pha_mat_Nse,
-                             ptypes_Nse,
-                             t_ok,
-                             scat_data,
-                             stokes_dim,
-                             t_array,
-                             pdir_array,
-                             idir_array,
-                             f_index,
-                             t_interp_order);
-          pha_mat_ScatSpecBulk(pha_mat_ssbulk,
-                               ptype_ssbulk,
-                               pha_mat_Nse,
+            Sample_los_uniform(new_rte_los, rng);
+            pdir_array(0, joker) = new_rte_los;
+            // alt:
+            // Sample_los_uniform( pdir_array(0,joker), rng );
+            pha_mat_NScatElems(pha_mat_Nse,
                                ptypes_Nse,
-                               pnds,
-                               t_ok);
-          pha_mat_Bulk(pha_mat_bulk, ptype_bulk, pha_mat_ssbulk, ptype_ssbulk);
-          Z = pha_mat_bulk(0, 0, 0, 0, joker, joker);
-
-          Z *= 4 * PI;
-          Z /= Csca;
-          mult(Ipath, Z, Ihold);
-          Ihold = Ipath;
-          local_rte_los = new_rte_los;
-          // alt:
-          //local_rte_los = pdir_array(0,joker);
-          // or even (but also requires replacements of local_rte_los
-          // with idir_array throughout the whole loop):
-          //idir_array = pdir_array;
-        } else {
-          // Past farthest range
-          keepgoing = false;
+                               t_ok,
+                               scat_data,
+                               stokes_dim,
+                               t_array,
+                               pdir_array,
+                               idir_array,
+                               f_index,
+                               t_interp_order);
+            pha_mat_ScatSpecBulk(pha_mat_ssbulk,
+                                 ptype_ssbulk,
+                                 pha_mat_Nse,
+                                 ptypes_Nse,
+                                 pnds,
+                                 t_ok);
+            pha_mat_Bulk(
+                pha_mat_bulk, ptype_bulk, pha_mat_ssbulk, ptype_ssbulk);
+            Z = pha_mat_bulk(0, 0, 0, 0, joker, joker);
+
+            Z *= 4 * PI;
+            Z /= Csca;
+            mult(Ipath, Z, Ihold);
+            Ihold = Ipath;
+            local_rte_los = new_rte_los;
+            // alt:
+            //local_rte_los = pdir_array(0,joker);
+            // or even (but also requires replacements of local_rte_los
+            // with idir_array throughout the whole loop):
+            //idir_array = pdir_array;
+          } else {
+            // Past farthest range
+            keepgoing = false;
+          }
         }
+
+        // Some checks
+        if (scat_order >= mc_max_scatorder) keepgoing = false;
+        if (!integrity) keepgoing = false;
+      }  // while (inner: keepgoing)
+    }  // for (outer)
+  };
+
+  //Begin Main Loop
+  String fail_msg;
+  bool failed = false;
+
+#pragma omp parallel for schedule(static, 1) if (nstreams > 1)
+  for (Index s = 0; s < nstreams; s++) {
+    PhotonStream& stream = streams[s];
+    stream.Isum.resize(nbins * stokes_dim);
+    stream.Isum = 0.0;
+    stream.Isquaredsum.resize(nbins * stokes_dim);
+    stream.Isquaredsum = 0.0;
+    stream.range_bin_count.resize(nbins);
+    stream.range_bin_count = 0;
+
+    try {
+      // Each stream needs its own copy of the workspace
+      PooledWorkspace l_ws(ws);
+      trace_photons(
+          *l_ws,
+          stream,
+          mc_max_iter / nstreams + (s < mc_max_iter % nstreams ? 1 : 0));
+    } catch (const std::exception& e) {
+#pragma omp critical(MCRadar_fail)
+      {
+        fail_msg = e.what();
+        failed = true;
       }
+    }
+  }
 
-      // Some checks
-      if (scat_order >= mc_max_scatorder) keepgoing = false;
-      if (!integrity) keepgoing = false;
-    }  // while (inner: keepgoing)
+  if (failed) throw runtime_error(fail_msg);
 
-  }  // while (outer)
+  // Merge the streams
+  Vector Isum(nbins * stokes_dim, 0.0), Isquaredsum(nbins * stokes_dim, 0.0);
+  Vector range_bin_count(nbins, 0.0);
+  for (const auto& stream : streams) {
+    Isum += stream.Isum;
+    Isquaredsum += stream.Isquaredsum;
+    range_bin_count += stream.range_bin_count;
+  }
+  const Index mc_iter = mc_max_iter;
 
   // Normalize range bins and apply sensor response (polarization)
   for (Index ibin = 0; ibin < nbins; ibin++) {
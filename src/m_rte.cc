@@ -33,12 +33,14 @@
 #include <stdexcept>
 #include "arts.h"
 #include "arts_omp.h"
+#include "artstime.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "geodetic.h"
 #include "jacobian.h"
 #include "logic.h"
 #include "math_funcs.h"
+#include "matpack_arena.h"
 #include "messages.h"
 #include "montecarlo.h"
 #include "physics_funcs.h"
@@ -205,7 +207,11 @@ void iyEmissionStandard(
     const Tensor3& iy_transmittance,
     const Numeric& rte_alonglos_v,
     const Tensor3& surface_props_data,
+    const Index& f_block_size,
     const Verbosity& verbosity) {
+  // Take the many small temporaries along the path from the thread's arena
+  MatpackArenaScope arena_scope;
+
   //  Init Jacobian quantities?
   const Index j_analytical_do = jacobian_do ? do_analytical_jacobian<2>(jacobian_quantities) : 0;
   
@@ -319,14 +325,6 @@ void iyEmissionStandard(
     const bool temperature_jacobian =
         j_analytical_do and do_temperature_jacobian(jacobian_quantities);
 
-    // Size radiative variables always used
-    Vector B(nf);
-    StokesVector a(nf, ns), S(nf, ns);
-
-    // Init variables only used if analytical jacobians done
-    Vector dB_dT(temperature_jacobian ? nf : 0);
-    ArrayOfStokesVector da_dx(nq), dS_dx(nq);
-
     // HSE variables
     Index temperature_derivative_position = -1;
     bool do_hse = false;
@@ -337,37 +335,80 @@ void iyEmissionStandard(
         FOR_ANALYTICAL_JACOBIANS_DO(dK_dx[ip][iq] = PropagationMatrix(nf, ns);)
       }
       FOR_ANALYTICAL_JACOBIANS_DO(
-          da_dx[iq] = StokesVector(nf, ns); dS_dx[iq] = StokesVector(nf, ns);
           if (jacobian_quantities[iq] == Jacobian::Atm::Temperature) {
             temperature_derivative_position = iq;
             do_hse = jacobian_quantities[iq].Subtag() == "HSE on";
           })
     }
 
-    Agenda l_propmat_clearsky_agenda(propmat_clearsky_agenda);
-    Workspace l_ws(ws);
+    // Frequency blocks. Each (ppath point, frequency block) pair is
+    // computed independently of the others. The block size does not
+    // depend on the number of threads, so the results are the same
+    // for any number of threads.
+    const Index nfb = (f_block_size > 0 and f_block_size < nf) ? f_block_size : nf;
+    const Index nb = (nf + nfb - 1) / nfb;
+
     ArrayOfString fail_msg;
     bool do_abort = false;
 
-    // Loop ppath points and determine radiative properties
-#pragma omp parallel for if (!arts_omp_in_parallel()) \
-    firstprivate(l_ws, l_propmat_clearsky_agenda, a, B, dB_dT, S, da_dx, dS_dx)
-    for (Index ip = 0; ip < np; ip++) {
-      if (do_abort) continue;
+    // Loop ppath points and frequency blocks and determine radiative
+    // properties. The loops are run as tasks, so that also inside the
+    // tasks of yCalc or iyb_calc idle threads can take part.
+    arts_omp_taskloop(np * nb, [&](const Index ipb) {
+      if (do_abort) return;
+      const Index ip = ipb / nb;
+      const Index f0 = (ipb % nb) * nfb;
+      const Range fb(f0, min(nfb, nf - f0));
+      const Index nfi = fb.get_extent();
       try {
+        MatpackArenaScope block_arena_scope;
+
+        // Each task needs its own copy of the workspace
+        PooledWorkspace l_ws(ws);
+
+        // Radiative variables of this block
+        Vector B(nfi), dB_dT(temperature_jacobian ? nfi : 0);
+        StokesVector a(nfi, ns), S(nfi, ns);
+        ArrayOfStokesVector da_dx(nq), dS_dx(nq);
+        if (j_analytical_do)
+          FOR_ANALYTICAL_JACOBIANS_DO(da_dx[iq] = StokesVector(nfi, ns);
+                                      dS_dx[iq] = StokesVector(nfi, ns);)
+
+        // With a single block, K, dK_dx and the source are computed in
+        // place. Otherwise in these block variables, which are moved into
+        // the full frequency grid below.
+        PropagationMatrix K_block;
+        ArrayOfPropagationMatrix dK_dx_block;
+        RadiationVector src_block;
+        ArrayOfRadiationVector dsrc_block;
+        if (nb > 1) {
+          K_block = PropagationMatrix(nfi, ns);
+          src_block = RadiationVector(nfi, ns);
+          dsrc_block.resize(nq, RadiationVector(nfi, ns));
+          if (j_analytical_do) {
+            dK_dx_block.resize(nq);
+            FOR_ANALYTICAL_JACOBIANS_DO(
+                dK_dx_block[iq] = PropagationMatrix(nfi, ns);)
+          }
+        }
+        PropagationMatrix& Kb = nb > 1 ? K_block : K[ip];
+        ArrayOfPropagationMatrix& dK_dx_b = nb > 1 ? dK_dx_block : dK_dx[ip];
+        RadiationVector& src_b = nb > 1 ? src_block : src_rad[ip];
+        ArrayOfRadiationVector& dsrc_b = nb > 1 ? dsrc_block : dsrc_rad[ip];
+
         get_stepwise_blackbody_radiation(
-            B, dB_dT, ppvar_f(joker, ip), ppvar_t[ip], temperature_jacobian);
+            B, dB_dT, ppvar_f(fb, ip), ppvar_t[ip], temperature_jacobian);
 
         Index lte;
-        get_stepwise_clearsky_propmat(l_ws,
-                                      K[ip],
+        get_stepwise_clearsky_propmat(*l_ws,
+                                      Kb,
                                       S,
                                       lte,
-                                      dK_dx[ip],
+                                      dK_dx_b,
                                       dS_dx,
-                                      l_propmat_clearsky_agenda,
+                                      propmat_clearsky_agenda,
                                       jacobian_quantities,
-                                      ppvar_f(joker, ip),
+                                      ppvar_f(fb, ip),
                                       ppvar_mag(joker, ip),
                                       ppath.los(ip, joker),
                                       ppvar_nlte[ip],
@@ -377,10 +418,10 @@ void iyEmissionStandard(
                                       j_analytical_do);
 
         if (j_analytical_do)
-          adapt_stepwise_partial_derivatives(dK_dx[ip],
+          adapt_stepwise_partial_derivatives(dK_dx_b,
                                              dS_dx,
                                              jacobian_quantities,
-                                             ppvar_f(joker, ip),
+                                             ppvar_f(fb, ip),
                                              ppath.los(ip, joker),
                                              ppvar_vmr(joker, ip),
                                              ppvar_t[ip],
@@ -391,23 +432,34 @@ void iyEmissionStandard(
                                              j_analytical_do);
 
         // Here absorption equals extinction
-        a = K[ip];
+        a = Kb;
         if (j_analytical_do)
-          FOR_ANALYTICAL_JACOBIANS_DO(da_dx[iq] = dK_dx[ip][iq];);
+          FOR_ANALYTICAL_JACOBIANS_DO(da_dx[iq] = dK_dx_b[iq];);
 
-        stepwise_source(src_rad[ip],
-                        dsrc_rad[ip],
-                        K[ip],
+        stepwise_source(src_b,
+                        dsrc_b,
+                        Kb,
                         a,
                         S,
-                        dK_dx[ip],
+                        dK_dx_b,
                         da_dx,
                         dS_dx,
                         B,
                         dB_dT,
                         jacobian_quantities,
                         jacobian_do);
-      } catch (const std::runtime_error& e) {
+
+        // Move the block into the full frequency grid
+        if (nb > 1) {
+          K[ip].Data()(joker, joker, fb, joker) = Kb.Data();
+          src_rad[ip].setFrequencyBlock(f0, src_b);
+          if (j_analytical_do)
+            FOR_ANALYTICAL_JACOBIANS_DO(
+                dK_dx[ip][iq].Data()(joker, joker, fb, joker) =
+                    dK_dx_b[iq].Data();
+                dsrc_rad[ip][iq].setFrequencyBlock(f0, dsrc_b[iq]);)
+        }
+      } catch (const std::exception& e) {
         ostringstream os;
         os << "Runtime-error in source calculation at index " << ip
            << ": \n";
@@ -418,34 +470,85 @@ void iyEmissionStandard(
           fail_msg.push_back(os.str());
         }
       }
-    }
-
-#pragma omp parallel for if (!arts_omp_in_parallel())
-    for (Index ip = 1; ip < np; ip++) {
-      if (do_abort) continue;
+    });
+
+    // The first ppath point has no layer before it
+    arts_omp_taskloop(np * nb - nb, [&](const Index i) {
+      if (do_abort) return;
+      const Index ipb = nb + i;
+      const Index ip = ipb / nb;
+      const Index f0 = (ipb % nb) * nfb;
+      const Range fb(f0, min(nfb, nf - f0));
+      const Index nfi = fb.get_extent();
       try {
+        MatpackArenaScope block_arena_scope;
+
         const Numeric dr_dT_past =
             do_hse ? ppath.lstep[ip - 1] / (2.0 * ppvar_t[ip - 1]) : 0;
         const Numeric dr_dT_this =
             do_hse ? ppath.lstep[ip - 1] / (2.0 * ppvar_t[ip]) : 0;
-        stepwise_transmission(lyr_tra[ip],
-                              dlyr_tra_above[ip],
-                              dlyr_tra_below[ip],
-                              K[ip - 1],
-                              K[ip],
-                              dK_dx[ip - 1],
-                              dK_dx[ip],
-                              ppath.lstep[ip - 1],
-                              dr_dT_past,
-                              dr_dT_this,
-                              temperature_derivative_position);
-        
-        r[ip - 1] = ppath.lstep[ip - 1];
-        if (temperature_derivative_position >= 0){
-          dr_below[ip][temperature_derivative_position] = dr_dT_past;
-          dr_above[ip][temperature_derivative_position] = dr_dT_this;
+
+        if (nb == 1) {
+          stepwise_transmission(lyr_tra[ip],
+                                dlyr_tra_above[ip],
+                                dlyr_tra_below[ip],
+                                K[ip - 1],
+                                K[ip],
+                                dK_dx[ip - 1],
+                                dK_dx[ip],
+                                ppath.lstep[ip - 1],
+                                dr_dT_past,
+                                dr_dT_this,
+                                temperature_derivative_position);
+        } else {
+          // Propagation matrices and transmission of this block
+          const PropagationMatrix K_past(
+              K[ip - 1].Data()(joker, joker, fb, joker));
+          const PropagationMatrix K_this(
+              K[ip].Data()(joker, joker, fb, joker));
+          ArrayOfPropagationMatrix dK_past(dK_dx[ip - 1].nelem()),
+              dK_this(dK_dx[ip].nelem());
+          for (Index iq = 0; iq < dK_past.nelem(); iq++) {
+            if (dK_dx[ip - 1][iq].NumberOfFrequencies())
+              dK_past[iq] = PropagationMatrix(
+                  dK_dx[ip - 1][iq].Data()(joker, joker, fb, joker));
+            if (dK_dx[ip][iq].NumberOfFrequencies())
+              dK_this[iq] = PropagationMatrix(
+                  dK_dx[ip][iq].Data()(joker, joker, fb, joker));
+          }
+          TransmissionMatrix tra_b(nfi, ns);
+          ArrayOfTransmissionMatrix dtra_above_b(nq,
+                                                 TransmissionMatrix(nfi, ns)),
+              dtra_below_b(nq, TransmissionMatrix(nfi, ns));
+
+          stepwise_transmission(tra_b,
+                                dtra_above_b,
+                                dtra_below_b,
+                                K_past,
+                                K_this,
+                                dK_past,
+                                dK_this,
+                                ppath.lstep[ip - 1],
+                                dr_dT_past,
+                                dr_dT_this,
+                                temperature_derivative_position);
+
+          // Move the block into the full frequency grid
+          lyr_tra[ip].setFrequencyBlock(f0, tra_b);
+          for (Index iq = 0; iq < nq; iq++) {
+            dlyr_tra_above[ip][iq].setFrequencyBlock(f0, dtra_above_b[iq]);
+            dlyr_tra_below[ip][iq].setFrequencyBlock(f0, dtra_below_b[iq]);
+          }
         }
-      } catch (const std::runtime_error& e) {
+
+        if (f0 == 0) {
+          r[ip - 1] = ppath.lstep[ip - 1];
+          if (temperature_derivative_position >= 0){
+            dr_below[ip][temperature_derivative_position] = dr_dT_past;
+            dr_above[ip][temperature_derivative_position] = dr_dT_this;
+          }
+        }
+      } catch (const std::exception& e) {
         ostringstream os;
         os << "Runtime-error in transmission calculation at index " << ip
            << ": \n";
@@ -456,7 +559,7 @@ void iyEmissionStandard(
           fail_msg.push_back(os.str());
         }
       }
-    }
+    });
 
     ARTS_USER_ERROR_IF (do_abort,
       "Error messages from failed cases:\n", fail_msg)
@@ -1273,6 +1376,8 @@ void iyMC(Workspace& ws,
                   mc_taustep_limit,
                   1,
                   t_interp_order,
+                  0,
+                  {},
                   verbosity);
 
         ARTS_ASSERT(y.nelem() == stokes_dim);
@@ -1374,6 +1479,7 @@ void yCalc(Workspace& ws,
            const ArrayOfRetrievalQuantity& jacobian_quantities,
            const ArrayOfString& iy_aux_vars,
            const Verbosity& verbosity) {
+  CREATE_OUT2;
   CREATE_OUT3;
 
   // Basics
@@ -1452,106 +1558,86 @@ void yCalc(Workspace& ws,
   String fail_msg;
   bool failed = false;
 
-  if (nmblock >= arts_omp_get_max_threads() ||
+  // Calculation of a single measurement block, using the workspace l_ws
+  Vector mblock_seconds(nmblock, 0);
+  const Time start_all;
+  auto mblock_body = [&](Workspace& l_ws, const Index mblock_index) {
+    // Skip remaining iterations if an error occurred
+    if (failed) return;
+
+    const Time start_mblock;
+    yCalc_mblock_loop_body(failed,
+                           fail_msg,
+                           iyb_aux_array,
+                           l_ws,
+                           y,
+                           y_f,
+                           y_pol,
+                           y_pos,
+                           y_los,
+                           y_geo,
+                           jacobian,
+                           atmosphere_dim,
+                           nlte_field,
+                           cloudbox_on,
+                           stokes_dim,
+                           f_grid,
+                           sensor_pos,
+                           sensor_los,
+                           transmitter_pos,
+                           mblock_dlos_grid,
+                           sensor_response,
+                           sensor_response_f,
+                           sensor_response_pol,
+                           sensor_response_dlos,
+                           iy_unit,
+                           iy_main_agenda,
+                           geo_pos_agenda,
+                           jacobian_agenda,
+                           jacobian_do,
+                           jacobian_quantities,
+                           jacobian_indices,
+                           iy_aux_vars,
+                           verbosity,
+                           mblock_index,
+                           n1y,
+                           j_analytical_do);
+    mblock_seconds[mblock_index] = TimeStep(Time() - start_mblock).count();
+
+    ostringstream os;
+    os << "  Measurement block " << mblock_index + 1 << " of " << nmblock
+       << " done by thread " << arts_omp_get_thread_num() << " in "
+       << mblock_seconds[mblock_index] << " s.\n";
+    out3 << os.str();
+  };
+
+  // The measurement blocks are run as tasks. Blocks finishing early
+  // free their thread for the next block, or for the los of blocks
+  // still running (see iyb_calc). Inside a parallel region (e.g. from
+  // ybatchCalc) tasks are always used, as only tasks can make use of
+  // idle threads there.
+  if (arts_omp_in_parallel() || nmblock >= arts_omp_get_max_threads() ||
       (nf <= nmblock && nmblock >= nlos)) {
     out3 << "  Parallelizing mblock loop (" << nmblock << " iterations)\n";
 
-    // We have to make a local copy of the Workspace and the agendas because
-    // only non-reference types can be declared firstprivate in OpenMP
-    Workspace l_ws(ws);
-    Agenda l_jacobian_agenda(jacobian_agenda);
-    Agenda l_iy_main_agenda(iy_main_agenda);
-    Agenda l_geo_pos_agenda(geo_pos_agenda);
-
-#pragma omp parallel for firstprivate( \
-    l_ws, l_jacobian_agenda, l_iy_main_agenda, l_geo_pos_agenda)
-    for (Index mblock_index = 0; mblock_index < nmblock; mblock_index++) {
-      // Skip remaining iterations if an error occurred
-      if (failed) continue;
-
-      yCalc_mblock_loop_body(failed,
-                             fail_msg,
-                             iyb_aux_array,
-                             l_ws,
-                             y,
-                             y_f,
-                             y_pol,
-                             y_pos,
-                             y_los,
-                             y_geo,
-                             jacobian,
-                             atmosphere_dim,
-                             nlte_field,
-                             cloudbox_on,
-                             stokes_dim,
-                             f_grid,
-                             sensor_pos,
-                             sensor_los,
-                             transmitter_pos,
-                             mblock_dlos_grid,
-                             sensor_response,
-                             sensor_response_f,
-                             sensor_response_pol,
-                             sensor_response_dlos,
-                             iy_unit,
-                             l_iy_main_agenda,
-                             l_geo_pos_agenda,
-                             l_jacobian_agenda,
-                             jacobian_do,
-                             jacobian_quantities,
-                             jacobian_indices,
-                             iy_aux_vars,
-                             verbosity,
-                             mblock_index,
-                             n1y,
-                             j_analytical_do);
-    }  // End mblock loop
+    arts_omp_taskloop(nmblock, [&](const Index mblock_index) {
+      // Each task needs its own copy of the workspace
+      PooledWorkspace l_ws(ws);
+      mblock_body(*l_ws, mblock_index);
+    });
   } else {
     out3 << "  Not parallelizing mblock loop (" << nmblock << " iterations)\n";
 
-    for (Index mblock_index = 0; mblock_index < nmblock; mblock_index++) {
-      // Skip remaining iterations if an error occurred
-      if (failed) continue;
-
-      yCalc_mblock_loop_body(failed,
-                             fail_msg,
-                             iyb_aux_array,
-                             ws,
-                             y,
-                             y_f,
-                             y_pol,
-                             y_pos,
-                             y_los,
-                             y_geo,
-                             jacobian,
-                             atmosphere_dim,
-                             nlte_field,
-                             cloudbox_on,
-                             stokes_dim,
-                             f_grid,
-                             sensor_pos,
-                             sensor_los,
-                             transmitter_pos,
-                             mblock_dlos_grid,
-                             sensor_response,
-                             sensor_response_f,
-                             sensor_response_pol,
-                             sensor_response_dlos,
-                             iy_unit,
-                             iy_main_agenda,
-                             geo_pos_agenda,
-                             jacobian_agenda,
-                             jacobian_do,
-                             jacobian_quantities,
-                             jacobian_indices,
-                             iy_aux_vars,
-                             verbosity,
-                             mblock_index,
-                             n1y,
-                             j_analytical_do);
-    }  // End mblock loop
+    for (Index mblock_index = 0; mblock_index < nmblock; mblock_index++)
+      mblock_body(ws, mblock_index);
   }
 
+  if (nmblock > 1 and not failed)
+    out2 << "  Measurement blocks took " << min(mblock_seconds) << "-"
+         << max(mblock_seconds) << " s each, " << mblock_seconds.sum()
+         << " s in total and " << TimeStep(Time() - start_all).count()
+         << " s wall time.\n";
+
   // Rethrow exception if a runtime error occurred in the mblock loop
   ARTS_USER_ERROR_IF (failed, fail_msg);
 
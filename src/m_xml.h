@@ -33,6 +33,7 @@
 
 #include "agenda_class.h"
 #include "exceptions.h"
+#include "file.h"
 #include "workspace_ng.h"
 #include "xml_io.h"
 
@@ -70,6 +71,36 @@ void ReadXML(Workspace& ws _U_,
   ReadXML(v, v_name, f, f_name, verbosity);
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+template <typename T>
+void ReadXMLLazy(Workspace& ws,
+                 // WS Generic Output:
+                 T& v,
+                 // WS Generic Output Names:
+                 const String& v_name,
+                 // WS Generic Input:
+                 const String& f,
+                 // WS Generic Input Names:
+                 const String& f_name _U_,
+                 const Verbosity& verbosity) {
+  String filename = f;
+
+  // Create default filename if empty
+  filename_xml(filename, v_name);
+
+  // Fail now and not in the method that first uses the variable if the
+  // file is missing
+  find_xml_file(filename, verbosity);
+
+  // Free the old value until the variable is loaded
+  v = T();
+
+  ws.defer(Workspace::WsvMap.find(v_name)->second,
+           [filename, verbosity](void* p) {
+             xml_read_from_file(filename, *static_cast<T*>(p), verbosity);
+           });
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 template <typename T>
 void ReadXMLIndexed(  // WS Generic Output:
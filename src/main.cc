@@ -54,6 +54,7 @@
 #include "mystring.h"
 #include "parameters.h"
 #include "parser.h"
+#include "profiler.h"
 #include "workspace_ng.h"
 #include "wsv_aux.h"
 
@@ -595,6 +596,106 @@ String arts_mod_time(String filename) {
 String arts_mod_time(String) { return String(""); }
 #endif
 
+/** Execute one parsed controlfile in the given workspace.
+
+    \param[in,out] workspace The workspace.
+    \param[in,out] tasklist  The methods of the controlfile.
+    \param[in]     verbosity Verbosity settings. */
+void run_controlfile(Workspace& workspace,
+                     Agenda& tasklist,
+                     const Verbosity& verbosity) {
+  tasklist.set_name("Arts");
+
+  tasklist.set_main_agenda();
+
+  //tasklist.find_unused_variables();
+
+  // New variables may have been created by the parser
+  workspace.initialize();
+
+  // Execute main agenda:
+  Arts2(workspace, tasklist, verbosity);
+}
+
+/** Serve requests from standard input in a resident workspace.
+
+    All variables set by earlier requests stay in the workspace, so data
+    that was read once, e.g. line catalogs and lookup tables, can be
+    used by all following requests without reading it again.
+
+    One request per line:
+    \verbatim
+    run <file.arts>     Run the given controlfile.
+    begin               Run the controlfile given in the
+    ...                 following lines up to a line
+    end                 containing only `end'.
+    quit                Stop the server.
+    \endverbatim
+
+    Each request is answered on stdout by a line `ok' or a line `error'
+    followed by the error message, and a final line containing only `.'.
+
+    A request can be sent several times. Variables it creates with
+    TYPECreate then refer to the variables created by the first request.
+
+    \param[in,out] workspace The resident workspace.
+    \param[in]     verbosity Verbosity settings. */
+void run_server(Workspace& workspace, const Verbosity& verbosity) {
+  CREATE_OUT1;
+
+  ArtsParser::allow_repeated_create(true);
+
+  out1 << "Server ready.\n";
+
+  String line;
+  Index request = 0;
+  while (getline(cin, line)) {
+    line.trim();
+    if (!line.nelem()) continue;
+    if (line == "quit") break;
+
+    request++;
+    try {
+      if (line == "begin") {
+        ArrayOfString text;
+        bool complete = false;
+        while (getline(cin, line)) {
+          String trimmed = line;
+          trimmed.trim();
+          if (trimmed == "end") {
+            complete = true;
+            break;
+          }
+          text.push_back(line);
+        }
+        if (!complete)
+          throw runtime_error("Input ended before the closing `end'.");
+
+        ostringstream name;
+        name << "request " << request;
+        Agenda tasklist;
+        ArtsParser arts_parser(tasklist, name.str(), text, verbosity);
+        arts_parser.parse_tasklist();
+        run_controlfile(workspace, tasklist, verbosity);
+      } else if (line.substr(0, 4) == "run ") {
+        String controlfile = line.substr(4);
+        controlfile.trim();
+        out1 << "- " << controlfile << "\n";
+        Agenda tasklist;
+        ArtsParser::parse_file(tasklist, controlfile, verbosity);
+        run_controlfile(workspace, tasklist, verbosity);
+      } else {
+        throw runtime_error("Unknown request: " + line);
+      }
+      cout << "ok\n.\n" << flush;
+    } catch (const std::exception& x) {
+      cout << "error\n" << x.what() << "\n.\n" << flush;
+    }
+  }
+
+  out1 << "Server stopped after " << request << " requests.\n";
+}
+
 /** This is the main function of ARTS. (You never guessed that, did you?)
     The getopt_long function is used to parse the command line parameters.
  
@@ -897,15 +998,19 @@ int main(int argc, char** argv) {
 
   // Ok, we are past all the special options. This means the user
   // wants to get serious and really do a calculation. Check if we
-  // have at least one control file:
-  if (0 == parameters.controlfiles.nelem()) {
+  // have at least one control file. The server can also be started
+  // without one.
+  if (0 == parameters.controlfiles.nelem() && !parameters.server) {
     cerr << "You must specify at least one control file name.\n";
     polite_goodby();
   }
 
   // Set the basename according to the first control file, if not
   // explicitly specified.
-  if ("" == parameters.basename) {
+  if ("" == parameters.basename && 0 == parameters.controlfiles.nelem()) {
+    extern String out_basename;
+    out_basename = "arts_server";
+  } else if ("" == parameters.basename) {
     extern String out_basename;
     ArrayOfString fileparts;
     parameters.controlfiles[0].split(fileparts, "/");
@@ -930,8 +1035,11 @@ int main(int argc, char** argv) {
   }
 
   // Set the global reporting level, either from reporting command line
-  // option or default.
-  set_reporting_level(parameters.reporting);
+  // option or default. The server answers requests on stdout, so by
+  // default nothing else is written there.
+  set_reporting_level(parameters.server && -1 == parameters.reporting
+                          ? 0
+                          : parameters.reporting);
 
   // Keep around a global copy of the verbosity levels at launch, so that
   // verbosityInit() can be used to reset them in the control file
@@ -959,6 +1067,11 @@ int main(int argc, char** argv) {
     arts_exit();
   }
 
+  // Enable runtime profiling of agendas and methods if requested. The
+  // report is written when ARTS exits.
+  if (parameters.profile.nelem())
+    profiler::enable(add_basedir(parameters.profile));
+
   // Now comes the global try block. Exceptions caught after this
   // one are general stuff like file opening errors.
   try {
@@ -1015,6 +1128,10 @@ int main(int argc, char** argv) {
          << verbosity.get_file_verbosity() << "\n";
 
     out3 << "\nReading control files:\n";
+    // In server mode, all controlfiles share one workspace that stays
+    // resident for the requests
+    Workspace server_workspace;
+
     for (Index i = 0; i < parameters.controlfiles.nelem(); ++i) {
       try {
         out3 << "- " << parameters.controlfiles[i] << "\n";
@@ -1026,20 +1143,11 @@ int main(int argc, char** argv) {
         Workspace workspace;
 
         // Call the parser to parse the control text:
-        ArtsParser arts_parser(tasklist, parameters.controlfiles[i], verbosity);
-
-        arts_parser.parse_tasklist();
-
-        tasklist.set_name("Arts");
-
-        tasklist.set_main_agenda();
+        ArtsParser::parse_file(tasklist, parameters.controlfiles[i], verbosity);
 
-        //tasklist.find_unused_variables();
-
-        workspace.initialize();
-
-        // Execute main agenda:
-        Arts2(workspace, tasklist, verbosity);
+        run_controlfile(parameters.server ? server_workspace : workspace,
+                        tasklist,
+                        verbosity);
       } catch (const std::exception& x) {
         ostringstream os;
         os << "Run-time error in controlfile: " << parameters.controlfiles[i]
@@ -1048,6 +1156,11 @@ int main(int argc, char** argv) {
         throw runtime_error(os.str());
       }
     }
+
+    if (parameters.server) {
+      server_workspace.initialize();
+      run_server(server_workspace, verbosity);
+    }
   } catch (const std::runtime_error& x) {
 #ifdef TIME_SUPPORT
     struct tms arts_cputime_end;
@@ -268,11 +268,11 @@ int main() {
         align(ofs, is_first_parameter, indent);
 
         if (is_agenda_group_id(wsv_data[vi[j]].Group())) {
-          ofs << "*((" << wsv_group_names[wsv_data[vi[j]].Group()]
-              << " *)ws[mr.In()[" << j << "]])";
+          ofs << "*((const " << wsv_group_names[wsv_data[vi[j]].Group()]
+              << " *)ws.read(mr.In()[" << j << "]))";
         } else {
-          ofs << "*((" << wsv_group_names[wsv_data[vi[j]].Group()]
-              << " *)ws[mr.In()[" << j << "]])";
+          ofs << "*((const " << wsv_group_names[wsv_data[vi[j]].Group()]
+              << " *)ws.read(mr.In()[" << j << "]))";
         }
       }
 
@@ -295,8 +295,8 @@ int main() {
             // Add comma and line break, if not first element:
             align(ofs, is_first_parameter, indent);
 
-            ofs << "*((" << wsv_group_names[vgi[j]] << " *)ws[mr.In()["
-                << j + vi.nelem() << "]])";
+            ofs << "*((const " << wsv_group_names[vgi[j]]
+                << " *)ws.read(mr.In()[" << j + vi.nelem() << "]))";
           }
 
           // Write the Generic input workspace variable names:
@@ -340,8 +340,8 @@ int main() {
         static Index verbosity_wsv_id = get_wsv_id("verbosity");
         static Index verbosity_group_id = get_wsv_group_id("Verbosity");
         align(ofs, is_first_parameter, indent);
-        ofs << "*((" << wsv_group_names[verbosity_group_id] << " *)ws["
-            << verbosity_wsv_id << "])";
+        ofs << "*((const " << wsv_group_names[verbosity_group_id]
+            << " *)ws.read(" << verbosity_wsv_id << "))";
       }
 
       ofs << ");\n";
@@ -26,6 +26,7 @@
 #include <cstring>
 #include "blas.h"
 #include "exceptions.h"
+#include "matpack_arena.h"
 
 using std::cout;
 using std::endl;
@@ -318,30 +319,30 @@ void copy(Numeric x, Iterator1D target, const Iterator1D& end) ARTS_NOEXCEPT {
 // ---------------------
 
 Vector::Vector(std::initializer_list<Numeric> init)
-    : VectorView(new Numeric[init.size()], Range(0, init.size())) {
+    : VectorView(matpack_allocate(init.size()), Range(0, init.size())) {
   std::copy(init.begin(), init.end(), begin());
 }
 
 Vector::Vector(const Eigen::VectorXd& init)
-    : VectorView(new Numeric[init.size()], Range(0, init.size()))
+    : VectorView(matpack_allocate(init.size()), Range(0, init.size()))
 {
   for (Index i=0; i<size(); i++) operator[](i) = init[i];
 }
 
 
-Vector::Vector(Index n) : VectorView(new Numeric[n], Range(0, n)) {
+Vector::Vector(Index n) : VectorView(matpack_allocate(n), Range(0, n)) {
   // Nothing to do here.
 }
 
 Vector::Vector(Index n, Numeric fill)
-    : VectorView(new Numeric[n], Range(0, n)) {
+    : VectorView(matpack_allocate(n), Range(0, n)) {
   // Here we can access the raw memory directly, for slightly
   // increased efficiency:
   std::fill_n(mdata, n, fill);
 }
 
 Vector::Vector(Numeric start, Index extent, Numeric stride)
-    : VectorView(new Numeric[extent], Range(0, extent)) {
+    : VectorView(matpack_allocate(extent), Range(0, extent)) {
   // Fill with values:
   Numeric x = start;
   Iterator1D i = begin();
@@ -353,17 +354,17 @@ Vector::Vector(Numeric start, Index extent, Numeric stride)
 }
 
 Vector::Vector(const ConstVectorView& v)
-    : VectorView(new Numeric[v.nelem()], Range(0, v.nelem())) {
+    : VectorView(matpack_allocate(v.nelem()), Range(0, v.nelem())) {
   copy(v.begin(), v.end(), begin());
 }
 
 Vector::Vector(const Vector& v)
-    : VectorView(new Numeric[v.nelem()], Range(0, v.nelem())) {
+    : VectorView(matpack_allocate(v.nelem()), Range(0, v.nelem())) {
   std::memcpy(mdata, v.mdata, nelem() * sizeof(Numeric));
 }
 
 Vector::Vector(const std::vector<Numeric>& v)
-    : VectorView(new Numeric[v.size()], Range(0, v.size())) {
+    : VectorView(matpack_allocate(v.size()), Range(0, v.size())) {
   std::vector<Numeric>::const_iterator vec_it_end = v.end();
   Iterator1D this_it = this->begin();
   for (std::vector<Numeric>::const_iterator vec_it = v.begin();
@@ -388,7 +389,7 @@ Vector& Vector::operator=(const Vector& v) {
 
 Vector& Vector::operator=(Vector&& v) noexcept {
   if (this != &v) {
-    delete[] mdata;
+    matpack_deallocate(mdata);
     mdata = v.mdata;
     mrange = v.mrange;
     v.mrange = Range(0, 0);
@@ -411,8 +412,8 @@ Vector& Vector::operator=(Numeric x) {
 void Vector::resize(Index n) {
   ARTS_ASSERT(0 <= n);
   if (mrange.mextent != n) {
-    delete[] mdata;
-    mdata = new Numeric[n];
+    matpack_deallocate(mdata);
+    mdata = matpack_allocate(n);
     mrange.mstart = 0;
     mrange.mextent = n;
     mrange.mstride = 1;
@@ -424,7 +425,7 @@ void swap(Vector& v1, Vector& v2) {
   std::swap(v1.mdata, v2.mdata);
 }
 
-Vector::~Vector() { delete[] mdata; }
+Vector::~Vector() { matpack_deallocate(mdata); }
 
 // Functions for ConstMatrixView:
 // ------------------------------
@@ -945,13 +946,13 @@ void copy(Numeric x, Iterator2D target, const Iterator2D& end) ARTS_NOEXCEPT {
 /** Constructor setting size. This constructor has to set the stride
     in the row range correctly! */
 Matrix::Matrix(Index r, Index c)
-    : MatrixView(new Numeric[r * c], Range(0, r, c), Range(0, c)) {
+    : MatrixView(matpack_allocate(r * c), Range(0, r, c), Range(0, c)) {
   // Nothing to do here.
 }
 
 /** Constructor setting size and filling with constant value. */
 Matrix::Matrix(Index r, Index c, Numeric fill)
-    : MatrixView(new Numeric[r * c], Range(0, r, c), Range(0, c)) {
+    : MatrixView(matpack_allocate(r * c), Range(0, r, c), Range(0, c)) {
   // Here we can access the raw memory directly, for slightly
   // increased efficiency:
   std::fill_n(mdata, r * c, fill);
@@ -960,7 +961,7 @@ Matrix::Matrix(Index r, Index c, Numeric fill)
 /** Copy constructor from MatrixView. This automatically sets the size
     and copies the data. */
 Matrix::Matrix(const ConstMatrixView& m)
-    : MatrixView(new Numeric[m.nrows() * m.ncols()],
+    : MatrixView(matpack_allocate(m.nrows() * m.ncols()),
                  Range(0, m.nrows(), m.ncols()),
                  Range(0, m.ncols())) {
   copy(m.begin(), m.end(), begin());
@@ -969,7 +970,7 @@ Matrix::Matrix(const ConstMatrixView& m)
 /** Copy constructor from Matrix. This automatically sets the size
     and copies the data. */
 Matrix::Matrix(const Matrix& m)
-    : MatrixView(new Numeric[m.nrows() * m.ncols()],
+    : MatrixView(matpack_allocate(m.nrows() * m.ncols()),
                  Range(0, m.nrows(), m.ncols()),
                  Range(0, m.ncols())) {
   // There is a catch here: If m is an empty matrix, then it will have
@@ -1015,7 +1016,7 @@ Matrix& Matrix::operator=(const Matrix& m) {
 //! Move assignment operator from another matrix.
 Matrix& Matrix::operator=(Matrix&& m) noexcept {
   if (this != &m) {
-    delete[] mdata;
+    matpack_deallocate(mdata);
     mdata = m.mdata;
     mrr = m.mrr;
     mcr = m.mcr;
@@ -1061,8 +1062,8 @@ void Matrix::resize(Index r, Index c) {
   ARTS_ASSERT(0 <= c);
 
   if (mrr.mextent != r || mcr.mextent != c) {
-    delete[] mdata;
-    mdata = new Numeric[r * c];
+    matpack_deallocate(mdata);
+    mdata = matpack_allocate(r * c);
 
     mrr.mstart = 0;
     mrr.mextent = r;
@@ -1086,7 +1087,7 @@ void swap(Matrix& m1, Matrix& m2) {
 Matrix::~Matrix() {
   //   cout << "Destroying a Matrix:\n"
   //        << *this << "\n........................................\n";
-  delete[] mdata;
+  matpack_deallocate(mdata);
 }
 
 // Some general Matrix Vector functions:
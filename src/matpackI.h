@@ -104,6 +104,7 @@
 
 #include "array.h"
 #include "matpack.h"
+#include "matpack_arena.h"
 
 // Declare existance of some classes
 class bofstream;
@@ -910,14 +911,18 @@ class Vector : public VectorView {
   
   /*! Construct from known data
    * 
-   * Note that this will call delete on the pointer if it is still valid
-   * at the end of the lifetime of this variable
+   * Takes ownership of d, which is freed with matpack_deallocate at the
+   * end of the lifetime of this variable. d must therefore come from
+   * matpack_allocate, e.g. the data of another matpack object that gives
+   * it up (see Tensor7::reduce_rank). Memory from new[] is not allowed.
    * 
    * @param[in] d - A pointer to some raw data
    * @param[in] r0 - The Range along the first dimension
    */
   Vector(Numeric* d, const Range& r0) ARTS_NOEXCEPT
   : VectorView(d, r0) {
+    ARTS_ASSERT(not d or matpack_is_allocated(d),
+                "Data must be allocated with matpack_allocate");
     ARTS_ASSERT(r0.get_extent() >= 0, "Must have size. Has: ", r0.get_extent());
   }
 
@@ -1228,8 +1233,10 @@ class Matrix : public MatrixView {
   
   /*! Construct from known data
    * 
-   * Note that this will call delete on the pointer if it is still valid
-   * at the end of the lifetime of this variable
+   * Takes ownership of d, which is freed with matpack_deallocate at the
+   * end of the lifetime of this variable. d must therefore come from
+   * matpack_allocate, e.g. the data of another matpack object that gives
+   * it up (see Tensor7::reduce_rank). Memory from new[] is not allowed.
    * 
    * @param[in] d - A pointer to some raw data
    * @param[in] r0 - The Range along the first dimension
@@ -1237,6 +1244,8 @@ class Matrix : public MatrixView {
    */
   Matrix(Numeric* d, const Range& r0, const Range& r1) ARTS_NOEXCEPT
   : MatrixView(d, r0, r1) {
+    ARTS_ASSERT(not d or matpack_is_allocated(d),
+                "Data must be allocated with matpack_allocate");
     ARTS_ASSERT(r0.get_extent() >= 0, "Must have size. Has: ", r0.get_extent());
     ARTS_ASSERT(r1.get_extent() >= 0, "Must have size. Has: ", r1.get_extent());
   }
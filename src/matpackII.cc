@@ -365,6 +365,26 @@ void Sparse::resize(Index r, Index c) {
   matrix.resize((int)r, (int)c);
 }
 
+//! Resize function for filling the compressed storage directly.
+/*!
+  All data is lost. Storage for nnz elements is allocated, and all row
+  starts are set to zero. The caller must fill the arrays returned by
+  get_element_pointer, get_column_index_pointer and get_row_start_pointer
+  with a valid compressed row storage of nnz elements.
+
+  \param r New row dimension.
+  \param c New column dimension.
+  \param nnz Number of non-zero elements.
+*/
+void Sparse::resize(Index r, Index c, Index nnz) {
+  ARTS_ASSERT(0 <= r);
+  ARTS_ASSERT(0 <= c);
+  ARTS_ASSERT(0 <= nnz);
+
+  matrix.resize((int)r, (int)c);
+  matrix.resizeNonZeros((int)nnz);
+}
+
 //! Output operator for Sparse.
 /*!
   \param os Output stream.
@@ -81,6 +81,7 @@ class Sparse {
 
   // Resize function:
   void resize(Index r, Index c);
+  void resize(Index r, Index c, Index nnz);
 
   // Member functions:
   bool empty() const;
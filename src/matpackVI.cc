@@ -24,6 +24,7 @@
 
 #include "matpackVI.h"
 #include "exceptions.h"
+#include "matpack_arena.h"
 
 // Functions for ConstTensor6View:
 // ------------------------------
@@ -2024,7 +2025,7 @@ void copy(Numeric x, Iterator6D target, const Iterator6D& end) {
 /** Constructor setting size. This constructor has to set the strides
     in the page and row ranges correctly! */
 Tensor6::Tensor6(Index v, Index s, Index b, Index p, Index r, Index c)
-    : Tensor6View(new Numeric[v * s * b * p * r * c],
+    : Tensor6View(matpack_allocate(v * s * b * p * r * c),
                   Range(0, v, s * b * p * r * c),
                   Range(0, s, b * p * r * c),
                   Range(0, b, p * r * c),
@@ -2037,7 +2038,7 @@ Tensor6::Tensor6(Index v, Index s, Index b, Index p, Index r, Index c)
 /** Constructor setting size and filling with constant value. */
 Tensor6::Tensor6(
     Index v, Index s, Index b, Index p, Index r, Index c, Numeric fill)
-    : Tensor6View(new Numeric[v * s * b * p * r * c],
+    : Tensor6View(matpack_allocate(v * s * b * p * r * c),
                   Range(0, v, s * b * p * r * c),
                   Range(0, s, b * p * r * c),
                   Range(0, b, p * r * c),
@@ -2053,8 +2054,8 @@ Tensor6::Tensor6(
     and copies the data. */
 Tensor6::Tensor6(const ConstTensor6View& m)
     : Tensor6View(
-          new Numeric[m.nvitrines() * m.nshelves() * m.nbooks() * m.npages() *
-                      m.nrows() * m.ncols()],
+          matpack_allocate(m.nvitrines() * m.nshelves() * m.nbooks() * m.npages() *
+                      m.nrows() * m.ncols()),
           Range(0,
                 m.nvitrines(),
                 m.nshelves() * m.nbooks() * m.npages() * m.nrows() * m.ncols()),
@@ -2071,8 +2072,8 @@ Tensor6::Tensor6(const ConstTensor6View& m)
     and copies the data. */
 Tensor6::Tensor6(const Tensor6& m)
     : Tensor6View(
-          new Numeric[m.nvitrines() * m.nshelves() * m.nbooks() * m.npages() *
-                      m.nrows() * m.ncols()],
+          matpack_allocate(m.nvitrines() * m.nshelves() * m.nbooks() * m.npages() *
+                      m.nrows() * m.ncols()),
           Range(0,
                 m.nvitrines(),
                 m.nshelves() * m.nbooks() * m.npages() * m.nrows() * m.ncols()),
@@ -2136,7 +2137,7 @@ Tensor6& Tensor6::operator=(const Tensor6& x) {
 //! Move assignment operator from another tensor.
 Tensor6& Tensor6::operator=(Tensor6&& x) noexcept {
   if (this != &x) {
-    delete[] mdata;
+    matpack_deallocate(mdata);
     mdata = x.mdata;
     mvr = x.mvr;
     msr = x.msr;
@@ -2178,8 +2179,8 @@ void Tensor6::resize(Index v, Index s, Index b, Index p, Index r, Index c) {
 
   if (mvr.mextent != v || msr.mextent != s || mbr.mextent != b ||
       mpr.mextent != p || mrr.mextent != r || mcr.mextent != c) {
-    delete[] mdata;
-    mdata = new Numeric[v * s * b * p * r * c];
+    matpack_deallocate(mdata);
+    mdata = matpack_allocate(v * s * b * p * r * c);
 
     mvr.mstart = 0;
     mvr.mextent = v;
@@ -2223,7 +2224,7 @@ void swap(Tensor6& t1, Tensor6& t2) {
 Tensor6::~Tensor6() {
   //   cout << "Destroying a Tensor6:\n"
   //        << *this << "\n........................................\n";
-  delete[] mdata;
+  matpack_deallocate(mdata);
 }
 
 /** A generic transform function for tensors, which can be used to
@@ -1099,8 +1099,10 @@ class Tensor6 : public Tensor6View {
   
   /*! Construct from known data
    * 
-   * Note that this will call delete on the pointer if it is still valid
-   * at the end of the lifetime of this variable
+   * Takes ownership of d, which is freed with matpack_deallocate at the
+   * end of the lifetime of this variable. d must therefore come from
+   * matpack_allocate, e.g. the data of another matpack object that gives
+   * it up (see Tensor7::reduce_rank). Memory from new[] is not allowed.
    * 
    * @param[in] d - A pointer to some raw data
    * @param[in] r0 - The Range along the first dimension
@@ -1112,6 +1114,8 @@ class Tensor6 : public Tensor6View {
    */
   Tensor6(Numeric* d, const Range& r0, const Range& r1, const Range& r2, const Range& r3, const Range& r4, const Range& r5) ARTS_NOEXCEPT
   : Tensor6View(d, r0, r1, r2, r3, r4, r5) {
+    ARTS_ASSERT(not d or matpack_is_allocated(d),
+                "Data must be allocated with matpack_allocate");
     ARTS_ASSERT (not (r0.get_extent() < 0), "Must have size");
     ARTS_ASSERT (not (r1.get_extent() < 0), "Must have size");
     ARTS_ASSERT (not (r2.get_extent() < 0), "Must have size");
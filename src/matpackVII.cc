@@ -24,6 +24,7 @@
 
 #include "matpackVII.h"
 #include "exceptions.h"
+#include "matpack_arena.h"
 
 // Functions for ConstTensor7View:
 // ------------------------------
@@ -5322,7 +5323,7 @@ void copy(Numeric x, Iterator7D target, const Iterator7D& end) {
 /** Constructor setting size. This constructor has to set the strides
     in the page and row ranges correctly! */
 Tensor7::Tensor7(Index l, Index v, Index s, Index b, Index p, Index r, Index c)
-    : Tensor7View(new Numeric[l * v * s * b * p * r * c],
+    : Tensor7View(matpack_allocate(l * v * s * b * p * r * c),
                   Range(0, l, v * s * b * p * r * c),
                   Range(0, v, s * b * p * r * c),
                   Range(0, s, b * p * r * c),
@@ -5336,7 +5337,7 @@ Tensor7::Tensor7(Index l, Index v, Index s, Index b, Index p, Index r, Index c)
 /** Constructor setting size and filling with constant value. */
 Tensor7::Tensor7(
     Index l, Index v, Index s, Index b, Index p, Index r, Index c, Numeric fill)
-    : Tensor7View(new Numeric[l * v * s * b * p * r * c],
+    : Tensor7View(matpack_allocate(l * v * s * b * p * r * c),
                   Range(0, l, v * s * b * p * r * c),
                   Range(0, v, s * b * p * r * c),
                   Range(0, s, b * p * r * c),
@@ -5353,8 +5354,8 @@ Tensor7::Tensor7(
     and copies the data. */
 Tensor7::Tensor7(const ConstTensor7View& m)
     : Tensor7View(
-          new Numeric[m.nlibraries() * m.nvitrines() * m.nshelves() *
-                      m.nbooks() * m.npages() * m.nrows() * m.ncols()],
+          matpack_allocate(m.nlibraries() * m.nvitrines() * m.nshelves() *
+                      m.nbooks() * m.npages() * m.nrows() * m.ncols()),
           Range(0,
                 m.nlibraries(),
                 m.nvitrines() * m.nshelves() * m.nbooks() * m.npages() *
@@ -5375,8 +5376,8 @@ Tensor7::Tensor7(const ConstTensor7View& m)
     and copies the data. */
 Tensor7::Tensor7(const Tensor7& m)
     : Tensor7View(
-          new Numeric[m.nlibraries() * m.nvitrines() * m.nshelves() *
-                      m.nbooks() * m.npages() * m.nrows() * m.ncols()],
+          matpack_allocate(m.nlibraries() * m.nvitrines() * m.nshelves() *
+                      m.nbooks() * m.npages() * m.nrows() * m.ncols()),
           Range(0,
                 m.nlibraries(),
                 m.nvitrines() * m.nshelves() * m.nbooks() * m.npages() *
@@ -5445,7 +5446,7 @@ Tensor7& Tensor7::operator=(const Tensor7& x) {
 //! Copy assignment operator from another tensor.
 Tensor7& Tensor7::operator=(Tensor7&& x) noexcept {
   if (this != &x) {
-    delete[] mdata;
+    matpack_deallocate(mdata);
     mdata = x.mdata;
     mlr = x.mlr;
     mvr = x.mvr;
@@ -5492,8 +5493,8 @@ void Tensor7::resize(
   if (mlr.mextent != l || mvr.mextent != v || msr.mextent != s ||
       mbr.mextent != b || mpr.mextent != p || mrr.mextent != r ||
       mcr.mextent != c) {
-    delete[] mdata;
-    mdata = new Numeric[l * v * s * b * p * r * c];
+    matpack_deallocate(mdata);
+    mdata = matpack_allocate(l * v * s * b * p * r * c);
 
     mlr.mstart = 0;
     mlr.mextent = l;
@@ -5542,7 +5543,7 @@ void swap(Tensor7& t1, Tensor7& t2) {
 Tensor7::~Tensor7() {
   //   cout << "Destroying a Tensor7:\n"
   //        << *this << "\n........................................\n";
-  delete[] mdata;
+  matpack_deallocate(mdata);
 }
 
 /** A generic transform function for tensors, which can be used to
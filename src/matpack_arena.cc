@@ -0,0 +1,167 @@
+/* Copyright (C) 2026, The ARTS Developers.
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/**
+ * @file   matpack_arena.cc
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ *
+ * @brief  Memory allocation for the data of Vector, Matrix and Tensor3-7.
+ */
+
+#include "matpack_arena.h"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace {
+
+/** Size of one arena block in bytes. */
+constexpr size_t arena_block_size = 1 << 20;
+
+/** Larger allocations always go to the heap. */
+constexpr size_t arena_max_allocation = arena_block_size / 8;
+
+/** One block of an arena, followed by the memory handed out. */
+struct ArenaBlock {
+  /** Live allocations from this block plus one while the thread owns it. */
+  std::atomic<Index> refs;
+  /** Bytes handed out, including the headers. */
+  size_t used;
+};
+
+/** Header in front of every allocation. */
+struct alignas(16) AllocationHeader {
+  /** Block of the allocation, nullptr for heap allocations. */
+  ArenaBlock* block;
+  /** allocation_tag while the allocation is live. */
+  std::uint64_t tag;
+};
+
+/** Marks live allocations, see matpack_is_allocated. */
+constexpr std::uint64_t allocation_tag = 0x4d415450414b4152;  // "MATPAKAR"
+
+constexpr size_t arena_data_offset =
+    (sizeof(ArenaBlock) + alignof(AllocationHeader) - 1) /
+    alignof(AllocationHeader) * alignof(AllocationHeader);
+
+void release_block(ArenaBlock* block) noexcept {
+  if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    block->~ArenaBlock();
+    ::operator delete(block);
+  }
+}
+
+/** The arena of one thread. */
+class ThreadArena {
+ public:
+  ThreadArena() = default;
+  ThreadArena(const ThreadArena&) = delete;
+  ThreadArena& operator=(const ThreadArena&) = delete;
+
+  /** Give up ownership. Blocks still in use are freed by the last
+      matpack_deallocate. */
+  ~ThreadArena() {
+    for (auto block : mblocks) release_block(block);
+  }
+
+  void* allocate(size_t bytes) {
+    if (!mcurrent || mcurrent->used + bytes > arena_block_size) next_block();
+
+    void* p = reinterpret_cast<char*>(mcurrent) + arena_data_offset +
+              mcurrent->used;
+    mcurrent->used += bytes;
+    mcurrent->refs.fetch_add(1, std::memory_order_relaxed);
+    static_cast<AllocationHeader*>(p)->block = mcurrent;
+    static_cast<AllocationHeader*>(p)->tag = allocation_tag;
+    return p;
+  }
+
+  /** Nesting depth of MatpackArenaScope on this thread. */
+  Index depth{0};
+
+ private:
+  /** Switch to a block without live allocations, or create a new one. */
+  void next_block() {
+    // Only this thread adds references, so a block whose only reference
+    // is ours stays free.
+    for (auto block : mblocks)
+      if (block->refs.load(std::memory_order_acquire) == 1) {
+        block->used = 0;
+        mcurrent = block;
+        return;
+      }
+
+    void* memory = ::operator new(arena_data_offset + arena_block_size);
+    mcurrent = new (memory) ArenaBlock;
+    mcurrent->refs.store(1, std::memory_order_relaxed);
+    mcurrent->used = 0;
+    mblocks.push_back(mcurrent);
+  }
+
+  std::vector<ArenaBlock*> mblocks;
+  ArenaBlock* mcurrent{nullptr};
+};
+
+thread_local ThreadArena thread_arena;
+
+}  // namespace
+
+Numeric* matpack_allocate(Index n) {
+  // Round up to keep the next header aligned
+  const size_t bytes =
+      (sizeof(AllocationHeader) + (size_t)n * sizeof(Numeric) +
+       alignof(AllocationHeader) - 1) /
+      alignof(AllocationHeader) * alignof(AllocationHeader);
+
+  void* p;
+  if (thread_arena.depth && bytes <= arena_max_allocation) {
+    p = thread_arena.allocate(bytes);
+  } else {
+    p = ::operator new(bytes);
+    static_cast<AllocationHeader*>(p)->block = nullptr;
+    static_cast<AllocationHeader*>(p)->tag = allocation_tag;
+  }
+
+  return reinterpret_cast<Numeric*>(static_cast<AllocationHeader*>(p) + 1);
+}
+
+void matpack_deallocate(Numeric* p) {
+  if (!p) return;
+
+  AllocationHeader* header = reinterpret_cast<AllocationHeader*>(p) - 1;
+  ARTS_ASSERT(header->tag == allocation_tag,
+              "Matpack data was not allocated with matpack_allocate "
+              "or is freed twice")
+  header->tag = 0;
+  if (header->block)
+    release_block(header->block);
+  else
+    ::operator delete(header);
+}
+
+bool matpack_is_allocated(const Numeric* p) noexcept {
+  return p and
+         (reinterpret_cast<const AllocationHeader*>(p) - 1)->tag ==
+             allocation_tag;
+}
+
+MatpackArenaScope::MatpackArenaScope() { thread_arena.depth++; }
+
+MatpackArenaScope::~MatpackArenaScope() { thread_arena.depth--; }
@@ -0,0 +1,86 @@
+/* Copyright (C) 2026, The ARTS Developers.
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/**
+ * @file   matpack_arena.h
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ *
+ * @brief  Memory allocation for the data of Vector, Matrix and Tensor3-7.
+ *
+ * By default the data is allocated on the heap. Inside a
+ * MatpackArenaScope, small allocations are instead taken from a
+ * per-thread arena of large blocks by bumping a pointer. This avoids
+ * heap traffic and allocator lock contention for the many temporaries
+ * created along the propagation path.
+ *
+ * Every allocation remembers which block it came from. A block is reset
+ * and reused by its thread as soon as all allocations from it have been
+ * freed. Containers can therefore safely outlive the scope in which
+ * they were allocated and can be freed by any thread. Such containers
+ * only keep their block from being reused.
+ */
+
+#ifndef matpack_arena_h
+#define matpack_arena_h
+
+#include "matpack.h"
+
+/** Allocate data for n Numerics.
+ *
+ * The memory must be freed with matpack_deallocate.
+ *
+ * @param[in] n Number of elements.
+ * @return Pointer to the uninitialized data.
+ */
+Numeric* matpack_allocate(Index n);
+
+/** Free data allocated with matpack_allocate.
+ *
+ * Debug builds assert that p comes from matpack_allocate and is not yet
+ * freed.
+ *
+ * @param[in] p Pointer returned by matpack_allocate, or nullptr.
+ */
+void matpack_deallocate(Numeric* p);
+
+/** Check that data was allocated with matpack_allocate.
+ *
+ * Reads the allocation header in front of p, so this is only meant for
+ * assertions. Memory from new[] or malloc is not recognized reliably, but
+ * is very unlikely to pass.
+ *
+ * @param[in] p Pointer to the data.
+ * @return True if p was returned by matpack_allocate and not yet freed.
+ */
+bool matpack_is_allocated(const Numeric* p) noexcept;
+
+/** Use the arena of the current thread for matpack data.
+ *
+ * While an object of this class exists, matpack_allocate takes small
+ * allocations of the current thread from the arena. Scopes can be nested.
+ */
+class MatpackArenaScope {
+ public:
+  MatpackArenaScope();
+  ~MatpackArenaScope();
+
+  MatpackArenaScope(const MatpackArenaScope&) = delete;
+  MatpackArenaScope& operator=(const MatpackArenaScope&) = delete;
+};
+
+#endif  // matpack_arena_h
@@ -1791,6 +1791,31 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(create_mdrecord(
+      NAME("abs_lookupReadMapped"),
+      DESCRIPTION(
+          "Reads a gas absorption lookup table written by *abs_lookupWriteMapped*.\n"
+          "\n"
+          "The file is memory-mapped instead of read, so this is almost\n"
+          "instantaneous also for very large tables. The cross sections are\n"
+          "only loaded from disk when absorption is extracted, and ARTS\n"
+          "processes on the same machine that map the same file share one\n"
+          "copy of it in memory.\n"
+          "\n"
+          "The table stays mapped through *abs_lookupAdapt* if it already has\n"
+          "exactly the species and frequencies of the calculation. Otherwise\n"
+          "the needed part is copied to memory by *abs_lookupAdapt*.\n"),
+      AUTHORS("The ARTS Developers"),
+      OUT("abs_lookup"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN(),
+      GIN("filename"),
+      GIN_TYPE("String"),
+      GIN_DEFAULT(NODEF),
+      GIN_DESC("Name of the file.")));
+
   md_data_raw.push_back(create_mdrecord(
       NAME("abs_lookupSetup"),
       DESCRIPTION(
@@ -2047,6 +2072,35 @@ void define_md_data_raw() {
       GIN_TYPE(),
       GIN_DEFAULT(),
       GIN_DESC()));
+
+  md_data_raw.push_back(create_mdrecord(
+      NAME("abs_lookupWriteMapped"),
+      DESCRIPTION(
+          "Writes a gas absorption lookup table that can be memory-mapped.\n"
+          "\n"
+          "The file is read by *abs_lookupReadMapped*. It holds the table\n"
+          "without cross sections as XML, followed by the exact grids and the\n"
+          "cross sections in the byte order of this machine, one pressure\n"
+          "level after the other.\n"
+          "\n"
+          "The cross sections can be stored as:\n"
+          "  \"Float64\": Exactly as in memory.\n"
+          "  \"Float32\": Single precision, half the size.\n"
+          "  \"ScaledInt16\": 16 bit integers with one scale factor per\n"
+          "      frequency row, a quarter of the size. This keeps about 4.5\n"
+          "      significant digits of the largest value in each row, so weak\n"
+          "      absorption next to strong lines is not well represented.\n"),
+      AUTHORS("The ARTS Developers"),
+      OUT(),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("abs_lookup"),
+      GIN("filename", "storage"),
+      GIN_TYPE("String", "String"),
+      GIN_DEFAULT(NODEF, "Float64"),
+      GIN_DESC("Name of the file.",
+               "How to store the cross sections, see above.")));
   
   md_data_raw.push_back(create_mdrecord(
       NAME("abs_nlteFromRaw"),
@@ -2397,7 +2451,19 @@ void define_md_data_raw() {
       NAME("abs_xsec_per_speciesAddLines"),
       DESCRIPTION(
           "Calculates the line spectrum for both attenuation and phase\n"
-          "for each tag group and adds it to abs_xsec_per_species.\n"),
+          "for each tag group and adds it to abs_xsec_per_species.\n"
+          "\n"
+          "The Faddeeva function of Voigt lines can be evaluated by a faster\n"
+          "approximation at reduced accuracy.  Available options:\n"
+          "\t\"Faddeeva\"           \t - \t Reference implementation\n"
+          "\t\"HumlicekWeideman32\" \t - \t Relative error below 1e-6\n"
+          "\t\"HumlicekWeideman24\" \t - \t Relative error below 1e-4\n"
+          "\n"
+          "Only lines that reach *f_grid* through their cutoff are computed, and\n"
+          "only on the part of *f_grid* inside their cutoff.  A positive\n"
+          "*lineshape_window* further limits every line to that many (approximate)\n"
+          "Voigt half-widths around its center.  This is an approximation: the\n"
+          "line wings outside the window are ignored without any cutoff correction.\n"),
       AUTHORS("Richard Larsson"),
       OUT("abs_xsec_per_species",
           "src_xsec_per_species",
@@ -2422,10 +2488,11 @@ void define_md_data_raw() {
          "isotopologue_ratios",
          "partition_functions",
          "lbl_checked"),
-      GIN(),
-      GIN_TYPE(),
-      GIN_DEFAULT(),
-      GIN_DESC()));
+      GIN("faddeeva_algorithm", "lineshape_window"),
+      GIN_TYPE("String", "Numeric"),
+      GIN_DEFAULT("Faddeeva", "0"),
+      GIN_DESC("Algorithm for the Faddeeva function of Voigt lines",
+               "Number of Voigt half-widths around the line center to compute (0: no window)")));
 
   md_data_raw.push_back(create_mdrecord(
       NAME("abs_xsec_per_speciesAddPredefinedO2MPM2020"),
@@ -3961,6 +4028,40 @@ void define_md_data_raw() {
       GIN_DESC("Batch of atmospheres stored in one array of matrix",
                "Order/names of atmospheric fields.")));
 
+  md_data_raw.push_back(create_mdrecord(
+      NAME("Benchmark"),
+      DESCRIPTION(
+          "Times the execution of *benchmark_agenda*.\n"
+          "\n"
+          "The agenda is first executed *nwarmup* times without timing, and\n"
+          "then *nrepeat* times while measuring the wall time of each run.\n"
+          "Variables set inside the agenda are local to the agenda, so all\n"
+          "runs start from the same workspace state.\n"
+          "\n"
+          "Minimum, median, mean, standard deviation and maximum of the run\n"
+          "times are reported on verbosity level 1. The same numbers, together\n"
+          "with all run times, the number of threads and the time of the\n"
+          "benchmark are appended as one line of JSON to *filename*. Each call\n"
+          "adds one line, so the file can collect results of several\n"
+          "benchmarks and runs for regression tracking. The default file name\n"
+          "is <basename>.benchmark.jsonl.\n"
+          "\n"
+          "The benchmark set in controlfiles/benchmark uses this method, see\n"
+          "the make target \"benchmark\".\n"),
+      AUTHORS("The ARTS Developers"),
+      OUT(),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("benchmark_agenda"),
+      GIN("name", "nrepeat", "nwarmup", "filename"),
+      GIN_TYPE("String", "Index", "Index", "String"),
+      GIN_DEFAULT(NODEF, "5", "1", ""),
+      GIN_DESC("Name of the benchmark, used in the output.",
+               "Number of timed runs.",
+               "Number of untimed runs before the timed ones.",
+               "Name of the file to append the result to.")));
+
   md_data_raw.push_back(create_mdrecord(
       NAME("CIAInfo"),
       DESCRIPTION(
@@ -7337,7 +7438,17 @@ void define_md_data_raw() {
           "    i.e. only fully valid for scalar RT.\n"
           "If nothing else is stated, only the first column of *iy_aux* is filled,\n"
           "i.e. the column matching Stokes element I, while remaing columns are\n"
-          "are filled with zeros.\n"),
+          "are filled with zeros.\n"
+          "\n"
+          "By default the ppath points are calculated in parallel. For long\n"
+          "frequency grids and short propagation paths there are too few points\n"
+          "to keep all threads busy. Setting *f_block_size* splits *f_grid* into\n"
+          "blocks of that many frequencies, and each combination of ppath point\n"
+          "and block is then calculated in parallel. The block size does not\n"
+          "depend on the number of threads and the result is identical to the\n"
+          "unblocked calculation. Note that *propmat_clearsky_agenda* is then\n"
+          "called with parts of *f_grid*. A lookup table accepts these also\n"
+          "with abs_f_interp_order 0, as they are parts of its own grid.\n"),
       AUTHORS("Patrick Eriksson", "Richard Larsson", "Oliver Lemke"),
       OUT("iy",
           "iy_aux",
@@ -7389,10 +7500,11 @@ void define_md_data_raw() {
          "iy_transmittance",
          "rte_alonglos_v",
          "surface_props_data"),
-      GIN(),
-      GIN_TYPE(),
-      GIN_DEFAULT(),
-      GIN_DESC()));
+      GIN("f_block_size"),
+      GIN_TYPE("Index"),
+      GIN_DEFAULT("0"),
+      GIN_DESC("Number of frequencies per block. Blocks are calculated in "
+               "parallel, 0 means no blocking.")));
 
   /*
   md_data_raw.push_back
@@ -10180,7 +10292,33 @@ void define_md_data_raw() {
           "\n"
           "Only \"1\" and \"RJBT\" are allowed for *iy_unit*. The value of\n"
           "*mc_error* follows the selection for *iy_unit* (both for in- and\n"
-          "output.\n"),
+          "output.\n"
+          "\n"
+          "The photons are traced in parallel, one random number stream per\n"
+          "thread. The stop criteria are checked on the merged statistics of\n"
+          "all streams, after rounds of about a tenth of the photons traced\n"
+          "so far. For a given *mc_seed*, the result is reproducible as long\n"
+          "as the number of threads is not changed.\n"
+          "\n"
+          "Variance reduction methods can be selected with the GIN\n"
+          "*variance_reduction*. They keep the result unbiased, but reduce\n"
+          "the number of photons needed to reach *mc_std_err*:\n"
+          "  \"forced_collision\": Every photon is split at the first path\n"
+          "     into a part reaching the boundary of the atmosphere without\n"
+          "     collision and a part forced to collide before. For optically\n"
+          "     thin scenes. It is turned off if the transmission to the\n"
+          "     boundary is below 0.1.\n"
+          "  \"phase_importance\": New directions are drawn from a mixture\n"
+          "     of a Henyey-Greenstein and a uniform distribution and\n"
+          "     weighted with the phase function, instead of the rejection\n"
+          "     method. For strongly forward scattering particles. Requires\n"
+          "     totally or azimuthally randomly oriented particles.\n"
+          "  \"roulette\": Russian roulette for photons with low weight and\n"
+          "     splitting for photons with high weight. Mainly useful\n"
+          "     together with the other options, which give varying weights.\n"
+          "The error, the CPU time and the figure of merit\n"
+          "1/(error^2*CPU time) are reported at verbosity level 1, to\n"
+          "compare the efficiency of the options.\n"),
       AUTHORS("Cory Davis"),
       OUT("y",
           "mc_iteration_count",
@@ -10227,15 +10365,28 @@ void define_md_data_raw() {
          "mc_max_iter",
          "mc_min_iter",
          "mc_taustep_limit"),
-      GIN("l_mc_scat_order", "t_interp_order"),
-      GIN_TYPE("Index", "Index"),
-      GIN_DEFAULT("11", "1"),
+      GIN("l_mc_scat_order",
+          "t_interp_order",
+          "optprop_cache",
+          "variance_reduction"),
+      GIN_TYPE("Index", "Index", "Index", "ArrayOfString"),
+      GIN_DEFAULT("11", "1", "0", "[]"),
       GIN_DESC("The length to be given to *mc_scat_order*. Note that"
                " scattering orders equal and above this value will not"
                " be counted.",
                "Interpolation order of temperature for scattering data (so"
                " far only applied in phase matrix, not in extinction and"
-               " absorption.")));
+               " absorption.",
+               "Flag to calculate the extinction and absorption once at the"
+               " atmospheric grid points and to interpolate them along the"
+               " photon paths. This avoids executing"
+               " *propmat_clearsky_agenda* at every path point, but the"
+               " values between the grid points are then linear"
+               " interpolations. Particle properties are only cached for"
+               " totally randomly oriented particles.",
+               "Variance reduction methods to apply. Valid options are"
+               " \"forced_collision\", \"phase_importance\" and"
+               " \"roulette\", see above.")));
 
   md_data_raw.push_back(create_mdrecord(
       NAME("MCRadar"),
@@ -10266,7 +10417,11 @@ void define_md_data_raw() {
           "\n"
           "Here \"1\" and \"Ze\" are the allowed options for *iy_unit_radar*.\n"
           "The value of *mc_error* follows the selection for *iy_unit_radar*\n"
-          "(both for in- and output. See *yRadar* for details of the units.\n"),
+          "(both for in- and output. See *yRadar* for details of the units.\n"
+          "\n"
+          "As for *MCGeneral*, the photons are traced in parallel and the\n"
+          "result is reproducible for a given *mc_seed* and number of\n"
+          "threads.\n"),
       AUTHORS("Ian S. Adams"),
       OUT("y", "mc_error"),
       GOUT(),
@@ -14513,6 +14668,36 @@ void define_md_data_raw() {
       PASSWORKSPACE(false),
       PASSWSVNAMES(true)));
 
+  md_data_raw.push_back(create_mdrecord(
+      NAME("ReadXMLLazy"),
+      DESCRIPTION(
+          "As *ReadXML*, but the file is only read when the variable is\n"
+          "used for the first time.\n"
+          "\n"
+          "This method only checks that the file exists. The variable is\n"
+          "read when a method or agenda accesses it. Variables that are\n"
+          "never used are thus never read, which saves time and memory\n"
+          "for large data like scattering data or lookup tables that are\n"
+          "only needed in some runs of a controlfile.\n"
+          "\n"
+          "The file must not change until the variable is used. Errors in\n"
+          "the file are reported by the method that first uses the variable.\n"),
+      AUTHORS("The ARTS Developers"),
+      OUT(),
+      GOUT("out"),
+      GOUT_TYPE("Any"),
+      GOUT_DESC("Variable to be read."),
+      IN(),
+      GIN("filename"),
+      GIN_TYPE("String"),
+      GIN_DEFAULT(""),
+      GIN_DESC("Name of the XML file."),
+      SETMETHOD(false),
+      AGENDAMETHOD(false),
+      USES_TEMPLATES(true),
+      PASSWORKSPACE(true),
+      PASSWSVNAMES(true)));
+
   md_data_raw.push_back(create_mdrecord(
       NAME("ReadXMLIndexed"),
       DESCRIPTION("As *ReadXML*, but reads indexed file names.\n"
@@ -19555,6 +19740,27 @@ void define_md_data_raw() {
       GIN_DESC("The Matrix to multiply (dimension mxn).",
                "The original Vector (dimension n).")));
 
+  md_data_raw.push_back(create_mdrecord(
+      NAME("VectorSparseMultiply"),
+      DESCRIPTION(
+          "Multiply a Vector with a Sparse and store the result in another\n"
+          "Vector.\n"
+          "\n"
+          "As *VectorMatrixMultiply*, but for a sparse matrix, e.g. to apply\n"
+          "*sensor_response* to spectra. It is ok if input and output Vector\n"
+          "are the same.\n"),
+      AUTHORS("The ARTS Developers"),
+      OUT(),
+      GOUT("out"),
+      GOUT_TYPE("Vector"),
+      GOUT_DESC("The result of the multiplication (dimension m)."),
+      IN(),
+      GIN("m", "v"),
+      GIN_TYPE("Sparse", "Vector"),
+      GIN_DEFAULT(NODEF, NODEF),
+      GIN_DESC("The Sparse to multiply (dimension mxn).",
+               "The original Vector (dimension n).")));
+
   md_data_raw.push_back(create_mdrecord(
       NAME("VectorNLinSpace"),
       DESCRIPTION(
@@ -30,6 +30,7 @@
 #include <cfloat>
 #include <sstream>
 
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "geodetic.h"
 #include "mc_interp.h"
@@ -536,6 +537,246 @@ void cloud_atm_vars_by_gp(VectorView pressure,
   }
 }
 
+void mc_optprop_cache_calc(Workspace& ws,
+                           MCOptPropCache& cache,
+                           const Agenda& propmat_clearsky_agenda,
+                           const Index stokes_dim,
+                           const Index f_index,
+                           const Vector& f_grid,
+                           const Vector& p_grid,
+                           const Tensor3& t_field,
+                           const Tensor4& vmr_field,
+                           const ArrayOfIndex& cloudbox_limits,
+                           const Tensor4& pnd_field,
+                           const ArrayOfArrayOfSingleScatteringData& scat_data) {
+  const Index np = t_field.npages();
+  const Index nlat = t_field.nrows();
+  const Index nlon = t_field.ncols();
+  const Vector f_mono = f_grid[Range(f_index, 1)];
+
+  cache.gas_ext_mat.resize(np, nlat, nlon, stokes_dim, stokes_dim);
+  cache.gas_abs_vec.resize(np, nlat, nlon, stokes_dim);
+  cache.par_ext_mat.resize(0, 0, 0, 0, 0);
+  cache.par_abs_vec.resize(0, 0, 0, 0);
+
+  String fail_msg;
+  bool failed = false;
+
+  // Gas part, one agenda execution per grid point
+#pragma omp parallel for schedule(dynamic) if (!arts_omp_in_parallel())
+  for (Index i = 0; i < np * nlat * nlon; i++) {
+    if (failed) continue;
+
+    const Index ip = i / (nlat * nlon);
+    const Index ilat = (i / nlon) % nlat;
+    const Index ilon = i % nlon;
+
+    try {
+      PooledWorkspace l_ws(ws);
+
+      StokesVector local_abs_vec;
+      StokesVector local_nlte_source_dummy;
+      PropagationMatrix local_ext_mat;
+      PropagationMatrix local_propmat_clearsky;
+      ArrayOfPropagationMatrix local_partial_dummy;
+      ArrayOfStokesVector local_dnlte_source_dx_dummy;
+      const Vector rtp_mag_dummy(3, 0);
+      const Vector ppath_los_dummy;
+      const EnergyLevelMap nlte_dummy;
+
+      propmat_clearsky_agendaExecute(*l_ws,
+                                     local_propmat_clearsky,
+                                     local_nlte_source_dummy,
+                                     local_partial_dummy,
+                                     local_dnlte_source_dx_dummy,
+                                     ArrayOfRetrievalQuantity(0),
+                                     f_mono,
+                                     rtp_mag_dummy,
+                                     ppath_los_dummy,
+                                     p_grid[ip],
+                                     t_field(ip, ilat, ilon),
+                                     nlte_dummy,
+                                     vmr_field(joker, ip, ilat, ilon),
+                                     propmat_clearsky_agenda);
+
+      opt_prop_sum_propmat_clearsky(
+          local_ext_mat, local_abs_vec, local_propmat_clearsky);
+
+      local_ext_mat.MatrixAtPosition(
+          cache.gas_ext_mat(ip, ilat, ilon, joker, joker));
+      cache.gas_abs_vec(ip, ilat, ilon, joker) =
+          local_abs_vec.VectorAtPosition();
+    } catch (const std::exception& e) {
+#pragma omp critical(mc_optprop_cache_calc_fail)
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
+    }
+  }
+
+  if (failed) throw runtime_error(fail_msg);
+
+  if (is_anyptype_nonTotRan(scat_data)) return;
+
+  // Particle part, one call per pressure level of the cloudbox. As the
+  // particles are totally randomly oriented, any direction will do.
+  const Index np_cloud = cloudbox_limits[1] - cloudbox_limits[0] + 1;
+  const Index nlat_cloud = cloudbox_limits[3] - cloudbox_limits[2] + 1;
+  const Index nlon_cloud = cloudbox_limits[5] - cloudbox_limits[4] + 1;
+  const Index nlevel = nlat_cloud * nlon_cloud;
+
+  cache.par_ext_mat.resize(
+      np_cloud, nlat_cloud, nlon_cloud, stokes_dim, stokes_dim);
+  cache.par_abs_vec.resize(np_cloud, nlat_cloud, nlon_cloud, stokes_dim);
+
+#pragma omp parallel for schedule(dynamic) if (!arts_omp_in_parallel())
+  for (Index ip = 0; ip < np_cloud; ip++) {
+    if (failed) continue;
+
+    try {
+      Vector t_level(nlevel);
+      Matrix pnd_level(pnd_field.nbooks(), nlevel);
+      for (Index ilat = 0; ilat < nlat_cloud; ilat++) {
+        for (Index ilon = 0; ilon < nlon_cloud; ilon++) {
+          const Index it = ilat * nlon_cloud + ilon;
+          t_level[it] = t_field(cloudbox_limits[0] + ip,
+                               cloudbox_limits[2] + ilat,
+                               cloudbox_limits[4] + ilon);
+          pnd_level(joker, it) = pnd_field(joker, ip, ilat, ilon);
+        }
+      }
+
+      ArrayOfArrayOfTensor5 ext_mat_Nse;
+      ArrayOfArrayOfTensor4 abs_vec_Nse;
+      ArrayOfArrayOfIndex ptypes_Nse;
+      Matrix t_ok;
+      ArrayOfTensor5 ext_mat_ssbulk;
+      ArrayOfTensor4 abs_vec_ssbulk;
+      ArrayOfIndex ptype_ssbulk;
+      Tensor5 ext_mat_bulk;
+      Tensor4 abs_vec_bulk;
+      Index ptype_bulk;
+      Matrix dir_array(1, 2, 0.);
+
+      opt_prop_NScatElems(ext_mat_Nse,
+                          abs_vec_Nse,
+                          ptypes_Nse,
+                          t_ok,
+                          scat_data,
+                          stokes_dim,
+                          t_level,
+                          dir_array,
+                          f_index);
+      opt_prop_ScatSpecBulk(ext_mat_ssbulk,
+                            abs_vec_ssbulk,
+                            ptype_ssbulk,
+                            ext_mat_Nse,
+                            abs_vec_Nse,
+                            ptypes_Nse,
+                            pnd_level,
+                            t_ok);
+      opt_prop_Bulk(ext_mat_bulk,
+                    abs_vec_bulk,
+                    ptype_bulk,
+                    ext_mat_ssbulk,
+                    abs_vec_ssbulk,
+                    ptype_ssbulk);
+
+      for (Index ilat = 0; ilat < nlat_cloud; ilat++) {
+        for (Index ilon = 0; ilon < nlon_cloud; ilon++) {
+          const Index it = ilat * nlon_cloud + ilon;
+          cache.par_ext_mat(ip, ilat, ilon, joker, joker) =
+              ext_mat_bulk(0, it, 0, joker, joker);
+          cache.par_abs_vec(ip, ilat, ilon, joker) =
+              abs_vec_bulk(0, it, 0, joker);
+        }
+      }
+    } catch (const std::exception& e) {
+#pragma omp critical(mc_optprop_cache_calc_fail)
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
+    }
+  }
+
+  if (failed) throw runtime_error(fail_msg);
+}
+
+void cached_rt_vars_at_gp(MatrixView ext_mat_mono,
+                          VectorView abs_vec_mono,
+                          VectorView pnd_vec,
+                          Numeric& temperature,
+                          const MCOptPropCache& cache,
+                          const bool inside_cloud,
+                          const GridPos& gp_p,
+                          const GridPos& gp_lat,
+                          const GridPos& gp_lon,
+                          ConstTensor3View t_field,
+                          const ArrayOfIndex& cloudbox_limits,
+                          ConstTensor4View pnd_field) {
+  const Index stokes_dim = abs_vec_mono.nelem();
+  Vector itw(8);
+
+  interpweights(itw, gp_p, gp_lat, gp_lon);
+  temperature = interp(itw, t_field, gp_p, gp_lat, gp_lon);
+  for (Index i = 0; i < stokes_dim; i++) {
+    abs_vec_mono[i] = interp(
+        itw, cache.gas_abs_vec(joker, joker, joker, i), gp_p, gp_lat, gp_lon);
+    for (Index j = 0; j < stokes_dim; j++) {
+      ext_mat_mono(i, j) = interp(itw,
+                                  cache.gas_ext_mat(joker, joker, joker, i, j),
+                                  gp_p,
+                                  gp_lat,
+                                  gp_lon);
+    }
+  }
+
+  if (!inside_cloud) {
+    pnd_vec = 0.0;
+    return;
+  }
+
+  ARTS_ASSERT(cache.has_particles());
+
+  // Grid positions inside the cloudbox, as in cloud_atm_vars_by_gp
+  GridPos gp_p_cloud = gp_p;
+  GridPos gp_lat_cloud = gp_lat;
+  GridPos gp_lon_cloud = gp_lon;
+  gp_p_cloud.idx -= cloudbox_limits[0];
+  gp_lat_cloud.idx -= cloudbox_limits[2];
+  gp_lon_cloud.idx -= cloudbox_limits[4];
+  gridpos_upperend_check(gp_p_cloud, cloudbox_limits[1] - cloudbox_limits[0]);
+  gridpos_upperend_check(gp_lat_cloud,
+                         cloudbox_limits[3] - cloudbox_limits[2]);
+  gridpos_upperend_check(gp_lon_cloud,
+                         cloudbox_limits[5] - cloudbox_limits[4]);
+
+  interpweights(itw, gp_p_cloud, gp_lat_cloud, gp_lon_cloud);
+  for (Index i_se = 0; i_se < pnd_field.nbooks(); i_se++) {
+    pnd_vec[i_se] = interp(itw,
+                           pnd_field(i_se, joker, joker, joker),
+                           gp_p_cloud,
+                           gp_lat_cloud,
+                           gp_lon_cloud);
+  }
+  for (Index i = 0; i < stokes_dim; i++) {
+    abs_vec_mono[i] += interp(itw,
+                              cache.par_abs_vec(joker, joker, joker, i),
+                              gp_p_cloud,
+                              gp_lat_cloud,
+                              gp_lon_cloud);
+    for (Index j = 0; j < stokes_dim; j++) {
+      ext_mat_mono(i, j) += interp(itw,
+                                   cache.par_ext_mat(joker, joker, joker, i, j),
+                                   gp_p_cloud,
+                                   gp_lat_cloud,
+                                   gp_lon_cloud);
+    }
+  }
+}
+
 void ext_mat_case(Index& icase,
                   ConstMatrixView ext_mat,
                   const Index stokes_dim) {
@@ -886,7 +1127,9 @@ void mcPathTraceGeneral(Workspace& ws,
                         const ArrayOfIndex& cloudbox_limits,
                         const Tensor4& pnd_field,
                         const ArrayOfArrayOfSingleScatteringData& scat_data,
-                        const Verbosity& verbosity) {
+                        const Verbosity& verbosity,
+                        const MCOptPropCache* optprop_cache,
+                        const Numeric r_forced) {
   ArrayOfMatrix evol_opArray(2);
   ArrayOfMatrix ext_matArray(2);
   ArrayOfVector abs_vecArray(2);
@@ -949,7 +1192,20 @@ void mcPathTraceGeneral(Workspace& ws,
                                        3);
 
   // Determine radiative properties at point
-  if (inside_cloud) {
+  if (optprop_cache && (!inside_cloud || optprop_cache->has_particles())) {
+    cached_rt_vars_at_gp(ext_mat_mono,
+                         abs_vec_mono,
+                         pnd_vec,
+                         temperature,
+                         *optprop_cache,
+                         inside_cloud,
+                         ppath_step.gp_p[0],
+                         ppath_step.gp_lat[0],
+                         ppath_step.gp_lon[0],
+                         t_field,
+                         cloudbox_limits,
+                         pnd_field);
+  } else if (inside_cloud) {
     cloudy_rt_vars_at_gp(ws,
                          ext_mat_mono,
                          abs_vec_mono,
@@ -992,7 +1248,7 @@ void mcPathTraceGeneral(Workspace& ws,
   pnd_vecArray[1] = pnd_vec;
 
   //draw random number to determine end point
-  Numeric r = rng.draw();
+  const Numeric r = r_forced < 0 ? rng.draw() : r_forced;
 
   termination_flag = 0;
 
@@ -1055,7 +1311,21 @@ void mcPathTraceGeneral(Workspace& ws,
         ip++;
       }
 
-      if (inside_cloud) {
+      if (optprop_cache &&
+          (!inside_cloud || optprop_cache->has_particles())) {
+        cached_rt_vars_at_gp(ext_mat_mono,
+                             abs_vec_mono,
+                             pnd_vec,
+                             temperature,
+                             *optprop_cache,
+                             inside_cloud,
+                             ppath_step.gp_p[ip],
+                             ppath_step.gp_lat[ip],
+                             ppath_step.gp_lon[ip],
+                             t_field,
+                             cloudbox_limits,
+                             pnd_field);
+      } else if (inside_cloud) {
         cloudy_rt_vars_at_gp(ws,
                              ext_mat_mono,
                              abs_vec_mono,
@@ -1148,6 +1418,9 @@ void mcPathTraceGeneral(Workspace& ws,
     rte_pos = ppath_step.pos(ip, joker);
     rte_los = ppath_step.los(ip, joker);
     g = evol_op(0, 0);
+  } else if (r == 0) {
+    // Traced to the boundary, but the transmission vanished on the way
+    g = 0;
   } else {
     //find position...and evol_op..and everything else required at the new
     //scattering/emission point
@@ -1610,6 +1883,201 @@ void Sample_los(VectorView new_rte_los,
   g_los_csc_theta = Z(0, 0) / Csca;
 }
 
+void Sample_los_importance(VectorView new_rte_los,
+                           Numeric& g_los_csc_theta,
+                           MatrixView Z,
+                           Rng& rng,
+                           ConstVectorView rte_los,
+                           const ArrayOfArrayOfSingleScatteringData& scat_data,
+                           const Index f_index,
+                           const Index stokes_dim,
+                           ConstVectorView pnd_vec,
+                           ConstVectorView Z11intvector,
+                           ConstVectorView Z11cosvector,
+                           const Numeric rtp_temperature,
+                           const Index t_interp_order) {
+  // Fraction of the directions drawn from the uniform distribution
+  const Numeric uniform_fraction = 0.1;
+
+  const Index np = pnd_vec.nelem();
+  ARTS_ASSERT(TotalNumberOfElements(scat_data) == np);
+
+  // Asymmetry parameter of the bulk phase function, limited to keep the
+  // density finite
+  Numeric Z11int = 0, Z11cos = 0;
+  for (Index i = 0; i < np; i++) {
+    Z11int += Z11intvector[i] * pnd_vec[i];
+    Z11cos += Z11cosvector[i] * pnd_vec[i];
+  }
+  const Numeric g =
+      Z11int > 0 ? max(-0.99, min(0.99, Z11cos / Z11int)) : 0;
+  const bool use_hg = abs(g) >= 1e-3;
+
+  // Scattering angle, relative to rte_los as the forward direction
+  Numeric cos_theta;
+  if (!use_hg || rng.draw() < uniform_fraction) {
+    cos_theta = 1 - 2 * rng.draw();
+  } else {
+    const Numeric s = (1 - g * g) / (1 - g + 2 * g * rng.draw());
+    cos_theta = max(-1.0, min(1.0, (1 + g * g - s * s) / (2 * g)));
+  }
+  const Numeric sin_theta = sqrt(1 - cos_theta * cos_theta);
+  const Numeric phi = 2 * PI * rng.draw();
+
+  g_los_csc_theta = 1 / (4 * PI);
+  if (use_hg) {
+    g_los_csc_theta =
+        uniform_fraction / (4 * PI) +
+        (1 - uniform_fraction) * (1 - g * g) /
+            (4 * PI * pow(1 + g * g - 2 * g * cos_theta, 1.5));
+  }
+
+  // Rotate the forward direction by the scattering angle
+  Vector fwd(3), u(3), v(3);
+  zaaa2cart(fwd[0], fwd[1], fwd[2], rte_los[0], rte_los[1]);
+  Vector axis(3, 0.);
+  axis[abs(fwd[2]) < 0.9 ? 2 : 0] = 1;
+  cross3(u, fwd, axis);
+  u /= sqrt(u * u);
+  cross3(v, fwd, u);
+  Vector dir(3);
+  for (Index i = 0; i < 3; i++) {
+    dir[i] = cos_theta * fwd[i] +
+             sin_theta * (cos(phi) * u[i] + sin(phi) * v[i]);
+  }
+  cart2zaaa(new_rte_los[0], new_rte_los[1], dir[0], dir[1], dir[2]);
+
+  // Phase matrix for the drawn direction
+  ArrayOfArrayOfTensor6 pha_mat_Nse;
+  ArrayOfArrayOfIndex ptypes_Nse;
+  Matrix t_ok;
+  ArrayOfTensor6 pha_mat_ssbulk;
+  ArrayOfIndex ptype_ssbulk;
+  Tensor6 pha_mat_bulk;
+  Index ptype_bulk;
+  Matrix pdir(1, 2), idir(1, 2);
+  Vector t(1, rtp_temperature);
+  Matrix pnds(np, 1);
+  pnds(joker, 0) = pnd_vec;
+
+  Vector sca_dir, inc_dir;
+  mirror_los(sca_dir, rte_los, 3);
+  mirror_los(inc_dir, new_rte_los, 3);
+  pdir(0, joker) = sca_dir;
+  idir(0, joker) = inc_dir;
+  pha_mat_NScatElems(pha_mat_Nse,
+                     ptypes_Nse,
+                     t_ok,
+                     scat_data,
+                     stokes_dim,
+                     t,
+                     pdir,
+                     idir,
+                     f_index,
+                     t_interp_order);
+  pha_mat_ScatSpecBulk(
+      pha_mat_ssbulk, ptype_ssbulk, pha_mat_Nse, ptypes_Nse, pnds, t_ok);
+  pha_mat_Bulk(pha_mat_bulk, ptype_bulk, pha_mat_ssbulk, ptype_ssbulk);
+  Z = pha_mat_bulk(0, 0, 0, 0, joker, joker);
+}
+
+void Z11_moments(Vector& Z11intvector,
+                 Vector& Z11cosvector,
+                 const ArrayOfArrayOfSingleScatteringData& scat_data,
+                 const Index f_index) {
+  const Index N_se = TotalNumberOfElements(scat_data);
+  Z11intvector.resize(N_se);
+  Z11cosvector.resize(N_se);
+
+  Index i_total = -1;
+  for (Index i_ss = 0; i_ss < scat_data.nelem(); i_ss++) {
+    for (Index i_se = 0; i_se < scat_data[i_ss].nelem(); i_se++) {
+      i_total++;
+      const SingleScatteringData& ssd = scat_data[i_ss][i_se];
+      ARTS_USER_ERROR_IF(ssd.ptype != PTYPE_TOTAL_RND &&
+                             ssd.ptype != PTYPE_AZIMUTH_RND,
+                         "The phase function moments can only be calculated "
+                         "for totally or azimuthally randomly oriented "
+                         "particles.");
+
+      const Index this_f_index = ssd.f_grid.nelem() > 1 ? f_index : 0;
+      const Index nt = ssd.pha_mat_data.nvitrines();
+      const Vector& za = ssd.za_grid;
+
+      if (ssd.ptype == PTYPE_TOTAL_RND) {
+        // Trapezoidal integration over the scattering angle, averaged over
+        // the temperatures
+        Numeric Z11int = 0, Z11cos = 0;
+        for (Index it = 0; it < nt; it++) {
+          for (Index iza = 0; iza < za.nelem() - 1; iza++) {
+            const Numeric th0 = DEG2RAD * za[iza];
+            const Numeric th1 = DEG2RAD * za[iza + 1];
+            const Numeric y0 =
+                ssd.pha_mat_data(this_f_index, it, iza, 0, 0, 0, 0) *
+                sin(th0);
+            const Numeric y1 =
+                ssd.pha_mat_data(this_f_index, it, iza + 1, 0, 0, 0, 0) *
+                sin(th1);
+            Z11int += 0.5 * (y0 + y1) * (th1 - th0);
+            Z11cos += 0.5 * (y0 * cos(th0) + y1 * cos(th1)) * (th1 - th0);
+          }
+        }
+        Z11intvector[i_total] = 2 * PI * Z11int / (Numeric)nt;
+        Z11cosvector[i_total] = 2 * PI * Z11cos / (Numeric)nt;
+        continue;
+      }
+
+      // Azimuthally random orientation: the phase function depends on the
+      // incident zenith angle. The moments are integrated over the
+      // scattered directions, with the data covering azimuth differences
+      // 0-180 deg, and averaged over the incident directions weighted with
+      // sin(za_inc). The result only steers the sampling, so this average
+      // does not have to be exact.
+      const Vector& aa = ssd.aa_grid;
+      Numeric Z11int = 0, Z11cos = 0, wsum = 0;
+      for (Index it = 0; it < nt; it++) {
+        for (Index iinc = 0; iinc < za.nelem(); iinc++) {
+          const Numeric thi = DEG2RAD * za[iinc];
+          const Numeric w = sin(thi);
+          if (w <= 0) continue;
+
+          // Phase function times sin(za_sca), and the same times the
+          // cosine of the scattering angle, at a data point
+          auto y = [&](const Index iza, const Index iaa, Numeric& ycos) {
+            const Numeric ths = DEG2RAD * za[iza];
+            const Numeric y =
+                ssd.pha_mat_data(this_f_index, it, iza, iaa, iinc, 0, 0) *
+                sin(ths);
+            ycos = y * (cos(thi) * cos(ths) +
+                        sin(thi) * sin(ths) * cos(DEG2RAD * aa[iaa]));
+            return y;
+          };
+
+          Numeric int_inc = 0, cos_inc = 0;
+          for (Index iza = 0; iza < za.nelem() - 1; iza++) {
+            const Numeric dth = DEG2RAD * (za[iza + 1] - za[iza]);
+            for (Index iaa = 0; iaa < aa.nelem() - 1; iaa++) {
+              const Numeric dphi = DEG2RAD * (aa[iaa + 1] - aa[iaa]);
+              Numeric c00, c01, c10, c11;
+              const Numeric y00 = y(iza, iaa, c00);
+              const Numeric y01 = y(iza, iaa + 1, c01);
+              const Numeric y10 = y(iza + 1, iaa, c10);
+              const Numeric y11 = y(iza + 1, iaa + 1, c11);
+              int_inc += 0.25 * (y00 + y01 + y10 + y11) * dth * dphi;
+              cos_inc += 0.25 * (c00 + c01 + c10 + c11) * dth * dphi;
+            }
+          }
+          Z11int += w * 2 * int_inc;
+          Z11cos += w * 2 * cos_inc;
+          wsum += w;
+        }
+      }
+      Z11intvector[i_total] = wsum > 0 ? Z11int / wsum : 0;
+      Z11cosvector[i_total] = wsum > 0 ? Z11cos / wsum : 0;
+    }
+  }
+}
+
 void Sample_los_uniform(VectorView new_rte_los, Rng& rng) {
   new_rte_los[1] = rng.draw() * 360 - 180;
   new_rte_los[0] = acos(1 - 2 * rng.draw()) * RAD2DEG;
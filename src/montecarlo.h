@@ -138,6 +138,99 @@ void cloudy_rt_vars_at_gp(Workspace& ws,
                           const ArrayOfIndex& cloudbox_limits,
                           const Vector& rte_los);
 
+/** Optical properties at the atmospheric grid points.
+ *
+ * With this cache, mcPathTraceGeneral interpolates the extinction matrix
+ * and the absorption vector along the photon path from the grid points.
+ * It then no longer executes propmat_clearsky_agenda and extracts the
+ * scattering data at every path point.
+ *
+ * The gas part covers the complete atmosphere, the particle part only
+ * the cloudbox. The particle part is only cached for totally randomly
+ * oriented particles. For other particles the properties depend on the
+ * direction of propagation, and they are still calculated at every point.
+ */
+struct MCOptPropCache {
+  /** Gas extinction matrix [p, lat, lon, stokes, stokes]. */
+  Tensor5 gas_ext_mat;
+  /** Gas absorption vector [p, lat, lon, stokes]. */
+  Tensor4 gas_abs_vec;
+  /** Particle extinction matrix inside the cloudbox, or empty. */
+  Tensor5 par_ext_mat;
+  /** Particle absorption vector inside the cloudbox, or empty. */
+  Tensor4 par_abs_vec;
+
+  /** True if the particle properties are cached. */
+  bool has_particles() const { return !par_ext_mat.empty(); }
+};
+
+/** Calculates the optical properties at the atmospheric grid points.
+ *
+ * The agenda is executed in parallel over the grid points.
+ *
+ * @param[in,out] ws                      Current workspace.
+ * @param[out]    cache                   The cached optical properties.
+ * @param[in]     propmat_clearsky_agenda Agenda calculating the absorption coefficient matrices.
+ * @param[in]     stokes_dim              The dimensionality of the Stokes vector (1-4).
+ * @param[in]     f_index                 Index of frequency grid point handeled.
+ * @param[in]     f_grid                  Frequency grid for monochromatic pencil beam calculations.
+ * @param[in]     p_grid                  Pressure grid.
+ * @param[in]     t_field                 The temperature grid.
+ * @param[in]     vmr_field               VMR field.
+ * @param[in]     cloudbox_limits         The limits of the cloud box.
+ * @param[in]     pnd_field               Particle number density field.
+ * @param[in]     scat_data               Array of single scattering data.
+ *
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ */
+void mc_optprop_cache_calc(Workspace& ws,
+                           MCOptPropCache& cache,
+                           const Agenda& propmat_clearsky_agenda,
+                           const Index stokes_dim,
+                           const Index f_index,
+                           const Vector& f_grid,
+                           const Vector& p_grid,
+                           const Tensor3& t_field,
+                           const Tensor4& vmr_field,
+                           const ArrayOfIndex& cloudbox_limits,
+                           const Tensor4& pnd_field,
+                           const ArrayOfArrayOfSingleScatteringData& scat_data);
+
+/** Interpolates the cached optical properties to a point.
+ *
+ * The counterpart of clear_rt_vars_at_gp and cloudy_rt_vars_at_gp. Points
+ * inside the cloudbox require that the particle properties are cached.
+ *
+ * @param[out] ext_mat_mono     Total monochromatic extinction matrix.
+ * @param[out] abs_vec_mono     Total monochromatic absorption vector.
+ * @param[out] pnd_vec          Particle number densities, zero outside the cloudbox.
+ * @param[out] temperature      Temperature at the point.
+ * @param[in]  cache            The cached optical properties.
+ * @param[in]  inside_cloud     True if the point is inside the cloudbox.
+ * @param[in]  gp_p             Pressure grid position.
+ * @param[in]  gp_lat           Latitude grid position.
+ * @param[in]  gp_lon           Longitude grid position.
+ * @param[in]  t_field          The temperature grid.
+ * @param[in]  cloudbox_limits  The limits of the cloud box.
+ * @param[in]  pnd_field        Particle number density field.
+ *
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ */
+void cached_rt_vars_at_gp(MatrixView ext_mat_mono,
+                          VectorView abs_vec_mono,
+                          VectorView pnd_vec,
+                          Numeric& temperature,
+                          const MCOptPropCache& cache,
+                          const bool inside_cloud,
+                          const GridPos& gp_p,
+                          const GridPos& gp_lat,
+                          const GridPos& gp_lon,
+                          ConstTensor3View t_field,
+                          const ArrayOfIndex& cloudbox_limits,
+                          ConstTensor4View pnd_field);
+
 /** cloud_atm_vars_by_gp.
  *
  *
@@ -280,6 +373,14 @@ bool is_anyptype_nonTotRan(
  * @param[in]     scat_data               Array of single scattering data.
  * @param[in]     verbosity               Verbosity variable to dynamically control the reporting
  *                                        level during runtime.
+ * @param[in]     optprop_cache           Cached optical properties to interpolate from, or
+ *                                        nullptr to calculate them at every path point.
+ * @param[in]     r_forced                Random number determining the end point of the path.
+ *                                        Drawn from rng if negative. The path ends where the
+ *                                        transmission drops to r_forced, so with a small value
+ *                                        it is traced to the boundary of the atmosphere unless
+ *                                        the transmission falls below that value before. With
+ *                                        zero, g is set to zero if the transmission vanishes.
  *
  *
  * @author        Cory Davis
@@ -317,7 +418,9 @@ void mcPathTraceGeneral(Workspace& ws,
                         const ArrayOfIndex& cloudbox_limits,
                         const Tensor4& pnd_field,
                         const ArrayOfArrayOfSingleScatteringData& scat_data,
-                        const Verbosity& verbosity);
+                        const Verbosity& verbosity,
+                        const MCOptPropCache* optprop_cache = nullptr,
+                        const Numeric r_forced = -1);
 
 /** mcPathTraceRadar.
  *
@@ -447,6 +550,80 @@ void Sample_los(VectorView new_rte_los,
                 const Numeric rtp_temperature,
                 const Index t_interp_order = 1);
 
+/** Sampling of the new incident direction by importance sampling.
+ *
+ * Alternative to Sample_los for strongly forward scattering particles,
+ * where the rejection method of Sample_los needs many phase matrix
+ * evaluations per accepted direction. The direction is drawn from a
+ * mixture of a Henyey-Greenstein distribution, with the asymmetry
+ * parameter of the bulk phase function, and a uniform distribution. The
+ * phase matrix is calculated once, for the drawn direction.
+ *
+ * The returned probability density is that of the mixture. Dividing the
+ * phase matrix with it, as done for Sample_los, gives an unbiased
+ * weight. The uniform part keeps the weight bounded where the
+ * Henyey-Greenstein distribution underestimates the phase function.
+ *
+ * The asymmetry parameter comes from Z11_moments, so the particles must
+ * be totally or azimuthally randomly oriented.
+ *
+ * @param[out]    new_rte_los      Incident line of sight for subsequent.
+ * @param[out]    g_los_csc_theta  Probability density for the chosen
+ *                                 direction.
+ * @param[out]    Z                Bulk phase matrix in Stokes notation.
+ * @param[in,out] rng              Rng random number generator instance.
+ * @param[in]     rte_los          Incident line of sight for subsequent
+ *                                 ray-tracing.
+ * @param[in]     scat_data        As the WSV.
+ * @param[in]     f_index          Index of frequency grid point handeled.
+ * @param[in]     stokes_dim       As the WSV.
+ * @param[in]     pnd_vec          Vector of particle number densities (one element per scattering element).
+ * @param[in]     Z11intvector     Integral of the phase function over all
+ *                                 directions for each scattering element.
+ * @param[in]     Z11cosvector     As Z11intvector, but weighted with the
+ *                                 cosine of the scattering angle.
+ * @param[in]     rtp_temperature  As the WSV.
+ * @param[in]     t_interp_order   Interpolation order of temperature.
+ *
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ */
+void Sample_los_importance(VectorView new_rte_los,
+                           Numeric& g_los_csc_theta,
+                           MatrixView Z,
+                           Rng& rng,
+                           ConstVectorView rte_los,
+                           const ArrayOfArrayOfSingleScatteringData& scat_data,
+                           const Index f_index,
+                           const Index stokes_dim,
+                           ConstVectorView pnd_vec,
+                           ConstVectorView Z11intvector,
+                           ConstVectorView Z11cosvector,
+                           const Numeric rtp_temperature,
+                           const Index t_interp_order = 1);
+
+/** Integrals of the phase function of randomly oriented particles.
+ *
+ * Calculates, for each scattering element, the integral of the phase
+ * function over all directions and the same integral weighted with the
+ * cosine of the scattering angle. Together they give the asymmetry
+ * parameter of the bulk phase function, as used by Sample_los_importance.
+ * For azimuthally randomly oriented particles, the integrals are averaged
+ * over the incident zenith angles.
+ *
+ * @param[out] Z11intvector  Integral of the phase function.
+ * @param[out] Z11cosvector  Integral weighted with cos of scattering angle.
+ * @param[in]  scat_data     As the WSV.
+ * @param[in]  f_index       Index of frequency grid point handeled.
+ *
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ */
+void Z11_moments(Vector& Z11intvector,
+                 Vector& Z11cosvector,
+                 const ArrayOfArrayOfSingleScatteringData& scat_data,
+                 const Index f_index);
+
 /** Sample_los_uniform.
  *
  * Sampling the new direction uniformly
@@ -60,6 +60,7 @@ void nca_read_from_file(const int ncid, GasAbsLookup& gal, const Verbosity&) {
   nca_get_data_Vector(ncid, "t_pert", gal.t_pert, true);
   nca_get_data_Vector(ncid, "nls_pert", gal.nls_pert, true);
   nca_get_data_Tensor4(ncid, "xsec", gal.xsec, true);
+  gal.mapped_xsec.reset();
 }
 
 //! Writes a GasAbsLookup table to a NetCDF file
@@ -71,7 +72,15 @@ void nca_read_from_file(const int ncid, GasAbsLookup& gal, const Verbosity&) {
 */
 void nca_write_to_file(const int ncid,
                        const GasAbsLookup& gal,
-                       const Verbosity&) {
+                       const Verbosity& verbosity) {
+  // Memory-mapped cross sections are written from a copy in memory
+  if (gal.IsMapped()) {
+    GasAbsLookup unmapped(gal);
+    unmapped.Unmap();
+    nca_write_to_file(ncid, unmapped, verbosity);
+    return;
+  }
+
   int retval;
 
   int species_strings_varid;
@@ -129,7 +129,9 @@ bool get_parameters(int argc, char **argv) {
       {"numthreads", required_argument, NULL, 'n'},
       {"outdir", required_argument, NULL, 'o'},
       {"plain", no_argument, NULL, 'p'},
+      {"profile", required_argument, NULL, 'P'},
       {"reporting", required_argument, NULL, 'r'},
+      {"server", no_argument, NULL, 'R'},
 #ifdef ENABLE_DOCSERVER
       {"docserver", optional_argument, NULL, 's'},
       {"docdaemon", optional_argument, NULL, 'S'},
@@ -140,7 +142,7 @@ bool get_parameters(int argc, char **argv) {
       {NULL, no_argument, NULL, 0}};
 
   parameters.usage =
-      "Usage: arts [-bBdghimnrsSvw]\n"
+      "Usage: arts [-bBdghimnPrRsSvw]\n"
       "       [--basename <name>]\n"
       "       [--describe <method or variable>]\n"
       "       [--groups]\n"
@@ -152,7 +154,9 @@ bool get_parameters(int argc, char **argv) {
       "       [--numthreads <#>\n"
       "       [--outdir <name>]\n"
       "       [--plain]\n"
+      "       [--profile <file>]\n"
       "       [--reporting <xyz>]\n"
+      "       [--server]\n"
 #ifdef ENABLE_DOCSERVER
       "       [--docserver[=<port>] --baseurl=BASEURL]\n"
       "       [--docdaemon[=<port>] --baseurl=BASEURL]\n"
@@ -198,6 +202,13 @@ bool get_parameters(int argc, char **argv) {
       "                    Default is the current directory.\n"
       "-p  --plain         Generate plain help output suitable for\n"
       "                    script processing.\n"
+      "-P  --profile       Record call counts and wall and CPU time of all\n"
+      "                    agendas and methods for each thread, and the\n"
+      "                    allocated memory if built with\n"
+      "                    ENABLE_PROFILER_ALLOCATIONS. The report is\n"
+      "                    written to the given file at exit, as JSON if\n"
+      "                    the name ends with .json, otherwise in the\n"
+      "                    folded stack format for flamegraph.pl.\n"
       "-r, --reporting     Three digit integer. Sets the reporting\n"
       "                    level for agenda calls (first digit),\n"
       "                    screen (second digit) and file (third \n"
@@ -206,6 +217,13 @@ bool get_parameters(int argc, char **argv) {
       "                    The agenda setting applies in addition to both\n"
       "                    screen and file output.\n"
       "                    Default is 010.\n"
+      "-R, --server        Keep the workspace resident after running the given\n"
+      "                    controlfiles and read requests from standard input.\n"
+      "                    'run <file.arts>' runs a controlfile, a controlfile\n"
+      "                    can also be given inline between lines 'begin' and\n"
+      "                    'end'. 'quit' stops the server. Each request is\n"
+      "                    answered with 'ok' or 'error' and the error message,\n"
+      "                    followed by a line with a single '.'.\n"
 #ifdef ENABLE_DOCSERVER
       "-s, --docserver     Start documentation server. Optionally, specify\n"
       "                    the port number the server should listen on,\n"
@@ -310,6 +328,12 @@ bool get_parameters(int argc, char **argv) {
       case 'p':
         parameters.plain = true;
         break;
+      case 'P':
+        parameters.profile = optarg;
+        break;
+      case 'R':
+        parameters.server = true;
+        break;
       case 'r': {
         //      cout << "optarg = " << optarg << endl;
         istringstream iss(optarg);
@@ -61,6 +61,8 @@ class Parameters {
         describe(""),
         groups(false),
         plain(false),
+        profile(""),
+        server(false),
         docserver(0),
         baseurl(""),
         daemon(false),
@@ -121,6 +123,14 @@ class Parameters {
   bool groups;
   /** Generate plain help out suitable for script processing. */
   bool plain;
+  /** If this is specified (with the -P --profile option), the runtime of
+      all agendas and methods is recorded and written to this file at
+      exit. */
+  String profile;
+  /** If this is specified (with the -R --server option), ARTS keeps its
+      workspace after running the controlfiles and executes further
+      controlfiles read from standard input. */
+  bool server;
   /** Port to use for the docserver. */
   Index docserver;
   /** Baseurl for the docserver. */
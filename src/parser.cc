@@ -43,12 +43,193 @@ ArtsParser::ArtsParser(Agenda& tasklist,
   msource.AppendFile(mcfile);
 }
 
+/** Constructs a new parser for a controlfile that is already in memory.
+
+    \param[out] tasklist Method list read from the text.
+    \param[in]  name     Name of the text used in error messages.
+    \param[in]  text     Lines of the controlfile.
+*/
+ArtsParser::ArtsParser(Agenda& tasklist,
+                       String name,
+                       const ArrayOfString& text,
+                       const Verbosity& rverbosity)
+    : mtasklist(tasklist),
+      mcfile(name),
+      mcfile_version(1),
+      verbosity(rverbosity) {
+  msource.AppendText(mcfile, text);
+}
+
 /** Public interface to the main function of the parser.
 
     \author Oliver Lemke
 */
 void ArtsParser::parse_tasklist() { parse_main(); }
 
+std::map<String, ArtsParser::CacheEntry> ArtsParser::mcache;
+
+bool ArtsParser::mrepeated_create = false;
+
+/** Hash of the content of a text.
+
+    \param[in] text Lines of the text.
+    \return The hash.
+*/
+static size_t hash_text(const ArrayOfString& text) {
+  std::string joined;
+  for (auto& line : text) {
+    joined += line;
+    joined += '\n';
+  }
+  return std::hash<std::string>{}(joined);
+}
+
+/** Parses a controlfile, reusing an earlier result if possible.
+
+    Parsing the same controlfile again gives the same methods as long as
+    the content of the file and of all files it includes is unchanged and
+    no WSVs have been removed. In this case the earlier result is reused.
+    This avoids parsing the same include files, e.g. general.arts, again
+    in each run of the server mode and in each parse_agenda call of the
+    C API.
+
+    \param[out] tasklist    Method list read from the controlfile.
+    \param[in]  controlfile Path to the controlfile.
+    \param[in]  verbosity   Verbosity.
+
+    \author The ARTS Developers
+*/
+void ArtsParser::parse_file(Agenda& tasklist,
+                            const String& controlfile,
+                            const Verbosity& verbosity) {
+  Array<FileHash> files;
+  ArrayOfString datapath_dirs;
+  parse_file(tasklist, controlfile, verbosity, files, datapath_dirs);
+}
+
+/** Parses a controlfile, reusing an earlier result if possible.
+
+    \param[out]    tasklist      Method list read from the controlfile.
+    \param[in]     controlfile   Path to the controlfile.
+    \param[in]     verbosity     Verbosity.
+    \param[in,out] files         The controlfile and all files it includes
+                                 are appended.
+    \param[in,out] datapath_dirs Directories added to the data path are
+                                 appended.
+
+    \author The ARTS Developers
+*/
+void ArtsParser::parse_file(Agenda& tasklist,
+                            const String& controlfile,
+                            const Verbosity& verbosity,
+                            Array<FileHash>& files,
+                            ArrayOfString& datapath_dirs) {
+  CREATE_OUT3;
+  extern Parameters parameters;
+
+  ArrayOfString text;
+  read_text_from_file(text, controlfile);
+  const size_t hash = hash_text(text);
+
+  auto cached = mcache.find(controlfile);
+  if (cached != mcache.end() && is_valid(cached->second, hash)) {
+    const CacheEntry& entry = cached->second;
+    out3 << "- Reusing parsed control file " << controlfile << "\n";
+
+    tasklist = entry.tasklist;
+    for (auto& dir : entry.datapath_dirs) add_to_datapath(dir);
+
+    files.insert(files.end(), entry.files.begin(), entry.files.end());
+    datapath_dirs.insert(datapath_dirs.end(),
+                         entry.datapath_dirs.begin(),
+                         entry.datapath_dirs.end());
+    return;
+  }
+
+  ArtsParser parser(tasklist, controlfile, text, verbosity);
+  parser.parse_tasklist();
+
+  CacheEntry& entry = mcache[controlfile];
+  entry.includepath = parameters.includepath;
+  entry.files.resize(0);
+  entry.files.push_back(FileHash{controlfile, hash});
+  entry.files.insert(
+      entry.files.end(), parser.mincludes.begin(), parser.mincludes.end());
+  entry.datapath_dirs = parser.mdatapath_dirs;
+  entry.nwsvs = Workspace::wsv_data.nelem();
+  entry.tasklist = tasklist;
+
+  files.insert(files.end(), entry.files.begin(), entry.files.end());
+  datapath_dirs.insert(datapath_dirs.end(),
+                       entry.datapath_dirs.begin(),
+                       entry.datapath_dirs.end());
+}
+
+/** Checks if a cached parse result can be reused.
+
+    \param[in] entry The cached result.
+    \param[in] hash  Hash of the current content of the controlfile.
+    \return True if the controlfile and all included files are unchanged.
+
+    \author The ARTS Developers
+*/
+bool ArtsParser::is_valid(const CacheEntry& entry, size_t hash) {
+  extern Parameters parameters;
+
+  if (entry.files[0].hash != hash ||
+      entry.includepath != parameters.includepath ||
+      entry.nwsvs > Workspace::wsv_data.nelem())
+    return false;
+
+  for (Index i = 1; i < entry.files.nelem(); i++) {
+    ArrayOfString text;
+    try {
+      read_text_from_file(text, entry.files[i].name);
+    } catch (const std::runtime_error&) {
+      return false;
+    }
+    if (hash_text(text) != entry.files[i].hash) return false;
+  }
+
+  return true;
+}
+
+/** Drops all cached parse results.
+
+    Must be called when WSVs are removed, because the cached methods refer
+    to WSVs by index.
+
+    \author The ARTS Developers
+*/
+void ArtsParser::clear_cache() { mcache.clear(); }
+
+/** Allows TYPECreate calls on variables that already exist.
+
+    Normally a variable can only be created once. In server mode every
+    request is parsed on its own, so a request that creates a variable
+    must also parse when it is sent again. With this turned on, creating
+    an existing variable of the same group is accepted and refers to the
+    existing variable.
+
+    \param[in] allow True to allow repeated creation.
+*/
+void ArtsParser::allow_repeated_create(bool allow) {
+  mrepeated_create = allow;
+}
+
+/** Adds the directory of an included file to the front of the data path.
+
+    \param[in] dir The directory.
+
+    \author The ARTS Developers
+*/
+void ArtsParser::add_to_datapath(const String& dir) {
+  extern Parameters parameters;
+
+  if (parameters.datapath.nelem() && parameters.datapath[0] != dir)
+    parameters.datapath.insert(parameters.datapath.begin(), dir);
+}
+
 /** Find named arguments.
 
  This method is used to determine the position and the names of named arguments.
@@ -368,8 +549,8 @@ void ArtsParser::parse_agenda(Agenda& tasklist, const String& agenda_name) {
       if (includedir.nelem()) {
         if (current_includepath.nelem() && current_includepath[0] != includedir)
           current_includepath.insert(current_includepath.begin(), includedir);
-        if (parameters.datapath.nelem() && parameters.datapath[0] != includedir)
-          parameters.datapath.insert(parameters.datapath.begin(), includedir);
+        add_to_datapath(includedir);
+        mdatapath_dirs.push_back(includedir);
       }
 
       ArrayOfString matching_files;
@@ -388,8 +569,7 @@ void ArtsParser::parse_agenda(Agenda& tasklist, const String& agenda_name) {
       include_file = matching_files[0];
       out2 << "- Including control file " << include_file << "\n";
 
-      ArtsParser include_parser(tasks, include_file, verbosity);
-      include_parser.parse_tasklist();
+      parse_file(tasks, include_file, verbosity, mincludes, mdatapath_dirs);
 
       for (Index i = 0; i < tasks.nelem(); i++)
         tasklist.push_back(tasks.Methods()[i]);
@@ -1244,7 +1424,10 @@ void ArtsParser::parse_generic_output(const MdRecord*& mdd,
 
       if (wsvid == -1) {
         if (mdd->Name().length() > 6 &&
-            mdd->Name().find("Create") == mdd->Name().length() - 6) {
+            mdd->Name().find("Create") == mdd->Name().length() - 6 &&
+            not(mrepeated_create and
+                Workspace::wsv_data[wsvit->second].Group() ==
+                    mdd->GOutType()[j])) {
           ostringstream os;
           os << wsvname
              << " already exists. A variable can only be created once.\n";
@@ -27,9 +27,58 @@ class ArtsParser {
  public:
   ArtsParser(Agenda& tasklist, String controlfile, const Verbosity& verbosity);
 
+  ArtsParser(Agenda& tasklist,
+             String name,
+             const ArrayOfString& text,
+             const Verbosity& verbosity);
+
   void parse_tasklist();
 
+  static void parse_file(Agenda& tasklist,
+                         const String& controlfile,
+                         const Verbosity& verbosity);
+
+  static void clear_cache();
+
+  static void allow_repeated_create(bool allow);
+
  private:
+  /** A file a parse result depends on, with the hash of its content. */
+  struct FileHash {
+    String name;
+    size_t hash;
+  };
+
+  static void parse_file(Agenda& tasklist,
+                         const String& controlfile,
+                         const Verbosity& verbosity,
+                         Array<FileHash>& files,
+                         ArrayOfString& datapath_dirs);
+
+  static void add_to_datapath(const String& dir);
+
+  /** Result of parsing a controlfile. */
+  struct CacheEntry {
+    /** Include path at the time of parsing. */
+    ArrayOfString includepath;
+    /** The file itself followed by all files it includes. */
+    Array<FileHash> files;
+    /** Directories added to the data path while parsing. */
+    ArrayOfString datapath_dirs;
+    /** Number of WSVs after parsing. */
+    Index nwsvs;
+    /** The parsed methods. */
+    Agenda tasklist;
+  };
+
+  static bool is_valid(const CacheEntry& entry, size_t hash);
+
+  /** Parsed controlfiles by file name. */
+  static std::map<String, CacheEntry> mcache;
+
+  /** Allow TYPECreate on an existing variable of the same group. */
+  static bool mrepeated_create;
+
   typedef struct {
     String name;
     Index line;
@@ -167,6 +216,12 @@ class ArtsParser {
   Index mcfile_version;
 
   const Verbosity& verbosity;
+
+  /** Files included by the parsed text, including nested includes. */
+  Array<FileHash> mincludes;
+
+  /** Directories added to the data path while parsing. */
+  ArrayOfString mdatapath_dirs;
 };
 
 #endif /* parser_h */
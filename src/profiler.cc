@@ -0,0 +1,212 @@
+/* Copyright (C) 2026, The ARTS Developers.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+ * USA. */
+
+/**
+ * @file   profiler.cc
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ *
+ * @brief  Runtime profiling of agendas and workspace methods.
+ */
+
+#include "profiler.h"
+
+#include <time.h>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace profiler {
+
+bool enabled = false;
+
+thread_local Index thread_bytes_allocated = 0;
+
+/** Accumulated measurements for one nesting path. */
+struct Node {
+  String name;
+  bool is_agenda{false};
+  Index calls{0};
+  Numeric wall{0};
+  Numeric cpu{0};
+  Index bytes{0};
+  Node* parent{nullptr};
+  std::map<String, std::unique_ptr<Node>> children;
+};
+
+/** Call tree of one thread. */
+struct ThreadProfile {
+  Index id;
+  Node root;
+  Node* current{&root};
+};
+
+namespace {
+
+/** Profiles of all threads, owned here so they outlive the threads. */
+std::vector<std::unique_ptr<ThreadProfile>> thread_profiles;
+std::mutex thread_profiles_mutex;
+
+String report_filename;
+
+ThreadProfile& this_thread_profile() {
+  static thread_local ThreadProfile* tp = nullptr;
+  if (!tp) {
+    std::lock_guard<std::mutex> lock(thread_profiles_mutex);
+    thread_profiles.push_back(std::make_unique<ThreadProfile>());
+    tp = thread_profiles.back().get();
+    tp->id = (Index)thread_profiles.size() - 1;
+  }
+  return *tp;
+}
+
+/** CPU time used by the calling thread in seconds. */
+Numeric thread_cpu_time() {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    return (Numeric)ts.tv_sec + (Numeric)ts.tv_nsec * 1e-9;
+#endif
+  return 0.;
+}
+
+void write_report_at_exit() {
+  try {
+    write_report(report_filename);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+  }
+}
+
+/** Escape a string for use in JSON. */
+String json_string(const String& s) {
+  String out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  return out + "\"";
+}
+
+void write_json_node(std::ostream& os, const Node& node, const String& indent) {
+  os << indent << "{\"name\": " << json_string(node.name)
+     << ", \"type\": \"" << (node.is_agenda ? "agenda" : "method")
+     << "\", \"calls\": " << node.calls << ", \"wall\": " << node.wall
+     << ", \"cpu\": " << node.cpu << ", \"bytes\": " << node.bytes
+     << ", \"children\": [";
+  bool first = true;
+  for (auto& child : node.children) {
+    os << (first ? "\n" : ",\n");
+    write_json_node(os, *child.second, indent + "  ");
+    first = false;
+  }
+  os << "]}";
+}
+
+/** Write self time of every path in microseconds, the folded stack format. */
+void write_folded_node(std::ostream& os, const Node& node, const String& path) {
+  const String node_path = path + ";" + node.name;
+  Numeric self = node.wall;
+  for (auto& child : node.children) {
+    self -= child.second->wall;
+    write_folded_node(os, *child.second, node_path);
+  }
+  const Index self_us = (Index)std::round(self * 1e6);
+  if (self_us > 0) os << node_path << " " << self_us << "\n";
+}
+
+}  // namespace
+
+void enable(const String& filename) {
+  report_filename = filename;
+  if (!enabled) std::atexit(write_report_at_exit);
+  enabled = true;
+}
+
+void write_report(const String& filename) {
+  std::ofstream ofs(filename.c_str());
+  if (!ofs) throw std::runtime_error("Cannot write profile report to " + filename);
+
+  const bool json = filename.length() >= 5 &&
+                    filename.substr(filename.length() - 5) == ".json";
+
+  std::lock_guard<std::mutex> lock(thread_profiles_mutex);
+  ofs << std::setprecision(9);
+  if (json) {
+    ofs << "{\"threads\": [";
+    bool first = true;
+    for (auto& tp : thread_profiles) {
+      ofs << (first ? "\n" : ",\n");
+      ofs << "  {\"thread\": " << tp->id << ", \"calls\": [";
+      bool first_child = true;
+      for (auto& child : tp->root.children) {
+        ofs << (first_child ? "\n" : ",\n");
+        write_json_node(ofs, *child.second, "    ");
+        first_child = false;
+      }
+      ofs << "]}";
+      first = false;
+    }
+    ofs << "\n]}\n";
+  } else {
+    for (auto& tp : thread_profiles) {
+      std::ostringstream thread_name;
+      thread_name << "Thread " << tp->id;
+      for (auto& child : tp->root.children)
+        write_folded_node(ofs, *child.second, thread_name.str());
+    }
+  }
+}
+
+void Scope::start(const String& name, bool is_agenda) {
+  ThreadProfile& tp = this_thread_profile();
+  std::unique_ptr<Node>& child = tp.current->children[name];
+  if (!child) {
+    child = std::make_unique<Node>();
+    child->name = name;
+    child->is_agenda = is_agenda;
+    child->parent = tp.current;
+  }
+  tp.current = child.get();
+  mnode = child.get();
+
+  mbytes_start = thread_bytes_allocated;
+  mcpu_start = thread_cpu_time();
+  mwall_start = std::chrono::steady_clock::now();
+}
+
+void Scope::stop() {
+  const auto wall_end = std::chrono::steady_clock::now();
+  const Numeric cpu_end = thread_cpu_time();
+
+  mnode->calls++;
+  mnode->wall += std::chrono::duration<Numeric>(wall_end - mwall_start).count();
+  mnode->cpu += cpu_end - mcpu_start;
+  mnode->bytes += thread_bytes_allocated - mbytes_start;
+
+  this_thread_profile().current = mnode->parent;
+}
+
+}  // namespace profiler
@@ -0,0 +1,116 @@
+/* Copyright (C) 2026, The ARTS Developers.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+ * USA. */
+
+/**
+ * @file   profiler.h
+ * @author The ARTS Developers
+ * @date   2026-10-16
+ *
+ * @brief  Runtime profiling of agendas and workspace methods.
+ *
+ * The profiler is enabled with the --profile command line option. It
+ * records for every agenda and method call the number of calls and the
+ * wall and CPU time. The data is kept per thread and per nesting path, e.g.
+ * Arts;ybatchCalc;ybatch_calc_agenda;yCalc.
+ *
+ * If ARTS is built with ENABLE_PROFILER_ALLOCATIONS, the bytes allocated
+ * with operator new are recorded as well. This replaces the global
+ * operator new of the arts executable (see profiler_new.cc), so it is off
+ * by default.
+ *
+ * When ARTS exits, the report is written to the given file. If the file
+ * name ends with .json, the full call tree is written as JSON. Otherwise
+ * the self time in microseconds is written in the folded stack format
+ * that is understood by flamegraph.pl and speedscope.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+
+#include "matpack.h"
+#include "mystring.h"
+
+namespace profiler {
+
+struct Node;
+
+/** True if profiling was enabled with enable(). */
+extern bool enabled;
+
+/** Bytes allocated by the calling thread while the profiler is enabled.
+ *
+ * Only counted if ARTS is built with ENABLE_PROFILER_ALLOCATIONS.
+ */
+extern thread_local Index thread_bytes_allocated;
+
+/** Enable profiling and write the report at exit.
+ *
+ * Must be called before any agenda is executed and outside of parallel
+ * regions.
+ *
+ * @param[in] filename Report file. The format is JSON if the name ends
+ *                     with .json, otherwise folded stacks.
+ */
+void enable(const String& filename);
+
+/** Write the report of all threads.
+ *
+ * Called automatically at exit if the profiler is enabled.
+ *
+ * @param[in] filename Report file.
+ */
+void write_report(const String& filename);
+
+/** Measure one agenda or method call.
+ *
+ * Construct at the beginning of the call. The measurement is added to
+ * the profile of the calling thread when the object goes out of scope,
+ * also if the call throws. Does nothing if the profiler is not enabled.
+ */
+class Scope {
+ public:
+  /** Start measuring.
+   *
+   * @param[in] name Agenda or method name.
+   * @param[in] is_agenda True for agendas, false for methods.
+   */
+  Scope(const String& name, bool is_agenda) {
+    if (enabled) start(name, is_agenda);
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  ~Scope() {
+    if (mnode) stop();
+  }
+
+ private:
+  void start(const String& name, bool is_agenda);
+  void stop();
+
+  Node* mnode{nullptr};
+  std::chrono::steady_clock::time_point mwall_start;
+  Numeric mcpu_start{0};
+  Index mbytes_start{0};
+};
+
+}  // namespace profiler
+
+#endif /* PROFILER_H */
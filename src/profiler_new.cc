@@ -0,0 +1,51 @@
+/* Copyright (C) 2026, The ARTS Developers.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+ * USA. */
+
+/**
+ * @file   profiler_new.cc
+ * @author The ARTS Developers
+ * @date   2026-10-17
+ *
+ * @brief  Global operator new that counts bytes for the profiler.
+ *
+ * Only linked into the arts executable if ARTS is built with
+ * ENABLE_PROFILER_ALLOCATIONS. It must not be part of a library, since
+ * it replaces operator new for the whole program.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "profiler.h"
+
+/* Count the bytes requested through operator new. The array and nothrow
+   versions are implemented in terms of this one by the standard library. */
+void* operator new(std::size_t size) {
+  if (profiler::enabled) profiler::thread_bytes_allocated += (Index)size;
+
+  if (size == 0) size = 1;
+  for (;;) {
+    if (void* p = std::malloc(size)) return p;
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) throw std::bad_alloc();
+    handler();
+  }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
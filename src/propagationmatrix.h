@@ -198,6 +198,10 @@ class LazyScale {
  * And for devs: the u-variable is at vector position of the Stokes Dim in case 4 and 3, 
  * and that the other variables never change their positions, which is why the switch
  * cases are all consistently fall-through-able in this class
+ * 
+ * The variables of one frequency are adjacent in mdata.  Kernels that should
+ * vectorize over frequency copy a block of frequencies element by element to
+ * local arrays first, as the Stokes Dim 4 transmission in transmissionmatrix.cc does.
  */
 class PropagationMatrix {
  public:
@@ -91,6 +91,23 @@ void Rng::force_seed(unsigned long int n) {
   gsl_rng_set(r, seed_no);
 }
 
+void Rng::seed_stream(unsigned long int n, unsigned long int stream) {
+  if (!stream) {
+    force_seed(n);
+    return;
+  }
+
+  // splitmix64 finalizer of the combined seed and stream number
+  unsigned long long z = (unsigned long long)n +
+                         0x9E3779B97F4A7C15ULL * (unsigned long long)stream;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+
+  // mt19937 only uses the lower 32 bits of the seed
+  force_seed((unsigned long int)((z ^ (z >> 32)) & 0xffffffffUL));
+}
+
 /**
 Draws a double from the uniform distribution [0,1)
 */
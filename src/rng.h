@@ -573,6 +573,20 @@ class Rng {
 
   void force_seed(unsigned long int n);
 
+ /**
+  * Seeds the Rng for one of several streams of a parallel calculation.
+  *
+  * Stream 0 is seeded with n itself, so that a calculation with a single
+  * stream draws the same numbers as with seed. The other streams are seeded
+  * with a hash of n and the stream number, which gives statistically
+  * independent streams also for consecutive seeds or stream numbers.
+  * The pool of used seeds is not touched.
+  *
+  * @param[in] n Seed of the calculation, as returned by showseed.
+  * @param[in] stream Stream number.
+  */
+  void seed_stream(unsigned long int n, unsigned long int stream);
+
   double draw();  //draw a random number between [0,1)
 
   unsigned long int showseed() const;  //return the seed.
@@ -453,6 +453,9 @@ void run_rt4(Workspace& ws,
     za_grid_orig = za_grid;
   }
 
+  // Kept over the frequencies, only reallocated if nummu changes
+  RT4Work rt4_work;
+
   Index nummu_new = 0;
   // Loop over frequencies
   for (Index f_index = 0; f_index < f_grid.nelem(); f_index++) {
@@ -524,38 +527,40 @@ void run_rt4(Workspace& ws,
     }
 
     if (!pfct_failed) {
-#pragma omp critical(fortran_rt4)
-      {
-        // Call RT4
-        radtrano_(stokes_dim,
-                  nummu,
-                  nhza,
-                  max_delta_tau,
-                  quad_type.c_str(),
-                  surface_skin_t,
-                  ground_type.c_str(),
-                  ground_albedo[f_index],
-                  ground_index[f_index],
-                  groundreflec.get_c_array(),
-                  surfreflmat.get_c_array(),
-                  surfemisvec.get_c_array(),
-                  sky_temp,
-                  wavelength,
-                  num_layers,
-                  height.get_c_array(),
-                  temperatures.get_c_array(),
-                  gas_extinct.get_c_array(),
-                  num_scatlayers,
-                  scatlayers.get_c_array(),
-                  extinct_matrix.get_c_array(),
-                  emis_vector.get_c_array(),
-                  scatter_matrix.get_c_array(),
-                  //noutlevels,
-                  //outlevels.get_c_array(),
-                  mu_values.get_c_array(),
-                  up_rad.get_c_array(),
-                  down_rad.get_c_array());
-      }
+      rt4_work.resize(stokes_dim, nummu, num_layers);
+
+      // Call RT4
+      radtrano_(stokes_dim,
+                nummu,
+                nhza,
+                max_delta_tau,
+                quad_type.c_str(),
+                surface_skin_t,
+                ground_type.c_str(),
+                ground_albedo[f_index],
+                ground_index[f_index],
+                groundreflec.get_c_array(),
+                surfreflmat.get_c_array(),
+                surfemisvec.get_c_array(),
+                sky_temp,
+                wavelength,
+                num_layers,
+                height.get_c_array(),
+                temperatures.get_c_array(),
+                gas_extinct.get_c_array(),
+                num_scatlayers,
+                scatlayers.get_c_array(),
+                extinct_matrix.get_c_array(),
+                emis_vector.get_c_array(),
+                scatter_matrix.get_c_array(),
+                //noutlevels,
+                //outlevels.get_c_array(),
+                mu_values.get_c_array(),
+                up_rad.get_c_array(),
+                down_rad.get_c_array(),
+                rt4_work.reflect.get_c_array(),
+                rt4_work.trans.get_c_array(),
+                rt4_work.source.get_c_array());
 
     } else {  // if (auto_inc_nstreams)
 
@@ -697,39 +702,41 @@ void run_rt4(Workspace& ws,
       Tensor3 down_rad_new(num_layers + 1, nummu_new, stokes_dim, 0.);
       //
       // run radtrano_
-#pragma omp critical(fortran_rt4)
-      {
-        // Call RT4
-        radtrano_(stokes_dim,
-                  nummu_new,
-                  nhza,
-                  max_delta_tau,
-                  quad_type.c_str(),
-                  surface_skin_t,
-                  ground_type.c_str(),
-                  ground_albedo[f_index],
-                  ground_index[f_index],
-                  groundreflec.get_c_array(),
-                  surfreflmat_new.get_c_array(),
-                  surfemisvec_new.get_c_array(),
-                  sky_temp,
-                  wavelength,
-                  num_layers,
-                  height.get_c_array(),
-                  temperatures.get_c_array(),
-                  gas_extinct.get_c_array(),
-                  num_scatlayers,
-                  scatlayers.get_c_array(),
-                  extinct_matrix_new(0, joker, joker, joker, joker, joker)
-                      .get_c_array(),
-                  emis_vector_new(0, joker, joker, joker, joker).get_c_array(),
-                  scatter_matrix_new.get_c_array(),
-                  //noutlevels,
-                  //outlevels.get_c_array(),
-                  mu_values_new.get_c_array(),
-                  up_rad_new.get_c_array(),
-                  down_rad_new.get_c_array());
-      }
+      rt4_work.resize(stokes_dim, nummu_new, num_layers);
+
+      // Call RT4
+      radtrano_(stokes_dim,
+                nummu_new,
+                nhza,
+                max_delta_tau,
+                quad_type.c_str(),
+                surface_skin_t,
+                ground_type.c_str(),
+                ground_albedo[f_index],
+                ground_index[f_index],
+                groundreflec.get_c_array(),
+                surfreflmat_new.get_c_array(),
+                surfemisvec_new.get_c_array(),
+                sky_temp,
+                wavelength,
+                num_layers,
+                height.get_c_array(),
+                temperatures.get_c_array(),
+                gas_extinct.get_c_array(),
+                num_scatlayers,
+                scatlayers.get_c_array(),
+                extinct_matrix_new(0, joker, joker, joker, joker, joker)
+                    .get_c_array(),
+                emis_vector_new(0, joker, joker, joker, joker).get_c_array(),
+                scatter_matrix_new.get_c_array(),
+                //noutlevels,
+                //outlevels.get_c_array(),
+                mu_values_new.get_c_array(),
+                up_rad_new.get_c_array(),
+                down_rad_new.get_c_array(),
+                rt4_work.reflect.get_c_array(),
+                rt4_work.trans.get_c_array(),
+                rt4_work.source.get_c_array());
       // back-interpolate nstream_new fields to nstreams
       //   (possible to use iyCloudboxInterp agenda? nja, not really a good
       //   idea. too much overhead there (checking, 3D+2ang interpol). rather
@@ -1609,6 +1616,8 @@ void rt4_test(Tensor4& out_rad,
   Vector mu_values(nummu);
   Tensor3 up_rad(num_layers + 1, nummu, nstokes, 0.);
   Tensor3 down_rad(num_layers + 1, nummu, nstokes, 0.);
+  RT4Work rt4_work;
+  rt4_work.resize(nstokes, nummu, num_layers);
 
   radtrano_(nstokes,
             nummu,
@@ -1637,7 +1646,10 @@ void rt4_test(Tensor4& out_rad,
             //outlevels.get_c_array(),
             mu_values.get_c_array(),
             up_rad.get_c_array(),
-            down_rad.get_c_array());
+            down_rad.get_c_array(),
+            rt4_work.reflect.get_c_array(),
+            rt4_work.trans.get_c_array(),
+            rt4_work.source.get_c_array());
 
   //so far, output is in
   //    units W/m^2 um sr
@@ -1659,4 +1671,13 @@ void rt4_test(Tensor4& out_rad,
   //WriteXML( "ascii", out_rad, "out_rad.xml", 0, "out_rad", "", "", verbosity );
 }
 
+void RT4Work::resize(const Index& nstokes,
+                     const Index& nummu,
+                     const Index& num_layers) {
+  const Index n = nstokes * nummu;
+  reflect.resize(2 * n * n * (num_layers + 1));
+  trans.resize(2 * n * n * (num_layers + 1));
+  source.resize(2 * n * (num_layers + 1));
+}
+
 #endif /* ENABLE_RT4 */
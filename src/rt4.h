@@ -414,6 +414,26 @@ void rt4_test(Tensor4& out_rad,
               const String& datapath,
               const Verbosity& verbosity);
 
+//! Work arrays for radtrano_
+/*!
+  RT4 stores the reflection and transmission matrices and the source vectors
+  of all layers in these arrays. They are owned by the caller, so that
+  concurrent calls of radtrano_ do not share any memory.
+*/
+struct RT4Work {
+  //! Resize the arrays, keeping them if the size does not change
+  /*!
+    \param[in]  nstokes Number of Stokes components
+    \param[in]  nummu Number of single hemisphere angles
+    \param[in]  num_layers Number of atmospheric layers
+  */
+  void resize(const Index& nstokes, const Index& nummu, const Index& num_layers);
+
+  Vector reflect;
+  Vector trans;
+  Vector source;
+};
+
 extern "C" {
 
 void radtrano_(const Index& nstokes,
@@ -443,7 +463,10 @@ void radtrano_(const Index& nstokes,
                //const Index*   outlevels,
                Numeric* mu_values,
                Numeric* up_rad,
-               Numeric* down_rad);
+               Numeric* down_rad,
+               Numeric* reflect,
+               Numeric* trans,
+               Numeric* source);
 
 void double_gauss_quadrature_(const Index& nummu,
                               Numeric* mu_values,
@@ -32,6 +32,7 @@
 #include "rte.h"
 #include <cmath>
 #include <stdexcept>
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "legacy_continua.h"
@@ -39,6 +40,7 @@
 #include "lin_alg.h"
 #include "logic.h"
 #include "math_funcs.h"
+#include "matpack_arena.h"
 #include "montecarlo.h"
 #include "physics_funcs.h"
 #include "ppath.h"
@@ -1172,6 +1174,9 @@ void get_stepwise_clearsky_propmat(
     const Numeric& ppath_temperature,
     const Numeric& ppath_pressure,
     const bool& jacobian_do) {
+  // Temporaries of the agenda are taken from the thread's arena
+  MatpackArenaScope arena_scope;
+
   // Perform the propagation matrix computations
   propmat_clearsky_agendaExecute(ws,
                                  K,
@@ -1845,131 +1850,82 @@ void iyb_calc(Workspace& ws,
   // all outout
   ArrayOfArrayOfMatrix iy_aux_array(nlos);
 
-  // We have to make a local copy of the Workspace and the agendas because
-  // only non-reference types can be declared firstprivate in OpenMP
-  Workspace l_ws(ws);
-  Agenda l_iy_main_agenda(iy_main_agenda);
-  Agenda l_geo_pos_agenda(geo_pos_agenda);
-
   String fail_msg;
   bool failed = false;
-  if (nlos >= arts_omp_get_max_threads() || nlos * 10 >= nf) {
-    out3 << "  Parallelizing los loop (" << nlos << " iterations, " << nf
-         << " frequencies)\n";
 
-    // Start of actual calculations
-#pragma omp parallel for if (!arts_omp_in_parallel()) \
-    firstprivate(l_ws, l_iy_main_agenda, l_geo_pos_agenda)
-    for (Index ilos = 0; ilos < nlos; ilos++) {
-      // Skip remaining iterations if an error occurred
-      if (failed) continue;
-
-      Ppath ppath;
-      iyb_calc_body(failed,
-                    fail_msg,
-                    iy_aux_array,
-                    l_ws,
-                    ppath,
-                    iyb,
-                    diyb_dx,
-                    mblock_index,
-                    atmosphere_dim,
-                    nlte_field,
-                    cloudbox_on,
-                    stokes_dim,
-                    sensor_pos,
-                    sensor_los,
-                    transmitter_pos,
-                    mblock_dlos_grid,
-                    iy_unit,
-                    l_iy_main_agenda,
-                    j_analytical_do,
-                    jacobian_quantities,
-                    jacobian_indices,
-                    f_grid,
-                    iy_aux_vars,
-                    ilos,
-                    nf);
-
-      // Skip remaining iterations if an error occurred
-      if (failed) continue;
-
-      // Note that this code is found in two places inside the function
-      Vector geo_pos;
-      try {
-        geo_pos_agendaExecute(l_ws, geo_pos, ppath, l_geo_pos_agenda);
-        if (geo_pos.nelem()) {
-          ARTS_USER_ERROR_IF (geo_pos.nelem() != 5,
-                "Wrong size of *geo_pos* obtained from *geo_pos_agenda*.\n"
-                "The length of *geo_pos* must be zero or five.");
-
-          geo_pos_matrix(ilos, joker) = geo_pos;
-        }
-      } catch (const std::exception& e) {
+  // Calculation of a single los, using the workspace l_ws
+  auto los_body = [&](Workspace& l_ws, const Index ilos) {
+    // Skip remaining iterations if an error occurred
+    if (failed) return;
+
+    Ppath ppath;
+    iyb_calc_body(failed,
+                  fail_msg,
+                  iy_aux_array,
+                  l_ws,
+                  ppath,
+                  iyb,
+                  diyb_dx,
+                  mblock_index,
+                  atmosphere_dim,
+                  nlte_field,
+                  cloudbox_on,
+                  stokes_dim,
+                  sensor_pos,
+                  sensor_los,
+                  transmitter_pos,
+                  mblock_dlos_grid,
+                  iy_unit,
+                  iy_main_agenda,
+                  j_analytical_do,
+                  jacobian_quantities,
+                  jacobian_indices,
+                  f_grid,
+                  iy_aux_vars,
+                  ilos,
+                  nf);
+
+    // Skip remaining iterations if an error occurred
+    if (failed) return;
+
+    Vector geo_pos;
+    try {
+      geo_pos_agendaExecute(l_ws, geo_pos, ppath, geo_pos_agenda);
+      if (geo_pos.nelem()) {
+        ARTS_USER_ERROR_IF (geo_pos.nelem() != 5,
+              "Wrong size of *geo_pos* obtained from *geo_pos_agenda*.\n"
+              "The length of *geo_pos* must be zero or five.");
+
+        geo_pos_matrix(ilos, joker) = geo_pos;
+      }
+    } catch (const std::exception& e) {
 #pragma omp critical(iyb_calc_fail)
-        {
-          fail_msg = e.what();
-          failed = true;
-        }
+      {
+        fail_msg = e.what();
+        failed = true;
       }
     }
+  };
+
+  // Inside a parallel region (e.g. yCalc parallelising over measurement
+  // blocks) the los are always made tasks, so idle threads of the team
+  // can help with this measurement block.
+  if (arts_omp_in_parallel() || nlos >= arts_omp_get_max_threads() ||
+      nlos * 10 >= nf) {
+    out3 << "  Parallelizing los loop (" << nlos << " iterations, " << nf
+         << " frequencies)\n";
+
+    arts_omp_taskloop(nlos, [&](const Index ilos) {
+      // Each task needs its own copy of the workspace
+      PooledWorkspace l_ws(ws);
+      los_body(*l_ws, ilos);
+    });
   } else {
     out3 << "  Not parallelizing los loop (" << nlos << " iterations, " << nf
          << " frequencies)\n";
 
-    for (Index ilos = 0; ilos < nlos; ilos++) {
-      // Skip remaining iterations if an error occurred
-      if (failed) continue;
-
-      Ppath ppath;
-      iyb_calc_body(failed,
-                    fail_msg,
-                    iy_aux_array,
-                    l_ws,
-                    ppath,
-                    iyb,
-                    diyb_dx,
-                    mblock_index,
-                    atmosphere_dim,
-                    nlte_field,
-                    cloudbox_on,
-                    stokes_dim,
-                    sensor_pos,
-                    sensor_los,
-                    transmitter_pos,
-                    mblock_dlos_grid,
-                    iy_unit,
-                    l_iy_main_agenda,
-                    j_analytical_do,
-                    jacobian_quantities,
-                    jacobian_indices,
-                    f_grid,
-                    iy_aux_vars,
-                    ilos,
-                    nf);
-
-      // Skip remaining iterations if an error occurred
-      if (failed) continue;
-
-      // Note that this code is found in two places inside the function
-      Vector geo_pos;
-      try {
-        geo_pos_agendaExecute(l_ws, geo_pos, ppath, l_geo_pos_agenda);
-        if (geo_pos.nelem()) {
-          ARTS_USER_ERROR_IF (geo_pos.nelem() != 5,
-                "Wrong size of *geo_pos* obtained from *geo_pos_agenda*.\n"
-                "The length of *geo_pos* must be zero or five.");
-
-          geo_pos_matrix(ilos, joker) = geo_pos;
-        }
-      } catch (const std::exception& e) {
-#pragma omp critical(iyb_calc_fail)
-        {
-          fail_msg = e.what();
-          failed = true;
-        }
-      }
-    }
+    PooledWorkspace l_ws(ws);
+    for (Index ilos = 0; ilos < nlos; ilos++) los_body(*l_ws, ilos);
   }
 
   ARTS_USER_ERROR_IF (failed,
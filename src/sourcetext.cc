@@ -26,6 +26,13 @@ void SourceText::AppendFile(const String& name) {
   read_text_from_file(mText, name);
 }
 
+void SourceText::AppendText(const String& name, const ArrayOfString& text) {
+  mSfLine.push_back(mText.nelem());
+  mSfName.push_back(name);
+
+  mText.insert(mText.end(), text.begin(), text.end());
+}
+
 void SourceText::AdvanceChar() {
   if (mColumn < mText[mLine].nelem() - 1) {
     ++mColumn;
@@ -44,6 +44,11 @@ class SourceText {
       @see read_text_from_file */
   void AppendFile(const String& name);
 
+  /** Appends the given lines to the source text.
+      @param name Name of the text used in error messages.
+      @param text Lines of text. */
+  void AppendText(const String& name, const ArrayOfString& text);
+
   /** Return the current character. */
   char Current() {
     if (reachedEot()) throw Eot("", this->File(), this->Line(), this->Column());
@@ -0,0 +1,208 @@
+/* Copyright (C) 2026, The ARTS Developers.
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   test_gas_abs_lookup.cc
+  \author The ARTS Developers
+  \date   2026-10-17
+
+  \brief  Test the batched lookup table extraction against the per point one.
+
+  The table is given as the only argument. It must have temperature and
+  H2O perturbations, e.g., the table of the heating rates test.
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include "gas_abs_lookup.h"
+#include "global_data.h"
+#include "xml_io.h"
+
+//! Interpolation orders, the defaults of the workspace variables
+constexpr Index p_interp_order = 5;
+constexpr Index t_interp_order = 7;
+constexpr Index h2o_interp_order = 5;
+
+//! Allow extrapolation, the test points are not close to the reference
+constexpr Numeric extpolfac = 1e3;
+
+//! Compare batched and per point extraction, return the number of failures
+/*!
+  All points are extracted in one call and then one by one. The results
+  must agree to a relative difference of 1e-13.
+
+  \param gal             The adapted lookup table.
+  \param f_grid          Frequencies to extract.
+  \param f_interp_order  Frequency interpolation order.
+  \param p               Pressures of the points.
+  \param t               Temperatures of the points.
+  \param vmrs            VMRs of the points, dimension [species, points].
+  \param msg             Name of the case, for the output.
+*/
+Index compare_extract(const GasAbsLookup& gal,
+                      ConstVectorView f_grid,
+                      const Index f_interp_order,
+                      ConstVectorView p,
+                      ConstVectorView t,
+                      ConstMatrixView vmrs,
+                      const String& msg) {
+  const Index n_points = p.nelem();
+  const Index n_species = vmrs.nrows();
+  const Index nf = f_grid.nelem();
+
+  Tensor3 sga_path(n_points, n_species, nf);
+  gal.Extract(sga_path,
+              p_interp_order,
+              t_interp_order,
+              h2o_interp_order,
+              f_interp_order,
+              p,
+              t,
+              vmrs,
+              f_grid,
+              extpolfac);
+
+  Matrix sga;
+  Numeric max_diff = 0;
+  Index nfail = 0;
+  for (Index ip = 0; ip < n_points; ip++) {
+    gal.Extract(sga,
+                p_interp_order,
+                t_interp_order,
+                h2o_interp_order,
+                f_interp_order,
+                p[ip],
+                t[ip],
+                vmrs(joker, ip),
+                f_grid,
+                extpolfac);
+
+    for (Index is = 0; is < n_species; is++)
+      for (Index iv = 0; iv < nf; iv++) {
+        const Numeric diff = std::abs(sga_path(ip, is, iv) - sga(is, iv));
+        if (diff > 1e-13 * std::abs(sga(is, iv))) nfail++;
+        if (sga(is, iv) != 0)
+          max_diff = std::max(max_diff, diff / std::abs(sga(is, iv)));
+      }
+  }
+
+  std::cout << msg << ": max relative difference " << max_diff << "\n";
+  if (nfail)
+    std::cerr << msg << ": " << nfail
+              << " values differ by more than 1e-13 relative\n";
+  return nfail;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " LOOKUP_TABLE.xml\n";
+    return 1;
+  }
+
+  define_species_data();
+  define_species_map();
+
+  const Verbosity verbosity;
+
+  try {
+    GasAbsLookup gal;
+    xml_read_from_file(argv[1], gal, verbosity);
+
+    // The species of the heating rates table:
+    ArrayOfArrayOfSpeciesTag abs_species;
+    for (const String& names :
+         {String("H2O, H2O-SelfContCKDMT252, H2O-ForeignContCKDMT252"),
+          String("O3"),
+          String("O2, O2-CIAfunCKDMT100"),
+          String("CO2, CO2-CKDMT252"),
+          String("N2, N2-CIAfunCKDMT252, N2-CIArotCKDMT252"),
+          String("CH4"),
+          String("CO")}) {
+      ArrayOfSpeciesTag tags;
+      array_species_tag_from_string(tags, names);
+      abs_species.push_back(tags);
+    }
+
+    const Vector f_grid = gal.GetFgrid();
+    gal.Adapt(abs_species, f_grid, verbosity);
+
+    // Points between the pressure levels of the table, with rising
+    // temperature and falling humidity:
+    const Vector& p_grid = gal.GetPgrid();
+    const Index n_points = 20;
+    Vector p(n_points), t(n_points);
+    Matrix vmrs(abs_species.nelem(), n_points);
+    Vector vmr_point = {0, 1e-6, 0.21, 4e-4, 0.78, 1.8e-6, 1e-7};
+    for (Index ip = 0; ip < n_points; ip++) {
+      const Index i = ip * (p_grid.nelem() - 2) / (n_points - 1);
+      p[ip] = 0.7 * p_grid[i] + 0.3 * p_grid[i + 1];
+      t[ip] = 200 + 4 * Numeric(ip);
+      vmr_point[0] = 1e-2 / Numeric(ip + 1);
+      vmrs(joker, ip) = vmr_point;
+    }
+
+    // Frequencies between table frequencies, for interpolation:
+    const Index nf = f_grid.nelem();
+    Vector f_part(nf - 3);
+    for (Index iv = 0; iv < f_part.nelem(); iv++)
+      f_part[iv] = 0.5 * (f_grid[iv + 1] + f_grid[iv + 2]);
+
+    Index nfail = 0;
+    nfail += compare_extract(gal, f_grid, 0, p, t, vmrs, "Full grid");
+    nfail += compare_extract(gal, f_part, 1, p, t, vmrs, "Partial grid");
+
+    // A block of the table grid, as iyEmissionStandard passes with
+    // f_block_size, must give the same values as the full grid:
+    const Index i0 = 2, nb = nf / 2;
+    const Vector f_block = f_grid[Range(i0, nb)];
+    nfail += compare_extract(gal, f_block, 0, p, t, vmrs, "Grid block");
+    Tensor3 sga_full(n_points, abs_species.nelem(), nf);
+    Tensor3 sga_block(n_points, abs_species.nelem(), nb);
+    gal.Extract(sga_full, p_interp_order, t_interp_order, h2o_interp_order,
+                0, p, t, vmrs, f_grid, extpolfac);
+    gal.Extract(sga_block, p_interp_order, t_interp_order, h2o_interp_order,
+                0, p, t, vmrs, f_block, extpolfac);
+    Index nblock_fail = 0;
+    for (Index ip = 0; ip < n_points; ip++)
+      for (Index is = 0; is < abs_species.nelem(); is++)
+        for (Index iv = 0; iv < nb; iv++)
+          if (sga_block(ip, is, iv) != sga_full(ip, is, i0 + iv))
+            nblock_fail++;
+    if (nblock_fail)
+      std::cerr << "Grid block: " << nblock_fail
+                << " values differ from the full grid\n";
+    nfail += nblock_fail;
+
+    // The same from a mapped table, where the levels are decoded:
+    const String mapped_file = "test_gas_abs_lookup.mapped";
+    gal.WriteMapped(mapped_file, LookupStorage::ScaledInt16, verbosity);
+    GasAbsLookup mapped;
+    mapped.ReadMapped(mapped_file, verbosity);
+    mapped.Adapt(abs_species, f_grid, verbosity);
+    nfail += compare_extract(mapped, f_grid, 0, p, t, vmrs, "Mapped full grid");
+    nfail +=
+        compare_extract(mapped, f_part, 1, p, t, vmrs, "Mapped partial grid");
+
+    if (nfail) return 1;
+  } catch (const std::runtime_error& e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
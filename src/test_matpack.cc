@@ -19,6 +19,8 @@
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <set>
+#include <thread>
 #include "array.h"
 #include "describe.h"
 #include "exceptions.h"
@@ -1807,6 +1809,75 @@ void test48() {
   }
 }
 
+//! Check that arena blocks are reused once all their data is freed.
+/*!
+  \return True if the test passed, false otherwise.
+*/
+bool test_arena_reuse() {
+  MatpackArenaScope arena_scope;
+
+  // 10000 vectors of 8 kB are much more than one arena block. Without
+  // reuse, each vector would get its own address.
+  std::set<const Numeric*> addresses;
+  for (Index i = 0; i < 10000; i++) {
+    Vector v(1000, Numeric(i));
+    addresses.insert(v.get_c_array());
+  }
+
+  const bool pass = addresses.size() < 1000;
+  cout << "test arena reuse: " << addresses.size()
+       << " different addresses for 10000 vectors, "
+       << (pass ? "Passed." : "Failed.") << endl;
+  return pass;
+}
+
+//! Free arena data on another thread than the one that allocated it.
+/*!
+  Vectors from the arena of this thread are freed by another thread,
+  after which their block must be reused here. A vector from the arena of
+  another thread is used and freed after that thread has exited.
+
+  \return True if the test passed, false otherwise.
+*/
+bool test_arena_other_thread() {
+  MatpackArenaScope arena_scope;
+  bool pass = true;
+
+  // Enough vectors to fill more than one block
+  ArrayOfVector vs;
+  std::set<const Numeric*> freed;
+  for (Index i = 0; i < 200; i++) {
+    vs.emplace_back(1000, Numeric(i));
+    freed.insert(vs.back().get_c_array());
+  }
+  bool values_ok = true;
+  std::thread([&vs, &values_ok]() {
+    for (Index i = 0; i < vs.nelem(); i++)
+      values_ok = values_ok and vs[i][999] == Numeric(i);
+    vs.clear();
+  }).join();
+  pass = pass and values_ok;
+
+  bool reused = false;
+  for (Index i = 0; i < 400; i++) {
+    Vector v(1000, 0);
+    reused = reused or freed.count(v.get_c_array());
+  }
+  pass = pass and reused;
+
+  Vector outlived;
+  std::thread([&outlived]() {
+    MatpackArenaScope thread_arena_scope;
+    outlived = Vector(1000, 2);
+  }).join();
+  pass = pass and outlived[0] == 2 and outlived[999] == 2;
+  outlived = Vector();
+
+  cout << "test arena other thread: " << (pass ? "Passed." : "Failed.")
+       << endl;
+  return pass;
+}
+
 int main() {
   //   test1();
   //   test2();
@@ -1880,6 +1951,8 @@ int main() {
 
   //test_diagonal( 100 );
   //test_empty();
+  test_arena_reuse();
+  test_arena_other_thread();
 
   return 1;
 }
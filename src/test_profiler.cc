@@ -0,0 +1,121 @@
+/* Copyright (C) 2026, The ARTS Developers.
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   test_profiler.cc
+  \author The ARTS Developers
+  \date   2026-10-17
+
+  \brief  Test the report of the agenda and method profiler.
+*/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "profiler.h"
+
+//! Busy wait, so that wall and CPU time both increase
+void spin(const Numeric seconds) {
+  const auto end = std::chrono::steady_clock::now() +
+                   std::chrono::duration<Numeric>(seconds);
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+String read_file(const String& filename) {
+  std::ifstream ifs(filename.c_str());
+  std::ostringstream os;
+  os << ifs.rdbuf();
+  return os.str();
+}
+
+//! Check that text contains what, print a message if not
+Index expect(const String& text, const String& what) {
+  if (text.find(what) != std::string::npos) return 0;
+  std::cerr << "Missing in profiler report: " << what << "\n";
+  return 1;
+}
+
+int main() {
+  // Nothing is recorded while the profiler is off
+  { profiler::Scope off("off_agenda", true); }
+
+  // Enable without registering the report at exit
+  profiler::enabled = true;
+
+  for (Index i = 0; i < 3; i++) {
+    profiler::Scope agenda("test_agenda", true);
+    spin(1e-3);
+    {
+      profiler::Scope method("TestMethod", false);
+      spin(2e-3);
+    }
+  }
+
+  // The scope is also closed when the call throws
+  try {
+    profiler::Scope method("FailingMethod", false);
+    throw std::runtime_error("failed");
+  } catch (const std::runtime_error&) {
+  }
+
+  profiler::enabled = false;
+
+  Index nfail = 0;
+
+  profiler::write_report("test_profiler.json");
+  const String json = read_file("test_profiler.json");
+  std::cout << json;
+  nfail += expect(json, "{\"name\": \"test_agenda\", \"type\": \"agenda\", "
+                        "\"calls\": 3");
+  nfail += expect(json, "{\"name\": \"TestMethod\", \"type\": \"method\", "
+                        "\"calls\": 3");
+  nfail += expect(json, "{\"name\": \"FailingMethod\", \"type\": \"method\", "
+                        "\"calls\": 1");
+  if (json.find("off_agenda") != std::string::npos) {
+    std::cerr << "Call recorded while the profiler was off\n";
+    nfail++;
+  }
+
+  // Folded stacks give the self time in microseconds. The method spins
+  // 3 x 2 ms, the agenda itself 3 x 1 ms.
+  profiler::write_report("test_profiler.folded");
+  const String folded = read_file("test_profiler.folded");
+  std::cout << folded;
+  for (const String& path : {String("Thread 0;test_agenda "),
+                             String("Thread 0;test_agenda;TestMethod ")}) {
+    const auto pos = folded.find(path);
+    if (pos == std::string::npos) {
+      std::cerr << "Missing in folded report: " << path << "\n";
+      nfail++;
+      continue;
+    }
+    const Index self_us = std::stol(folded.substr(pos + path.length()));
+    const Index min_us =
+        path.find("TestMethod") == std::string::npos ? 3000 : 6000;
+    if (self_us < min_us) {
+      std::cerr << "Self time of " << path << "is " << self_us
+                << " us, expected at least " << min_us << " us\n";
+      nfail++;
+    }
+  }
+
+  if (nfail) std::cerr << nfail << " profiler checks failed\n";
+  return nfail ? 1 : 0;
+}
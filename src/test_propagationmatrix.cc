@@ -23,10 +23,12 @@
  * \brief  Test Propagation Matrix Internal Partial Derivatives and PropagationMatrix
  */
 
+#include <chrono>
 #include <random>
 #include "absorption.h"
 #include "arts.h"
 #include "global_data.h"
+#include "lin_alg.h"
 #include "lineshapemodel.h"
 #include "linefunctions.h"
 #include "linescaling.h"
@@ -444,6 +446,203 @@ void test_sinc_likes_0limit() {
               << '\n';
 }
 
+/** Compares the Faddeeva approximations with the reference implementation
+ *
+ * @return Number of y values where an approximation exceeds its documented
+ *         relative error bound
+ */
+Index test_faddeeva_approximations() {
+  constexpr Index nx = 100001;
+  // Relative error bounds as documented for FaddeevaAlgorithm
+  constexpr Numeric max_error_hw32 = 1e-6;
+  constexpr Numeric max_error_hw24 = 1e-4;
+  Index nfail = 0;
+  const Vector y = {1e-8, 1e-4, 1e-2, 1e-1, 1, 10, 100};
+
+  Eigen::VectorXcd z(nx), ref(nx), W(nx);
+
+  std::cout << std::scientific << std::setprecision(3)
+            << "y\tmax|w/w_ref-1| HumlicekWeideman32\tHumlicekWeideman24\n";
+  for (auto Y : y) {
+    for (Index i = 0; i < nx; i++) z[i] = Complex(-500 + 0.01 * Numeric(i), Y);
+    Linefunctions::set_faddeeva(ref, z, Linefunctions::FaddeevaAlgorithm::Faddeeva);
+
+    std::cout << Y;
+    for (auto alg : {Linefunctions::FaddeevaAlgorithm::HumlicekWeideman32,
+                     Linefunctions::FaddeevaAlgorithm::HumlicekWeideman24}) {
+      Linefunctions::set_faddeeva(W, z, alg);
+      const Numeric err = (W.array() / ref.array() - 1).abs().maxCoeff();
+      const Numeric max_error =
+          alg == Linefunctions::FaddeevaAlgorithm::HumlicekWeideman32
+              ? max_error_hw32
+              : max_error_hw24;
+      std::cout << '\t' << err;
+      if (not(err <= max_error)) {
+        std::cout << " (FAILED, bound " << max_error << ")";
+        nfail++;
+      }
+    }
+    std::cout << '\n';
+  }
+
+  // Timing close to the line center where the approximations differ the most
+  for (Index i = 0; i < nx; i++) z[i] = Complex(-20 + 4e-4 * Numeric(i), 0.1);
+  for (auto alg : Linefunctions::enumtyps::FaddeevaAlgorithmTypes) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (Index i = 0; i < 10; i++) Linefunctions::set_faddeeva(W, z, alg);
+    const auto end = std::chrono::high_resolution_clock::now();
+    std::cout << alg << ":\t"
+              << std::chrono::duration<double>(end - start).count() / 10
+              << " s per " << nx << " points\n";
+  }
+
+  return nfail;
+}
+
+Index test_transmat4_batched() {
+  constexpr Index nf = 10000;
+  constexpr Index nq = 3;
+  constexpr Index nrep = 10;
+  const Numeric r = 1.5;
+  const Numeric dr_dT1 = 1e-3, dr_dT2 = -2e-3;
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<Numeric> dis(-0.3, 0.3), pos(0.5, 1.0);
+
+  PropagationMatrix K1(nf, 4), K2(nf, 4);
+  ArrayOfPropagationMatrix dK1(nq, PropagationMatrix(nf, 4)),
+      dK2(nq, PropagationMatrix(nf, 4));
+  for (Index iv = 0; iv < nf; iv++) {
+    // Every 10th frequency is unpolarized, every 10th other almost so
+    const Numeric scale = iv % 10 == 0 ? 0.0 : iv % 10 == 1 ? 1e-6 : 1.0;
+    for (auto* K : {&K1, &K2}) {
+      K->Kjj()[iv] = pos(gen);
+      for (Index i = 1; i < 7; i++) K->Data()(0, 0, iv, i) = scale * dis(gen);
+    }
+    for (Index j = 0; j < nq; j++)
+      for (Index i = 0; i < 7; i++) {
+        dK1[j].Data()(0, 0, iv, i) = dis(gen);
+        dK2[j].Data()(0, 0, iv, i) = dis(gen);
+      }
+  }
+
+  // Batched kernel
+  TransmissionMatrix T(nf, 4);
+  ArrayOfTransmissionMatrix dT1(nq, TransmissionMatrix(nf, 4)),
+      dT2(nq, TransmissionMatrix(nf, 4)), empty(0);
+  const ArrayOfPropagationMatrix no_deriv(0);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (Index i = 0; i < nrep; i++)
+    stepwise_transmission(T, empty, empty, K1, K2, no_deriv, no_deriv, r, 0, 0, -1);
+  auto end = std::chrono::high_resolution_clock::now();
+  const Numeric t_batched = std::chrono::duration<double>(end - start).count() / nrep;
+
+  start = std::chrono::high_resolution_clock::now();
+  for (Index i = 0; i < nrep; i++)
+    stepwise_transmission(T, dT1, dT2, K1, K2, dK1, dK2, r, dr_dT1, dr_dT2, 0);
+  end = std::chrono::high_resolution_clock::now();
+  const Numeric dt_batched = std::chrono::duration<double>(end - start).count() / nrep;
+
+  // Per-frequency path
+  Tensor3 Tref(nf, 4, 4);
+  Tensor4 dT1ref(nq, nf, 4, 4), dT2ref(nq, nf, 4, 4);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (Index i = 0; i < nrep; i++)
+    compute_transmission_matrix(Tref, r, K1, K2);
+  end = std::chrono::high_resolution_clock::now();
+  const Numeric t_ref = std::chrono::duration<double>(end - start).count() / nrep;
+
+  start = std::chrono::high_resolution_clock::now();
+  for (Index i = 0; i < nrep; i++)
+    compute_transmission_matrix_and_derivative(
+        Tref, dT1ref, dT2ref, r, K1, K2, dK1, dK2, dr_dT1, dr_dT2, 0);
+  end = std::chrono::high_resolution_clock::now();
+  const Numeric dt_ref = std::chrono::duration<double>(end - start).count() / nrep;
+
+  // Differences relative to the largest element of the reference matrix
+  auto rel_diff = [](auto&& A, ConstMatrixView B) {
+    Numeric diff = 0, norm = 0;
+    for (Index i = 0; i < 4; i++)
+      for (Index k = 0; k < 4; k++) {
+        diff = std::max(diff, std::abs(A(i, k) - B(i, k)));
+        norm = std::max(norm, std::abs(B(i, k)));
+      }
+    return norm > 0 ? diff / norm : diff;
+  };
+
+  // The 4x4 matrix of a propagation matrix at frequency iv
+  auto set_matrix = [](MatrixView M, const PropagationMatrix& K, Index iv) {
+    const ConstVectorView k = K.Data()(0, 0, iv, joker);
+    const Numeric m[4][4] = {{k[0], k[1], k[2], k[3]},
+                             {k[1], k[0], k[4], k[5]},
+                             {k[2], -k[4], k[0], k[6]},
+                             {k[3], -k[5], -k[6], k[0]}};
+    for (Index i = 0; i < 4; i++)
+      for (Index j = 0; j < 4; j++) M(i, j) = m[i][j];
+  };
+
+  // The per-frequency derivatives approximate the limit of almost
+  // unpolarized absorption, so the derivatives are compared to the Pade
+  // approximation of exp(A) and its derivative instead.  As the kernels,
+  // this keeps only the absorption derivative without polarization.
+  Numeric max_diff = 0, max_ddiff = 0;
+  Matrix A(4, 4), dA(4, 4), F(4, 4), dF(4, 4), M1(4, 4), M2(4, 4), dM(4, 4);
+  for (Index iv = 0; iv < nf; iv++) {
+    max_diff = std::max(max_diff, rel_diff(T.Mat4(iv), Tref(iv, joker, joker)));
+
+    set_matrix(M1, K1, iv);
+    set_matrix(M2, K2, iv);
+    A = M1;
+    A += M2;
+    bool polarized = false;
+    for (Index i = 0; i < 4; i++)
+      for (Index k = 0; k < 4; k++) polarized |= i != k and A(i, k) != 0;
+    for (Index j = 0; j < nq; j++) {
+      for (Index lev = 0; lev < 2; lev++) {
+        set_matrix(dM, (lev == 0 ? dK1 : dK2)[j], iv);
+        const Numeric dr = j == 0 ? (lev == 0 ? dr_dT1 : dr_dT2) : 0.0;
+        for (Index i = 0; i < 4; i++)
+          for (Index k = 0; k < 4; k++)
+            dA(i, k) = polarized or i == k
+                           ? -0.5 * (r * dM(i, k) + dr * A(i, k))
+                           : 0.0;
+        F = A;
+        F *= -0.5 * r;
+        matrix_exp_dmatrix_exp(F, dF, Matrix(F), dA);
+        max_ddiff = std::max(
+            max_ddiff, rel_diff((lev == 0 ? dT1 : dT2)[j].Mat4(iv), dF));
+      }
+    }
+  }
+
+  // The derivatives lose some digits in the cancellations of the
+  // coefficient derivatives
+  const Numeric max_diff_bound = 1e-13, max_ddiff_bound = 1e-11;
+
+  std::cout << "Stokes dim 4, " << nf << " frequencies, " << nq
+            << " derivatives\n"
+            << "transmission:\tbatched " << t_batched << " s\tper-frequency "
+            << t_ref << " s\tmax relative difference " << max_diff << '\n'
+            << "with derivatives:\tbatched " << dt_batched
+            << " s\tper-frequency " << dt_ref
+            << " s\tmax relative difference to Pade " << max_ddiff << '\n';
+
+  Index nfail = 0;
+  if (max_diff > max_diff_bound) {
+    std::cerr << "Transmission differs by more than " << max_diff_bound
+              << " relative\n";
+    nfail++;
+  }
+  if (max_ddiff > max_ddiff_bound) {
+    std::cerr << "Transmission derivatives differ by more than "
+              << max_ddiff_bound << " relative\n";
+    nfail++;
+  }
+  return nfail;
+}
+
 void test_zeeman() {
   define_species_data();
   define_species_map();
@@ -648,7 +847,13 @@ int main(int n, char **argc) {
     test_transmat_to_cumulativetransmat();
     test_sinc_likes_0limit();*/
   
-  if (n == 2 and String(argc[1]) == "new") {
+  if (n == 2 and String(argc[1]) == "faddeeva") {
+    if (test_faddeeva_approximations()) return 1;
+  }
+  else if (n == 2 and String(argc[1]) == "transmat4") {
+    if (test_transmat4_batched()) return 1;
+  }
+  else if (n == 2 and String(argc[1]) == "new") {
     std::cout<<"new test\n";
     test_hitran2017(true);
   }
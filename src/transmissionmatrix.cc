@@ -219,128 +219,6 @@ inline void transmat3(TransmissionMatrix& T,
   }
 }
 
-inline void transmat4(TransmissionMatrix& T,
-                      const PropagationMatrix& K1,
-                      const PropagationMatrix& K2,
-                      const Numeric& r,
-                      const Index iz = 0,
-                      const Index ia = 0) noexcept {
-  static constexpr Numeric sqrt_05 = Constant::inv_sqrt_2;
-  for (Index i = 0; i < K1.NumberOfFrequencies(); i++) {
-    const Numeric a = -0.5 * r * (K1.Kjj(iz, ia)[i] + K2.Kjj(iz, ia)[i]),
-                  b = -0.5 * r * (K1.K12(iz, ia)[i] + K2.K12(iz, ia)[i]),
-                  c = -0.5 * r * (K1.K13(iz, ia)[i] + K2.K13(iz, ia)[i]),
-                  d = -0.5 * r * (K1.K14(iz, ia)[i] + K2.K14(iz, ia)[i]),
-                  u = -0.5 * r * (K1.K23(iz, ia)[i] + K2.K23(iz, ia)[i]),
-                  v = -0.5 * r * (K1.K24(iz, ia)[i] + K2.K24(iz, ia)[i]),
-                  w = -0.5 * r * (K1.K34(iz, ia)[i] + K2.K34(iz, ia)[i]);
-    const Numeric exp_a = std::exp(a);
-
-    if (b == 0. and c == 0. and d == 0. and u == 0. and v == 0. and w == 0.)
-      T.Mat4(i).noalias() = Eigen::Matrix4d::Identity() * exp_a;
-    else {
-      const Numeric b2 = b * b, c2 = c * c, d2 = d * d, u2 = u * u, v2 = v * v,
-                    w2 = w * w;
-
-      const Numeric tmp =
-          w2 * w2 + 2 * (b2 * (b2 * 0.5 + c2 + d2 - u2 - v2 + w2) +
-                         c2 * (c2 * 0.5 + d2 - u2 + v2 - w2) +
-                         d2 * (d2 * 0.5 + u2 - v2 - w2) +
-                         u2 * (u2 * 0.5 + v2 + w2) + v2 * (v2 * 0.5 + w2) +
-                         4 * (b * d * u * w - b * c * v * w - c * d * u * v));
-      const Complex Const1 = std::sqrt(Complex(tmp, 0));
-      const Numeric Const2 = b2 + c2 + d2 - u2 - v2 - w2;
-
-      const Complex x = std::sqrt(Const2 + Const1) * sqrt_05;
-      const Complex y = std::sqrt(Const2 - Const1) * sqrt_05 * Complex(0, 1);
-      const Complex x2 = x * x;
-      const Complex y2 = y * y;
-      const Complex cy = std::cos(y);
-      const Complex sy = std::sin(y);
-      const Complex cx = std::cosh(x);
-      const Complex sx = std::sinh(x);
-
-      const bool x_zero = std::abs(x) < lower_is_considered_zero_for_sinc_likes;
-      const bool y_zero = std::abs(y) < lower_is_considered_zero_for_sinc_likes;
-      const bool both_zero = y_zero and x_zero;
-      const bool either_zero = y_zero or x_zero;
-
-      /* Using:
-         *    lim x→0 [({cosh(x),cos(x)} - 1) / x^2] → 1/2
-         *    lim x→0 [{sinh(x),sin(x)} / x]  → 1
-         *    inv_x2 := 1 for x == 0,
-         *    -i sin(ix) → sinh(x)
-         *    cos(ix) → cosh(x)
-         *    C0, C1, C2 ∝ [1/x^2]
-         */
-      const Complex ix = x_zero ? 0.0 : 1.0 / x;
-      const Complex iy = y_zero ? 0.0 : 1.0 / y;
-      const Complex inv_x2y2 =
-          both_zero
-              ? 1.0
-              : 1.0 /
-                    (x2 + y2);  // The first "1.0" is the trick for above limits
-
-      const Numeric C0 =
-          either_zero ? 1.0 : ((cy * x2 + cx * y2) * inv_x2y2).real();
-      const Numeric C1 =
-          either_zero ? 1.0 : ((sy * x2 * iy + sx * y2 * ix) * inv_x2y2).real();
-      const Numeric C2 = both_zero ? 0.5 : ((cx - cy) * inv_x2y2).real();
-      const Numeric C3 =
-          both_zero ? 1.0 / 6.0
-                    : ((x_zero ? 1.0 - sy * iy
-                               : y_zero ? sx * ix - 1.0 : sx * ix - sy * iy) *
-                       inv_x2y2)
-                          .real();
-      T.Mat4(i).noalias() =
-          exp_a * (Eigen::Matrix4d() << C0 + C2 * (b2 + c2 + d2),
-                   C1 * b + C2 * (-c * u - d * v) +
-                       C3 * (b * (b2 + c2 + d2) - u * (b * u - d * w) -
-                             v * (b * v + c * w)),
-                   C1 * c + C2 * (b * u - d * w) +
-                       C3 * (c * (b2 + c2 + d2) - u * (c * u + d * v) -
-                             w * (b * v + c * w)),
-                   C1 * d + C2 * (b * v + c * w) +
-                       C3 * (d * (b2 + c2 + d2) - v * (c * u + d * v) +
-                             w * (b * u - d * w)),
-
-                   C1 * b + C2 * (c * u + d * v) +
-                       C3 * (-b * (-b2 + u2 + v2) + c * (b * c - v * w) +
-                             d * (b * d + u * w)),
-                   C0 + C2 * (b2 - u2 - v2),
-                   C2 * (b * c - v * w) + C1 * u +
-                       C3 * (c * (c * u + d * v) - u * (-b2 + u2 + v2) -
-                             w * (b * d + u * w)),
-                   C2 * (b * d + u * w) + C1 * v +
-                       C3 * (d * (c * u + d * v) - v * (-b2 + u2 + v2) +
-                             w * (b * c - v * w)),
-
-                   C1 * c + C2 * (-b * u + d * w) +
-                       C3 * (b * (b * c - v * w) - c * (-c2 + u2 + w2) +
-                             d * (c * d - u * v)),
-                   C2 * (b * c - v * w) - C1 * u +
-                       C3 * (-b * (b * u - d * w) + u * (-c2 + u2 + w2) -
-                             v * (c * d - u * v)),
-                   C0 + C2 * (c2 - u2 - w2),
-                   C2 * (c * d - u * v) + C1 * w +
-                       C3 * (-d * (b * u - d * w) + v * (b * c - v * w) -
-                             w * (-c2 + u2 + w2)),
-
-                   C1 * d + C2 * (-b * v - c * w) +
-                       C3 * (b * (b * d + u * w) + c * (c * d - u * v) -
-                             d * (-d2 + v2 + w2)),
-                   C2 * (b * d + u * w) - C1 * v +
-                       C3 * (-b * (b * v + c * w) - u * (c * d - u * v) +
-                             v * (-d2 + v2 + w2)),
-                   C2 * (c * d - u * v) - C1 * w +
-                       C3 * (-c * (b * v + c * w) + u * (b * d + u * w) +
-                             w * (-d2 + v2 + w2)),
-                   C0 + C2 * (d2 - v2 - w2))
-                      .finished();
-    }
-  }
-}
-
 inline void dtransmat1(TransmissionMatrix& T,
                        ArrayOfTransmissionMatrix& dT1,
                        ArrayOfTransmissionMatrix& dT2,
@@ -631,6 +509,384 @@ inline void dtransmat3(TransmissionMatrix& T,
   }
 }
 
+/** Number of frequencies the Stokes dimension 4 kernels work on at a time */
+constexpr Index transmat4_nblock = 32;
+
+/** A block of 4x4 matrices, stored element by element over frequency */
+using Matrix4Block = Numeric[16][transmat4_nblock];
+
+/** Set M to the (traceless) propagation matrix of a frequency block
+ * 
+ * @param[in,out] M [[0, b, c, d], [b, 0, u, v], [c, -u, 0, w], [d, -v, -w, 0]]
+ * @param[in] b-w Elements of the propagation matrix
+ * @param[in] n Number of frequencies in the block
+ */
+inline void set_propmat4_block(Matrix4Block& M,
+                               const Numeric* b,
+                               const Numeric* c,
+                               const Numeric* d,
+                               const Numeric* u,
+                               const Numeric* v,
+                               const Numeric* w,
+                               const Index n) noexcept {
+  for (Index i = 0; i < n; i++) {
+    M[0][i] = 0;
+    M[1][i] = b[i];
+    M[2][i] = c[i];
+    M[3][i] = d[i];
+    M[4][i] = b[i];
+    M[5][i] = 0;
+    M[6][i] = u[i];
+    M[7][i] = v[i];
+    M[8][i] = c[i];
+    M[9][i] = -u[i];
+    M[10][i] = 0;
+    M[11][i] = w[i];
+    M[12][i] = d[i];
+    M[13][i] = -v[i];
+    M[14][i] = -w[i];
+    M[15][i] = 0;
+  }
+}
+
+/** Matrix multiplication C = A B, or C += A B, for a frequency block
+ * 
+ * @param[in,out] C Result
+ * @param[in] A Left matrices
+ * @param[in] B Right matrices
+ * @param[in] n Number of frequencies in the block
+ * @param[in] add Add to C instead of setting it
+ */
+inline void multiply_matrix4_block(Matrix4Block& C,
+                                   const Matrix4Block& A,
+                                   const Matrix4Block& B,
+                                   const Index n,
+                                   const bool add = false) noexcept {
+  for (Index r = 0; r < 4; r++) {
+    for (Index c = 0; c < 4; c++) {
+      Numeric* out = C[4 * r + c];
+      const Numeric *a0 = A[4 * r], *a1 = A[4 * r + 1], *a2 = A[4 * r + 2],
+                    *a3 = A[4 * r + 3];
+      const Numeric *b0 = B[c], *b1 = B[4 + c], *b2 = B[8 + c],
+                    *b3 = B[12 + c];
+      for (Index i = 0; i < n; i++)
+        out[i] = (add ? out[i] : 0.0) + a0[i] * b0[i] + a1[i] * b1[i] +
+                 a2[i] * b2[i] + a3[i] * b3[i];
+    }
+  }
+}
+
+/** Set x = s (k1 + k2) for a frequency block */
+inline void set_average(Numeric* x,
+                        const ConstVectorView& k1,
+                        const ConstVectorView& k2,
+                        const Numeric s,
+                        const Index n) noexcept {
+  for (Index i = 0; i < n; i++) x[i] = s * (k1[i] + k2[i]);
+}
+
+/** Set dx = -0.5 (r dk + dr (k1 + k2)) for a frequency block */
+inline void set_derivative(Numeric* dx,
+                           const ConstVectorView& dk,
+                           const ConstVectorView& k1,
+                           const ConstVectorView& k2,
+                           const Numeric r,
+                           const Numeric dr,
+                           const Index n) noexcept {
+  for (Index i = 0; i < n; i++) dx[i] = -0.5 * (r * dk[i] + dr * (k1[i] + k2[i]));
+}
+
+/** Below this |s|, dsinhc_ds uses its series */
+constexpr Numeric dsinhc_ds_series_limit = 0.09;
+
+/** The derivative of sinh(x)/x with respect to s = x^2
+ * 
+ * For negative s = -y^2 this is the derivative of sin(y)/y with respect
+ * to -y^2.  The closed form cancels for small s, so a series is used there.
+ * 
+ * @param[in] s x^2, or -y^2
+ * @param[in] c cosh(x), or cos(y)
+ * @param[in] sinc sinh(x)/x, or sin(y)/y
+ */
+inline Numeric dsinhc_ds(const Numeric s,
+                         const Numeric c,
+                         const Numeric sinc) noexcept {
+  if (std::abs(s) > dsinhc_ds_series_limit) return 0.5 * (c - sinc) / s;
+
+  // sinh(x)/x = sum_k s^k / (2k+1)!, to s^7 / 15!
+  return 1.0 / 6.0 +
+         s * (2.0 / 120.0 +
+              s * (3.0 / 5040.0 +
+                   s * (4.0 / 362880.0 +
+                        s * (5.0 / 39916800.0 +
+                             s * (6.0 / 6227020800.0 +
+                                  s * (7.0 / 1307674368000.0))))));
+}
+
+/** The analytic exp(-K r) for Stokes dimension 4 over a frequency block
+ * 
+ * With K the level-averaged propagation matrix times -r, split into
+ * a I + K', the eigenvalues of K' are ±x and ±iy with real x and y.
+ * Then exp(K) = exp(a) (C0 I + C1 K' + C2 K'^2 + C3 K'^3), where the
+ * coefficients only depend on x and y.  Everything is computed in real
+ * arithmetic and element by element over the block, so that the loops
+ * can be vectorized.
+ */
+struct Transmat4Block {
+  Index n;
+  Numeric a[transmat4_nblock], b[transmat4_nblock], c[transmat4_nblock],
+      d[transmat4_nblock], u[transmat4_nblock], v[transmat4_nblock],
+      w[transmat4_nblock];
+  Numeric exp_a[transmat4_nblock];
+  Numeric Const1[transmat4_nblock], x[transmat4_nblock], y[transmat4_nblock];
+  Numeric cx[transmat4_nblock], sx[transmat4_nblock], cy[transmat4_nblock],
+      sy[transmat4_nblock];
+  Numeric sinc_x[transmat4_nblock], sinc_y[transmat4_nblock];
+  Numeric inv_x2y2[transmat4_nblock];
+  Numeric C0[transmat4_nblock], C1[transmat4_nblock], C2[transmat4_nblock],
+      C3[transmat4_nblock];
+  bool polarized[transmat4_nblock], x_zero[transmat4_nblock],
+      y_zero[transmat4_nblock];
+  Matrix4Block Kp, Kp2, Kp3, T;  // Powers of K' and the result
+
+  /** Compute everything for frequencies [i0, i0 + n) */
+  void compute(const PropagationMatrix& K1,
+               const PropagationMatrix& K2,
+               const Numeric& r,
+               const Index i0,
+               const Index nf,
+               const Index iz,
+               const Index ia) noexcept {
+    n = nf;
+
+    // Views are expensive to create, so they are only created once
+    const Range f(i0, n);
+    set_average(a, K1.Kjj(iz, ia)[f], K2.Kjj(iz, ia)[f], -0.5 * r, n);
+    set_average(b, K1.K12(iz, ia)[f], K2.K12(iz, ia)[f], -0.5 * r, n);
+    set_average(c, K1.K13(iz, ia)[f], K2.K13(iz, ia)[f], -0.5 * r, n);
+    set_average(d, K1.K14(iz, ia)[f], K2.K14(iz, ia)[f], -0.5 * r, n);
+    set_average(u, K1.K23(iz, ia)[f], K2.K23(iz, ia)[f], -0.5 * r, n);
+    set_average(v, K1.K24(iz, ia)[f], K2.K24(iz, ia)[f], -0.5 * r, n);
+    set_average(w, K1.K34(iz, ia)[f], K2.K34(iz, ia)[f], -0.5 * r, n);
+
+    for (Index i = 0; i < n; i++) {
+      exp_a[i] = std::exp(a[i]);
+      polarized[i] = b[i] != 0 or c[i] != 0 or d[i] != 0 or u[i] != 0 or
+                     v[i] != 0 or w[i] != 0;
+
+      const Numeric b2 = b[i] * b[i], c2 = c[i] * c[i], d2 = d[i] * d[i],
+                    u2 = u[i] * u[i], v2 = v[i] * v[i], w2 = w[i] * w[i];
+      const Numeric tmp =
+          w2 * w2 + 2 * (b2 * (b2 * 0.5 + c2 + d2 - u2 - v2 + w2) +
+                         c2 * (c2 * 0.5 + d2 - u2 + v2 - w2) +
+                         d2 * (d2 * 0.5 + u2 - v2 - w2) +
+                         u2 * (u2 * 0.5 + v2 + w2) + v2 * (v2 * 0.5 + w2) +
+                         4 * (b[i] * d[i] * u[i] * w[i] -
+                              b[i] * c[i] * v[i] * w[i] -
+                              c[i] * d[i] * u[i] * v[i]));
+      const Numeric Const2 = b2 + c2 + d2 - u2 - v2 - w2;
+      Const1[i] = std::sqrt(std::max(tmp, 0.0));
+      x[i] = std::sqrt(std::max(0.5 * (Const1[i] + Const2), 0.0));
+      y[i] = std::sqrt(std::max(0.5 * (Const1[i] - Const2), 0.0));
+    }
+
+    for (Index i = 0; i < n; i++) {
+      cx[i] = std::cosh(x[i]);
+      sx[i] = std::sinh(x[i]);
+      cy[i] = std::cos(y[i]);
+      sy[i] = std::sin(y[i]);
+    }
+
+    /* Using, for small x and y:
+     *    {sinh(x),sin(x)} / x → 1 ± x^2/6
+     *    ({cosh(x),cos(x)} - 1) / x^2 → 1/2 ± x^2/24
+     *    inv_x2y2 := 1 for x == y == 0,
+     *    C0, C1, C2, C3 ∝ [1/(x^2 + y^2)]
+     * Only one of x and y being small needs no limit, x^2 + y^2 stays
+     * away from zero.
+     */
+    for (Index i = 0; i < n; i++) {
+      x_zero[i] = x[i] < lower_is_considered_zero_for_sinc_likes;
+      y_zero[i] = y[i] < lower_is_considered_zero_for_sinc_likes;
+      const bool both_zero = x_zero[i] and y_zero[i];
+      const Numeric x2 = x[i] * x[i], y2 = y[i] * y[i];
+
+      sinc_x[i] = x_zero[i] ? 1.0 + x2 / 6.0 : sx[i] / x[i];
+      sinc_y[i] = y_zero[i] ? 1.0 - y2 / 6.0 : sy[i] / y[i];
+      inv_x2y2[i] = both_zero ? 1.0 : 1.0 / (x2 + y2);
+
+      C0[i] = both_zero ? 1.0 : (cy[i] * x2 + cx[i] * y2) * inv_x2y2[i];
+      C1[i] =
+          both_zero ? 1.0 : (sinc_y[i] * x2 + sinc_x[i] * y2) * inv_x2y2[i];
+      C2[i] = both_zero ? 0.5 + (x2 - y2) / 24.0
+                        : (cx[i] - cy[i]) * inv_x2y2[i];
+      C3[i] = both_zero ? 1.0 / 6.0 + (x2 - y2) / 120.0
+                        : (sinc_x[i] - sinc_y[i]) * inv_x2y2[i];
+    }
+
+    set_propmat4_block(Kp, b, c, d, u, v, w, n);
+    multiply_matrix4_block(Kp2, Kp, Kp, n);
+    multiply_matrix4_block(Kp3, Kp2, Kp, n);
+
+    for (Index e = 0; e < 16; e++) {
+      const bool diag = e % 5 == 0;
+      for (Index i = 0; i < n; i++)
+        T[e][i] = exp_a[i] * ((diag ? C0[i] : 0.0) + C1[i] * Kp[e][i] +
+                              C2[i] * Kp2[e][i] + C3[i] * Kp3[e][i]);
+    }
+  }
+
+  /** Copy the transmission matrices of the block to Tout starting at i0 */
+  void copy(TransmissionMatrix& Tout, const Index i0) const noexcept {
+    copy(Tout, T, i0);
+  }
+
+  /** Copy M of the block to Tout starting at i0 */
+  void copy(TransmissionMatrix& Tout,
+            const Matrix4Block& M,
+            const Index i0) const noexcept {
+    for (Index i = 0; i < n; i++) {
+      Eigen::Matrix4d& m = Tout.Mat4(i0 + i);
+      for (Index r = 0; r < 4; r++)
+        for (Index s = 0; s < 4; s++) m(r, s) = M[4 * r + s][i];
+    }
+  }
+
+  /** Compute the derivative of the block transmission matrices
+   * 
+   * Must be called after compute()
+   * 
+   * @param[in,out] dT Derivative transmission matrices
+   * @param[in] K1 The propagation matrix of the first level
+   * @param[in] K2 The propagation matrix of the second level
+   * @param[in] dK The derivative of the propagation matrix of this level
+   * @param[in] r The distance
+   * @param[in] dr_dT The derivative of the distance with temperature
+   * @param[in] temperature_derivative True if this is the temperature derivative
+   * @param[in] i0 First frequency of the block
+   * @param[in] iz Zenith index
+   * @param[in] ia Azimuth index
+   */
+  void derivative(TransmissionMatrix& dT,
+                  const PropagationMatrix& K1,
+                  const PropagationMatrix& K2,
+                  const PropagationMatrix& dK,
+                  const Numeric& r,
+                  const Numeric& dr_dT,
+                  const bool temperature_derivative,
+                  const Index i0,
+                  const Index iz,
+                  const Index ia) const noexcept {
+    Numeric da[transmat4_nblock], db[transmat4_nblock], dc[transmat4_nblock],
+        dd[transmat4_nblock], du[transmat4_nblock], dv[transmat4_nblock],
+        dw[transmat4_nblock];
+    Numeric dC0[transmat4_nblock], dC1[transmat4_nblock],
+        dC2[transmat4_nblock], dC3[transmat4_nblock];
+    Matrix4Block dKp, dKp2, dKp3, dTb;
+
+    // The distance derivative is only there for the temperature
+    const Numeric dr = temperature_derivative ? dr_dT : 0.0;
+    const Range f(i0, n);
+    set_derivative(da, dK.Kjj(iz, ia)[f], K1.Kjj(iz, ia)[f], K2.Kjj(iz, ia)[f], r, dr, n);
+    set_derivative(db, dK.K12(iz, ia)[f], K1.K12(iz, ia)[f], K2.K12(iz, ia)[f], r, dr, n);
+    set_derivative(dc, dK.K13(iz, ia)[f], K1.K13(iz, ia)[f], K2.K13(iz, ia)[f], r, dr, n);
+    set_derivative(dd, dK.K14(iz, ia)[f], K1.K14(iz, ia)[f], K2.K14(iz, ia)[f], r, dr, n);
+    set_derivative(du, dK.K23(iz, ia)[f], K1.K23(iz, ia)[f], K2.K23(iz, ia)[f], r, dr, n);
+    set_derivative(dv, dK.K24(iz, ia)[f], K1.K24(iz, ia)[f], K2.K24(iz, ia)[f], r, dr, n);
+    set_derivative(dw, dK.K34(iz, ia)[f], K1.K34(iz, ia)[f], K2.K34(iz, ia)[f], r, dr, n);
+
+    // As before, only the absorption changes if there is no polarization
+    for (Index i = 0; i < n; i++) {
+      if (not polarized[i]) {
+        db[i] = dc[i] = dd[i] = du[i] = dv[i] = dw[i] = 0;
+      }
+    }
+
+    for (Index i = 0; i < n; i++) {
+      const bool both_zero = x_zero[i] and y_zero[i];
+      const Numeric b2 = b[i] * b[i], c2 = c[i] * c[i], d2 = d[i] * d[i],
+                    u2 = u[i] * u[i], v2 = v[i] * v[i], w2 = w[i] * w[i];
+      const Numeric db2 = 2 * db[i] * b[i], dc2 = 2 * dc[i] * c[i],
+                    dd2 = 2 * dd[i] * d[i], du2 = 2 * du[i] * u[i],
+                    dv2 = 2 * dv[i] * v[i], dw2 = 2 * dw[i] * w[i];
+      const Numeric dtmp =
+          2 * w2 * dw2 +
+          2 * (db2 * (b2 * 0.5 + c2 + d2 - u2 - v2 + w2) +
+               b2 * (db2 * 0.5 + dc2 + dd2 - du2 - dv2 + dw2) +
+               dc2 * (c2 * 0.5 + d2 - u2 + v2 - w2) +
+               c2 * (dc2 * 0.5 + dd2 - du2 + dv2 - dw2) +
+               dd2 * (d2 * 0.5 + u2 - v2 - w2) +
+               d2 * (dd2 * 0.5 + du2 - dv2 - dw2) +
+               du2 * (u2 * 0.5 + v2 + w2) + u2 * (du2 * 0.5 + dv2 + dw2) +
+               dv2 * (v2 * 0.5 + w2) + v2 * (dv2 * 0.5 + dw2) +
+               4 * (db[i] * d[i] * u[i] * w[i] - db[i] * c[i] * v[i] * w[i] -
+                    dc[i] * d[i] * u[i] * v[i] + b[i] * dd[i] * u[i] * w[i] -
+                    b[i] * dc[i] * v[i] * w[i] - c[i] * dd[i] * u[i] * v[i] +
+                    b[i] * d[i] * du[i] * w[i] - b[i] * c[i] * dv[i] * w[i] -
+                    c[i] * d[i] * du[i] * v[i] + b[i] * d[i] * u[i] * dw[i] -
+                    b[i] * c[i] * v[i] * dw[i] - c[i] * d[i] * u[i] * dv[i]));
+      const Numeric dConst1 = Const1[i] > 0 ? 0.5 * dtmp / Const1[i] : 0.0;
+      const Numeric dConst2 = db2 + dc2 + dd2 - du2 - dv2 - dw2;
+      // The derivatives are taken with respect to x^2 and y^2, which are
+      // smooth also where x or y is zero.  Where they are clamped to zero,
+      // so are their derivatives.
+      const Numeric x2 = x[i] * x[i], y2 = y[i] * y[i];
+      const Numeric dx2 = x[i] > 0 ? 0.5 * (dConst1 + dConst2) : 0.0;
+      const Numeric dy2 = y[i] > 0 ? 0.5 * (dConst1 - dConst2) : 0.0;
+      const Numeric dx2y2 = dx2 + dy2;
+      const Numeric dcx = 0.5 * sinc_x[i] * dx2, dcy = -0.5 * sinc_y[i] * dy2;
+      const Numeric dsinc_x = dsinhc_ds(x2, cx[i], sinc_x[i]) * dx2;
+      const Numeric dsinc_y = -dsinhc_ds(-y2, cy[i], sinc_y[i]) * dy2;
+
+      dC0[i] = both_zero ? 0.0
+                         : (dcy * x2 + cy[i] * dx2 + dcx * y2 + cx[i] * dy2 -
+                            C0[i] * dx2y2) *
+                               inv_x2y2[i];
+      dC1[i] = both_zero ? 0.0
+                         : (dsinc_y * x2 + sinc_y[i] * dx2 + dsinc_x * y2 +
+                            sinc_x[i] * dy2 - C1[i] * dx2y2) *
+                               inv_x2y2[i];
+      dC2[i] = both_zero ? (dx2 - dy2) / 24.0
+                         : (dcx - dcy - C2[i] * dx2y2) * inv_x2y2[i];
+      dC3[i] = both_zero ? (dx2 - dy2) / 120.0
+                         : (dsinc_x - dsinc_y - C3[i] * dx2y2) * inv_x2y2[i];
+    }
+
+    // d(K'^2) = dK' K' + K' dK' and d(K'^3) = d(K'^2) K' + K'^2 dK'
+    set_propmat4_block(dKp, db, dc, dd, du, dv, dw, n);
+    multiply_matrix4_block(dKp2, dKp, Kp, n);
+    multiply_matrix4_block(dKp2, Kp, dKp, n, true);
+    multiply_matrix4_block(dKp3, dKp2, Kp, n);
+    multiply_matrix4_block(dKp3, Kp2, dKp, n, true);
+
+    for (Index e = 0; e < 16; e++) {
+      const bool diag = e % 5 == 0;
+      for (Index i = 0; i < n; i++)
+        dTb[e][i] = T[e][i] * da[i] +
+                    exp_a[i] * ((diag ? dC0[i] : 0.0) + dC1[i] * Kp[e][i] +
+                                C1[i] * dKp[e][i] + dC2[i] * Kp2[e][i] +
+                                C2[i] * dKp2[e][i] + dC3[i] * Kp3[e][i] +
+                                C3[i] * dKp3[e][i]);
+    }
+
+    copy(dT, dTb, i0);
+  }
+};
+
+inline void transmat4(TransmissionMatrix& T,
+                      const PropagationMatrix& K1,
+                      const PropagationMatrix& K2,
+                      const Numeric& r,
+                      const Index iz = 0,
+                      const Index ia = 0) noexcept {
+  Transmat4Block block;
+  const Index nf = K1.NumberOfFrequencies();
+  for (Index i0 = 0; i0 < nf; i0 += transmat4_nblock) {
+    block.compute(K1, K2, r, i0, std::min(transmat4_nblock, nf - i0), iz, ia);
+    block.copy(T, i0);
+  }
+}
+
 inline void dtransmat4(TransmissionMatrix& T,
                        ArrayOfTransmissionMatrix& dT1,
                        ArrayOfTransmissionMatrix& dT2,
@@ -644,543 +900,16 @@ inline void dtransmat4(TransmissionMatrix& T,
                        const Index it,
                        const Index iz,
                        const Index ia) noexcept {
-  static constexpr Numeric sqrt_05 = Constant::inv_sqrt_2;
-  for (Index i = 0; i < K1.NumberOfFrequencies(); i++) {
-    const Numeric a = -0.5 * r * (K1.Kjj(iz, ia)[i] + K2.Kjj(iz, ia)[i]),
-                  b = -0.5 * r * (K1.K12(iz, ia)[i] + K2.K12(iz, ia)[i]),
-                  c = -0.5 * r * (K1.K13(iz, ia)[i] + K2.K13(iz, ia)[i]),
-                  d = -0.5 * r * (K1.K14(iz, ia)[i] + K2.K14(iz, ia)[i]),
-                  u = -0.5 * r * (K1.K23(iz, ia)[i] + K2.K23(iz, ia)[i]),
-                  v = -0.5 * r * (K1.K24(iz, ia)[i] + K2.K24(iz, ia)[i]),
-                  w = -0.5 * r * (K1.K34(iz, ia)[i] + K2.K34(iz, ia)[i]);
-    const Numeric exp_a = std::exp(a);
-
-    if (b == 0. and c == 0. and d == 0. and u == 0. and v == 0. and w == 0.) {
-      T.Mat4(i).noalias() = Eigen::Matrix4d::Identity() * exp_a;
-      for (Index j = 0; j < dK1.nelem(); j++) {
-        if (dK1[j].NumberOfFrequencies())
-          dT1[j].Mat4(i).noalias() =
-              T.Mat4(i) *
-              (-0.5 *
-               (r * dK1[j].Kjj(iz, ia)[i] +
-                ((j == it) ? dr_dT1 * (K1.Kjj(iz, ia)[i] + K2.Kjj(iz, ia)[i])
-                           : 0.0)));
-        if (dK2[j].NumberOfFrequencies())
-          dT2[j].Mat4(i).noalias() =
-              T.Mat4(i) *
-              (-0.5 *
-               (r * dK2[j].Kjj(iz, ia)[i] +
-                ((j == it) ? dr_dT2 * (K1.Kjj(iz, ia)[i] + K2.Kjj(iz, ia)[i])
-                           : 0.0)));
-      }
-    } else {
-      const Numeric b2 = b * b, c2 = c * c, d2 = d * d, u2 = u * u, v2 = v * v,
-                    w2 = w * w;
-      const Numeric tmp =
-          w2 * w2 + 2 * (b2 * (b2 * 0.5 + c2 + d2 - u2 - v2 + w2) +
-                         c2 * (c2 * 0.5 + d2 - u2 + v2 - w2) +
-                         d2 * (d2 * 0.5 + u2 - v2 - w2) +
-                         u2 * (u2 * 0.5 + v2 + w2) + v2 * (v2 * 0.5 + w2) +
-                         4 * (b * d * u * w - b * c * v * w - c * d * u * v));
-      const Complex Const1 = std::sqrt(Complex(tmp, 0));
-      const Numeric Const2 = b2 + c2 + d2 - u2 - v2 - w2;
-      const Complex tmp_x_sqrt = std::sqrt(Const2 + Const1);
-      const Complex tmp_y_sqrt = std::sqrt(Const2 - Const1);
-      const Complex x = tmp_x_sqrt * sqrt_05;
-      const Complex y = tmp_y_sqrt * sqrt_05 * Complex(0, 1);
-      const Complex x2 = x * x;
-      const Complex y2 = y * y;
-      const Complex cy = std::cos(y);
-      const Complex sy = std::sin(y);
-      const Complex cx = std::cosh(x);
-      const Complex sx = std::sinh(x);
-
-      const bool x_zero = std::abs(x) < lower_is_considered_zero_for_sinc_likes;
-      const bool y_zero = std::abs(y) < lower_is_considered_zero_for_sinc_likes;
-      const bool both_zero = y_zero and x_zero;
-      const bool either_zero = y_zero or x_zero;
-
-      /* Using:
-       *    lim x→0 [({cosh(x),cos(x)} - 1) / x^2] → 1/2
-       *    lim x→0 [{sinh(x),sin(x)} / x]  → 1
-       *    inv_x2 := 1 for x == 0,
-       *    -i sin(ix) → sinh(x)
-       *    cos(ix) → cosh(x)
-       *    C0, C1, C2 ∝ [1/x^2]
-       */
-      const Complex ix = x_zero ? 0.0 : 1.0 / x;
-      const Complex iy = y_zero ? 0.0 : 1.0 / y;
-      const Complex inv_x2y2 =
-          both_zero
-              ? 1.0
-              : 1.0 /
-                    (x2 + y2);  // The first "1.0" is the trick for above limits
-      const Complex C0c = either_zero ? 1.0 : (cy * x2 + cx * y2) * inv_x2y2;
-      const Complex C1c =
-          either_zero ? 1.0 : (sy * x2 * iy + sx * y2 * ix) * inv_x2y2;
-      const Complex C2c = both_zero ? 0.5 : (cx - cy) * inv_x2y2;
-      const Complex C3c =
-          both_zero ? 1.0 / 6.0
-                    : (x_zero ? 1.0 - sy * iy
-                              : y_zero ? sx * ix - 1.0 : sx * ix - sy * iy) *
-                          inv_x2y2;
-
-      const Numeric& C0 = reinterpret_cast<const Numeric(&)[2]>(C0c)[0];
-      const Numeric& C1 = reinterpret_cast<const Numeric(&)[2]>(C1c)[0];
-      const Numeric& C2 = reinterpret_cast<const Numeric(&)[2]>(C2c)[0];
-      const Numeric& C3 = reinterpret_cast<const Numeric(&)[2]>(C3c)[0];
-      T.Mat4(i).noalias() =
-          exp_a * (Eigen::Matrix4d() << C0 + C2 * (b2 + c2 + d2),
-                   C1 * b + C2 * (-c * u - d * v) +
-                       C3 * (b * (b2 + c2 + d2) - u * (b * u - d * w) -
-                             v * (b * v + c * w)),
-                   C1 * c + C2 * (b * u - d * w) +
-                       C3 * (c * (b2 + c2 + d2) - u * (c * u + d * v) -
-                             w * (b * v + c * w)),
-                   C1 * d + C2 * (b * v + c * w) +
-                       C3 * (d * (b2 + c2 + d2) - v * (c * u + d * v) +
-                             w * (b * u - d * w)),
-
-                   C1 * b + C2 * (c * u + d * v) +
-                       C3 * (-b * (-b2 + u2 + v2) + c * (b * c - v * w) +
-                             d * (b * d + u * w)),
-                   C0 + C2 * (b2 - u2 - v2),
-                   C2 * (b * c - v * w) + C1 * u +
-                       C3 * (c * (c * u + d * v) - u * (-b2 + u2 + v2) -
-                             w * (b * d + u * w)),
-                   C2 * (b * d + u * w) + C1 * v +
-                       C3 * (d * (c * u + d * v) - v * (-b2 + u2 + v2) +
-                             w * (b * c - v * w)),
-
-                   C1 * c + C2 * (-b * u + d * w) +
-                       C3 * (b * (b * c - v * w) - c * (-c2 + u2 + w2) +
-                             d * (c * d - u * v)),
-                   C2 * (b * c - v * w) - C1 * u +
-                       C3 * (-b * (b * u - d * w) + u * (-c2 + u2 + w2) -
-                             v * (c * d - u * v)),
-                   C0 + C2 * (c2 - u2 - w2),
-                   C2 * (c * d - u * v) + C1 * w +
-                       C3 * (-d * (b * u - d * w) + v * (b * c - v * w) -
-                             w * (-c2 + u2 + w2)),
-
-                   C1 * d + C2 * (-b * v - c * w) +
-                       C3 * (b * (b * d + u * w) + c * (c * d - u * v) -
-                             d * (-d2 + v2 + w2)),
-                   C2 * (b * d + u * w) - C1 * v +
-                       C3 * (-b * (b * v + c * w) - u * (c * d - u * v) +
-                             v * (-d2 + v2 + w2)),
-                   C2 * (c * d - u * v) - C1 * w +
-                       C3 * (-c * (b * v + c * w) + u * (b * d + u * w) +
-                             w * (-d2 + v2 + w2)),
-                   C0 + C2 * (d2 - v2 - w2))
-                      .finished();
-
-      for (Index j = 0; j < dK1.nelem(); j++) {
-        if (dK1[j].NumberOfFrequencies()) {
-          const Numeric da = -0.5 * (r * dK1[j].Kjj(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.Kjj(iz, ia)[i] +
-                                                            K2.Kjj(iz, ia)[i])
-                                                : 0.0)),
-                        db = -0.5 * (r * dK1[j].K12(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.K12(iz, ia)[i] +
-                                                            K2.K12(iz, ia)[i])
-                                                : 0.0)),
-                        dc = -0.5 * (r * dK1[j].K13(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.K13(iz, ia)[i] +
-                                                            K2.K13(iz, ia)[i])
-                                                : 0.0)),
-                        dd = -0.5 * (r * dK1[j].K14(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.K14(iz, ia)[i] +
-                                                            K2.K14(iz, ia)[i])
-                                                : 0.0)),
-                        du = -0.5 * (r * dK1[j].K23(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.K23(iz, ia)[i] +
-                                                            K2.K23(iz, ia)[i])
-                                                : 0.0)),
-                        dv = -0.5 * (r * dK1[j].K24(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.K24(iz, ia)[i] +
-                                                            K2.K24(iz, ia)[i])
-                                                : 0.0)),
-                        dw = -0.5 * (r * dK1[j].K34(iz, ia)[i] +
-                                     ((j == it) ? dr_dT1 * (K1.K34(iz, ia)[i] +
-                                                            K2.K34(iz, ia)[i])
-                                                : 0.0));
-          const Numeric db2 = 2 * db * b, dc2 = 2 * dc * c, dd2 = 2 * dd * d,
-                        du2 = 2 * du * u, dv2 = 2 * dv * v, dw2 = 2 * dw * w;
-          const Numeric dtmp =
-              2 * w2 * dw2 +
-              2 * (db2 * (b2 * 0.5 + c2 + d2 - u2 - v2 + w2) +
-                   b2 * (db2 * 0.5 + dc2 + dd2 - du2 - dv2 + dw2) +
-                   dc2 * (c2 * 0.5 + d2 - u2 + v2 - w2) +
-                   c2 * (dc2 * 0.5 + dd2 - du2 + dv2 - dw2) +
-                   dd2 * (d2 * 0.5 + u2 - v2 - w2) +
-                   d2 * (dd2 * 0.5 + du2 - dv2 - dw2) +
-                   du2 * (u2 * 0.5 + v2 + w2) + u2 * (du2 * 0.5 + dv2 + dw2) +
-                   dv2 * (v2 * 0.5 + w2) + v2 * (dv2 * 0.5 + dw2) +
-                   4 * (db * d * u * w - db * c * v * w - dc * d * u * v +
-                        b * dd * u * w - b * dc * v * w - c * dd * u * v +
-                        b * d * du * w - b * c * dv * w - c * d * du * v +
-                        b * d * u * dw - b * c * v * dw - c * d * u * dv));
-          const Complex dConst1 = 0.5 * dtmp / Const1;
-          const Numeric dConst2 = db2 + dc2 + dd2 - du2 - dv2 - dw2;
-          const Complex dx =
-              x_zero ? 0 : (0.5 * (dConst2 + dConst1) / tmp_x_sqrt) * sqrt_05;
-          const Complex dy = y_zero ? 0
-                                    : (0.5 * (dConst2 - dConst1) / tmp_y_sqrt) *
-                                          sqrt_05 * Complex(0, 1);
-          const Complex dx2 = 2 * x * dx;
-          const Complex dy2 = 2 * y * dy;
-          const Complex dcy = -sy * dy;
-          const Complex dsy = cy * dy;
-          const Complex dcx = sx * dx;
-          const Complex dsx = cx * dx;
-          const Complex dix = -dx * ix * ix;
-          const Complex diy = -dy * iy * iy;
-          const Complex dx2dy2 = dx2 + dy2;
-          const Complex dC0c =
-              either_zero
-                  ? 0.0
-                  : (dcy * x2 + cy * dx2 + dcx * y2 + cx * dy2 - C0c * dx2dy2) *
-                        inv_x2y2;
-          const Complex dC1c =
-              either_zero ? 0.0
-                          : (dsy * x2 * iy + sy * dx2 * iy + sy * x2 * diy +
-                             dsx * y2 * ix + sx * dy2 * ix + sx * y2 * dix -
-                             C1c * dx2dy2) *
-                                inv_x2y2;
-          const Complex dC2c =
-              both_zero ? 0.0 : (dcx - dcy - C2c * dx2dy2) * inv_x2y2;
-          const Complex dC3c =
-              both_zero ? 0.0
-                        : ((x_zero ? -dsy * iy - sy * diy
-                                   : y_zero ? dsx * ix + sx * dix
-                                            : dsx * ix + sx * dix - dsy * iy -
-                                                  sy * diy) -
-                           C3c * dx2dy2) *
-                              inv_x2y2;
-
-          const Numeric& dC0 = reinterpret_cast<const Numeric(&)[2]>(dC0c)[0];
-          const Numeric& dC1 = reinterpret_cast<const Numeric(&)[2]>(dC1c)[0];
-          const Numeric& dC2 = reinterpret_cast<const Numeric(&)[2]>(dC2c)[0];
-          const Numeric& dC3 = reinterpret_cast<const Numeric(&)[2]>(dC3c)[0];
-          dT1[j].Mat4(i).noalias() =
-              T.Mat4(i) * da +
-              exp_a *
-                  (Eigen::Matrix4d()
-                       << dC0 + dC2 * (b2 + c2 + d2) + C2 * (db2 + dc2 + dd2),
-                   db * C1 + b * dC1 + dC2 * (-c * u - d * v) +
-                       C2 * (-dc * u - dd * v - c * du - d * dv) +
-                       dC3 * (b * (b2 + c2 + d2) - u * (b * u - d * w) -
-                              v * (b * v + c * w)) +
-                       C3 * (db * (b2 + c2 + d2) - du * (b * u - d * w) -
-                             dv * (b * v + c * w) + b * (db2 + dc2 + dd2) -
-                             u * (db * u - dd * w) - v * (db * v + dc * w) -
-                             u * (b * du - d * dw) - v * (b * dv + c * dw)),
-                   dC1 * c + C1 * dc + dC2 * (b * u - d * w) +
-                       C2 * (db * u - dd * w + b * du - d * dw) +
-                       dC3 * (c * (b2 + c2 + d2) - u * (c * u + d * v) -
-                              w * (b * v + c * w)) +
-                       C3 * (dc * (b2 + c2 + d2) - du * (c * u + d * v) -
-                             dw * (b * v + c * w) + c * (db2 + dc2 + dd2) -
-                             u * (dc * u + dd * v) - w * (db * v + dc * w) -
-                             u * (c * du + d * dv) - w * (b * dv + c * dw)),
-                   dC1 * d + C1 * dd + dC2 * (b * v + c * w) +
-                       C2 * (db * v + dc * w + b * dv + c * dw) +
-                       dC3 * (d * (b2 + c2 + d2) - v * (c * u + d * v) +
-                              w * (b * u - d * w)) +
-                       C3 * (dd * (b2 + c2 + d2) - dv * (c * u + d * v) +
-                             dw * (b * u - d * w) + d * (db2 + dc2 + dd2) -
-                             v * (dc * u + dd * v) + w * (db * u - dd * w) -
-                             v * (c * du + d * dv) + w * (b * du - d * dw)),
-
-                   db * C1 + b * dC1 + dC2 * (c * u + d * v) +
-                       C2 * (dc * u + dd * v + c * du + d * dv) +
-                       dC3 * (-b * (-b2 + u2 + v2) + c * (b * c - v * w) +
-                              d * (b * d + u * w)) +
-                       C3 * (-db * (-b2 + u2 + v2) + dc * (b * c - v * w) +
-                             dd * (b * d + u * w) - b * (-db2 + du2 + dv2) +
-                             c * (db * c - dv * w) + d * (db * d + du * w) +
-                             c * (b * dc - v * dw) + d * (b * dd + u * dw)),
-                   dC0 + dC2 * (b2 - u2 - v2) + C2 * (db2 - du2 - dv2),
-                   dC2 * (b * c - v * w) +
-                       C2 * (db * c + b * dc - dv * w - v * dw) + dC1 * u +
-                       C1 * du +
-                       dC3 * (c * (c * u + d * v) - u * (-b2 + u2 + v2) -
-                              w * (b * d + u * w)) +
-                       C3 * (dc * (c * u + d * v) - du * (-b2 + u2 + v2) -
-                             dw * (b * d + u * w) + c * (dc * u + dd * v) -
-                             u * (-db2 + du2 + dv2) - w * (db * d + du * w) +
-                             c * (c * du + d * dv) - w * (b * dd + u * dw)),
-                   dC2 * (b * d + u * w) +
-                       C2 * (db * d + b * dd + du * w + u * dw) + dC1 * v +
-                       C1 * dv +
-                       dC3 * (d * (c * u + d * v) - v * (-b2 + u2 + v2) +
-                              w * (b * c - v * w)) +
-                       C3 * (dd * (c * u + d * v) - dv * (-b2 + u2 + v2) +
-                             dw * (b * c - v * w) + d * (dc * u + dd * v) -
-                             v * (-db2 + du2 + dv2) + w * (db * c - dv * w) +
-                             d * (c * du + d * dv) + w * (b * dc - v * dw)),
-
-                   dC1 * c + C1 * dc + dC2 * (-b * u + d * w) +
-                       C2 * (-db * u + dd * w - b * du + d * dw) +
-                       dC3 * (b * (b * c - v * w) - c * (-c2 + u2 + w2) +
-                              d * (c * d - u * v)) +
-                       C3 * (db * (b * c - v * w) - dc * (-c2 + u2 + w2) +
-                             dd * (c * d - u * v) + b * (db * c - dv * w) -
-                             c * (-dc2 + du2 + dw2) + d * (dc * d - du * v) +
-                             b * (b * dc - v * dw) + d * (c * dd - u * dv)),
-                   dC2 * (b * c - v * w) +
-                       C2 * (db * c + b * dc - dv * w - v * dw) - dC1 * u -
-                       C1 * du +
-                       dC3 * (-b * (b * u - d * w) + u * (-c2 + u2 + w2) -
-                              v * (c * d - u * v)) +
-                       C3 * (-db * (b * u - d * w) + du * (-c2 + u2 + w2) -
-                             dv * (c * d - u * v) - b * (db * u - dd * w) +
-                             u * (-dc2 + du2 + dw2) - v * (dc * d - du * v) -
-                             b * (b * du - d * dw) - v * (c * dd - u * dv)),
-                   dC0 + dC2 * (c2 - u2 - w2) + C2 * (dc2 - du2 - dw2),
-                   dC2 * (c * d - u * v) +
-                       C2 * (dc * d + c * dd - du * v - u * dv) + dC1 * w +
-                       C1 * dw +
-                       dC3 * (-d * (b * u - d * w) + v * (b * c - v * w) -
-                              w * (-c2 + u2 + w2)) +
-                       C3 * (-dd * (b * u - d * w) + dv * (b * c - v * w) -
-                             dw * (-c2 + u2 + w2) - d * (db * u - dd * w) +
-                             v * (db * c - dv * w) - w * (-dc2 + du2 + dw2) -
-                             d * (b * du - d * dw) + v * (b * dc - v * dw)),
-
-                   dC1 * d + C1 * dd + dC2 * (-b * v - c * w) +
-                       C2 * (-db * v - dc * w - b * dv - c * dw) +
-                       dC3 * (b * (b * d + u * w) + c * (c * d - u * v) -
-                              d * (-d2 + v2 + w2)) +
-                       C3 * (db * (b * d + u * w) + dc * (c * d - u * v) -
-                             dd * (-d2 + v2 + w2) + b * (db * d + du * w) +
-                             c * (dc * d - du * v) - d * (-dd2 + dv2 + dw2) +
-                             b * (b * dd + u * dw) + c * (c * dd - u * dv)),
-                   dC2 * (b * d + u * w) +
-                       C2 * (db * d + b * dd + du * w + u * dw) - dC1 * v -
-                       C1 * dv +
-                       dC3 * (-b * (b * v + c * w) - u * (c * d - u * v) +
-                              v * (-d2 + v2 + w2)) +
-                       C3 * (-db * (b * v + c * w) - du * (c * d - u * v) +
-                             dv * (-d2 + v2 + w2) - b * (db * v + dc * w) -
-                             u * (dc * d - du * v) + v * (-dd2 + dv2 + dw2) -
-                             b * (b * dv + c * dw) - u * (c * dd - u * dv)),
-                   dC2 * (c * d - u * v) +
-                       C2 * (dc * d + c * dd - du * v - u * dv) - dC1 * w -
-                       C1 * dw +
-                       dC3 * (-c * (b * v + c * w) + u * (b * d + u * w) +
-                              w * (-d2 + v2 + w2)) +
-                       C3 * (-dc * (b * v + c * w) + du * (b * d + u * w) +
-                             dw * (-d2 + v2 + w2) - c * (db * v + dc * w) +
-                             u * (db * d + du * w) + w * (-dd2 + dv2 + dw2) -
-                             c * (b * dv + c * dw) + u * (b * dd + u * dw)),
-                   dC0 + dC2 * (d2 - v2 - w2) + C2 * (dd2 - dv2 - dw2))
-                      .finished();
-        }
-        if (dK2[j].NumberOfFrequencies()) {
-          const Numeric da = -0.5 * (r * dK2[j].Kjj(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.Kjj(iz, ia)[i] +
-                                                            K2.Kjj(iz, ia)[i])
-                                                : 0.0)),
-                        db = -0.5 * (r * dK2[j].K12(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.K12(iz, ia)[i] +
-                                                            K2.K12(iz, ia)[i])
-                                                : 0.0)),
-                        dc = -0.5 * (r * dK2[j].K13(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.K13(iz, ia)[i] +
-                                                            K2.K13(iz, ia)[i])
-                                                : 0.0)),
-                        dd = -0.5 * (r * dK2[j].K14(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.K14(iz, ia)[i] +
-                                                            K2.K14(iz, ia)[i])
-                                                : 0.0)),
-                        du = -0.5 * (r * dK2[j].K23(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.K23(iz, ia)[i] +
-                                                            K2.K23(iz, ia)[i])
-                                                : 0.0)),
-                        dv = -0.5 * (r * dK2[j].K24(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.K24(iz, ia)[i] +
-                                                            K2.K24(iz, ia)[i])
-                                                : 0.0)),
-                        dw = -0.5 * (r * dK2[j].K34(iz, ia)[i] +
-                                     ((j == it) ? dr_dT2 * (K1.K34(iz, ia)[i] +
-                                                            K2.K34(iz, ia)[i])
-                                                : 0.0));
-          const Numeric db2 = 2 * db * b, dc2 = 2 * dc * c, dd2 = 2 * dd * d,
-                        du2 = 2 * du * u, dv2 = 2 * dv * v, dw2 = 2 * dw * w;
-          const Numeric dtmp =
-              2 * w2 * dw2 +
-              2 * (db2 * (b2 * 0.5 + c2 + d2 - u2 - v2 + w2) +
-                   b2 * (db2 * 0.5 + dc2 + dd2 - du2 - dv2 + dw2) +
-                   dc2 * (c2 * 0.5 + d2 - u2 + v2 - w2) +
-                   c2 * (dc2 * 0.5 + dd2 - du2 + dv2 - dw2) +
-                   dd2 * (d2 * 0.5 + u2 - v2 - w2) +
-                   d2 * (dd2 * 0.5 + du2 - dv2 - dw2) +
-                   du2 * (u2 * 0.5 + v2 + w2) + u2 * (du2 * 0.5 + dv2 + dw2) +
-                   dv2 * (v2 * 0.5 + w2) + v2 * (dv2 * 0.5 + dw2) +
-                   4 * (db * d * u * w - db * c * v * w - dc * d * u * v +
-                        b * dd * u * w - b * dc * v * w - c * dd * u * v +
-                        b * d * du * w - b * c * dv * w - c * d * du * v +
-                        b * d * u * dw - b * c * v * dw - c * d * u * dv));
-          const Complex dConst1 = 0.5 * dtmp / Const1;
-          const Numeric dConst2 = db2 + dc2 + dd2 - du2 - dv2 - dw2;
-          const Complex dx =
-              x_zero ? 0 : (0.5 * (dConst2 + dConst1) / tmp_x_sqrt) * sqrt_05;
-          const Complex dy = y_zero ? 0
-                                    : (0.5 * (dConst2 - dConst1) / tmp_y_sqrt) *
-                                          sqrt_05 * Complex(0, 1);
-          const Complex dx2 = 2 * x * dx;
-          const Complex dy2 = 2 * y * dy;
-          const Complex dcy = -sy * dy;
-          const Complex dsy = cy * dy;
-          const Complex dcx = sx * dx;
-          const Complex dsx = cx * dx;
-          const Complex dix = -dx * ix * ix;
-          const Complex diy = -dy * iy * iy;
-          const Complex dx2dy2 = dx2 + dy2;
-          const Complex dC0c =
-              either_zero
-                  ? 0.0
-                  : (dcy * x2 + cy * dx2 + dcx * y2 + cx * dy2 - C0c * dx2dy2) *
-                        inv_x2y2;
-          const Complex dC1c =
-              either_zero ? 0.0
-                          : (dsy * x2 * iy + sy * dx2 * iy + sy * x2 * diy +
-                             dsx * y2 * ix + sx * dy2 * ix + sx * y2 * dix -
-                             C1c * dx2dy2) *
-                                inv_x2y2;
-          const Complex dC2c =
-              both_zero ? 0.0 : (dcx - dcy - C2c * dx2dy2) * inv_x2y2;
-          const Complex dC3c =
-              both_zero ? 0.0
-                        : ((x_zero ? -dsy * iy - sy * diy
-                                   : y_zero ? dsx * ix + sx * dix
-                                            : dsx * ix + sx * dix - dsy * iy -
-                                                  sy * diy) -
-                           C3c * dx2dy2) *
-                              inv_x2y2;
-
-          const Numeric& dC0 = reinterpret_cast<const Numeric(&)[2]>(dC0c)[0];
-          const Numeric& dC1 = reinterpret_cast<const Numeric(&)[2]>(dC1c)[0];
-          const Numeric& dC2 = reinterpret_cast<const Numeric(&)[2]>(dC2c)[0];
-          const Numeric& dC3 = reinterpret_cast<const Numeric(&)[2]>(dC3c)[0];
-          dT2[j].Mat4(i).noalias() =
-              T.Mat4(i) * da +
-              exp_a *
-                  (Eigen::Matrix4d()
-                       << dC0 + dC2 * (b2 + c2 + d2) + C2 * (db2 + dc2 + dd2),
-                   db * C1 + b * dC1 + dC2 * (-c * u - d * v) +
-                       C2 * (-dc * u - dd * v - c * du - d * dv) +
-                       dC3 * (b * (b2 + c2 + d2) - u * (b * u - d * w) -
-                              v * (b * v + c * w)) +
-                       C3 * (db * (b2 + c2 + d2) - du * (b * u - d * w) -
-                             dv * (b * v + c * w) + b * (db2 + dc2 + dd2) -
-                             u * (db * u - dd * w) - v * (db * v + dc * w) -
-                             u * (b * du - d * dw) - v * (b * dv + c * dw)),
-                   dC1 * c + C1 * dc + dC2 * (b * u - d * w) +
-                       C2 * (db * u - dd * w + b * du - d * dw) +
-                       dC3 * (c * (b2 + c2 + d2) - u * (c * u + d * v) -
-                              w * (b * v + c * w)) +
-                       C3 * (dc * (b2 + c2 + d2) - du * (c * u + d * v) -
-                             dw * (b * v + c * w) + c * (db2 + dc2 + dd2) -
-                             u * (dc * u + dd * v) - w * (db * v + dc * w) -
-                             u * (c * du + d * dv) - w * (b * dv + c * dw)),
-                   dC1 * d + C1 * dd + dC2 * (b * v + c * w) +
-                       C2 * (db * v + dc * w + b * dv + c * dw) +
-                       dC3 * (d * (b2 + c2 + d2) - v * (c * u + d * v) +
-                              w * (b * u - d * w)) +
-                       C3 * (dd * (b2 + c2 + d2) - dv * (c * u + d * v) +
-                             dw * (b * u - d * w) + d * (db2 + dc2 + dd2) -
-                             v * (dc * u + dd * v) + w * (db * u - dd * w) -
-                             v * (c * du + d * dv) + w * (b * du - d * dw)),
-
-                   db * C1 + b * dC1 + dC2 * (c * u + d * v) +
-                       C2 * (dc * u + dd * v + c * du + d * dv) +
-                       dC3 * (-b * (-b2 + u2 + v2) + c * (b * c - v * w) +
-                              d * (b * d + u * w)) +
-                       C3 * (-db * (-b2 + u2 + v2) + dc * (b * c - v * w) +
-                             dd * (b * d + u * w) - b * (-db2 + du2 + dv2) +
-                             c * (db * c - dv * w) + d * (db * d + du * w) +
-                             c * (b * dc - v * dw) + d * (b * dd + u * dw)),
-                   dC0 + dC2 * (b2 - u2 - v2) + C2 * (db2 - du2 - dv2),
-                   dC2 * (b * c - v * w) +
-                       C2 * (db * c + b * dc - dv * w - v * dw) + dC1 * u +
-                       C1 * du +
-                       dC3 * (c * (c * u + d * v) - u * (-b2 + u2 + v2) -
-                              w * (b * d + u * w)) +
-                       C3 * (dc * (c * u + d * v) - du * (-b2 + u2 + v2) -
-                             dw * (b * d + u * w) + c * (dc * u + dd * v) -
-                             u * (-db2 + du2 + dv2) - w * (db * d + du * w) +
-                             c * (c * du + d * dv) - w * (b * dd + u * dw)),
-                   dC2 * (b * d + u * w) +
-                       C2 * (db * d + b * dd + du * w + u * dw) + dC1 * v +
-                       C1 * dv +
-                       dC3 * (d * (c * u + d * v) - v * (-b2 + u2 + v2) +
-                              w * (b * c - v * w)) +
-                       C3 * (dd * (c * u + d * v) - dv * (-b2 + u2 + v2) +
-                             dw * (b * c - v * w) + d * (dc * u + dd * v) -
-                             v * (-db2 + du2 + dv2) + w * (db * c - dv * w) +
-                             d * (c * du + d * dv) + w * (b * dc - v * dw)),
-
-                   dC1 * c + C1 * dc + dC2 * (-b * u + d * w) +
-                       C2 * (-db * u + dd * w - b * du + d * dw) +
-                       dC3 * (b * (b * c - v * w) - c * (-c2 + u2 + w2) +
-                              d * (c * d - u * v)) +
-                       C3 * (db * (b * c - v * w) - dc * (-c2 + u2 + w2) +
-                             dd * (c * d - u * v) + b * (db * c - dv * w) -
-                             c * (-dc2 + du2 + dw2) + d * (dc * d - du * v) +
-                             b * (b * dc - v * dw) + d * (c * dd - u * dv)),
-                   dC2 * (b * c - v * w) +
-                       C2 * (db * c + b * dc - dv * w - v * dw) - dC1 * u -
-                       C1 * du +
-                       dC3 * (-b * (b * u - d * w) + u * (-c2 + u2 + w2) -
-                              v * (c * d - u * v)) +
-                       C3 * (-db * (b * u - d * w) + du * (-c2 + u2 + w2) -
-                             dv * (c * d - u * v) - b * (db * u - dd * w) +
-                             u * (-dc2 + du2 + dw2) - v * (dc * d - du * v) -
-                             b * (b * du - d * dw) - v * (c * dd - u * dv)),
-                   dC0 + dC2 * (c2 - u2 - w2) + C2 * (dc2 - du2 - dw2),
-                   dC2 * (c * d - u * v) +
-                       C2 * (dc * d + c * dd - du * v - u * dv) + dC1 * w +
-                       C1 * dw +
-                       dC3 * (-d * (b * u - d * w) + v * (b * c - v * w) -
-                              w * (-c2 + u2 + w2)) +
-                       C3 * (-dd * (b * u - d * w) + dv * (b * c - v * w) -
-                             dw * (-c2 + u2 + w2) - d * (db * u - dd * w) +
-                             v * (db * c - dv * w) - w * (-dc2 + du2 + dw2) -
-                             d * (b * du - d * dw) + v * (b * dc - v * dw)),
-
-                   dC1 * d + C1 * dd + dC2 * (-b * v - c * w) +
-                       C2 * (-db * v - dc * w - b * dv - c * dw) +
-                       dC3 * (b * (b * d + u * w) + c * (c * d - u * v) -
-                              d * (-d2 + v2 + w2)) +
-                       C3 * (db * (b * d + u * w) + dc * (c * d - u * v) -
-                             dd * (-d2 + v2 + w2) + b * (db * d + du * w) +
-                             c * (dc * d - du * v) - d * (-dd2 + dv2 + dw2) +
-                             b * (b * dd + u * dw) + c * (c * dd - u * dv)),
-                   dC2 * (b * d + u * w) +
-                       C2 * (db * d + b * dd + du * w + u * dw) - dC1 * v -
-                       C1 * dv +
-                       dC3 * (-b * (b * v + c * w) - u * (c * d - u * v) +
-                              v * (-d2 + v2 + w2)) +
-                       C3 * (-db * (b * v + c * w) - du * (c * d - u * v) +
-                             dv * (-d2 + v2 + w2) - b * (db * v + dc * w) -
-                             u * (dc * d - du * v) + v * (-dd2 + dv2 + dw2) -
-                             b * (b * dv + c * dw) - u * (c * dd - u * dv)),
-                   dC2 * (c * d - u * v) +
-                       C2 * (dc * d + c * dd - du * v - u * dv) - dC1 * w -
-                       C1 * dw +
-                       dC3 * (-c * (b * v + c * w) + u * (b * d + u * w) +
-                              w * (-d2 + v2 + w2)) +
-                       C3 * (-dc * (b * v + c * w) + du * (b * d + u * w) +
-                             dw * (-d2 + v2 + w2) - c * (db * v + dc * w) +
-                             u * (db * d + du * w) + w * (-dd2 + dv2 + dw2) -
-                             c * (b * dv + c * dw) + u * (b * dd + u * dw)),
-                   dC0 + dC2 * (d2 - v2 - w2) + C2 * (dd2 - dv2 - dw2))
-                      .finished();
-        }
-      }
+  Transmat4Block block;
+  const Index nf = K1.NumberOfFrequencies();
+  for (Index i0 = 0; i0 < nf; i0 += transmat4_nblock) {
+    block.compute(K1, K2, r, i0, std::min(transmat4_nblock, nf - i0), iz, ia);
+    block.copy(T, i0);
+    for (Index j = 0; j < dK1.nelem(); j++) {
+      if (dK1[j].NumberOfFrequencies())
+        block.derivative(dT1[j], K1, K2, dK1[j], r, dr_dT1, j == it, i0, iz, ia);
+      if (dK2[j].NumberOfFrequencies())
+        block.derivative(dT2[j], K1, K2, dK2[j], r, dr_dT2, j == it, i0, iz, ia);
     }
   }
 }
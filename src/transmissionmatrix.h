@@ -220,6 +220,30 @@ class TransmissionMatrix {
     std::fill(T1.begin(), T1.end(), Eigen::Matrix<double, 1, 1>::Zero());
   }
 
+  /** Set the frequencies of a block to those of a smaller matrix
+   * 
+   * @param[in] f0 Position of the first frequency of the block in this
+   * @param[in] block Matrix with the frequencies of the block
+   */
+  void setFrequencyBlock(size_t f0, const TransmissionMatrix& block) {
+    ARTS_ASSERT(stokes_dim == block.stokes_dim and
+                f0 + block.Frequencies() <= size_t(Frequencies()));
+    switch (stokes_dim) {
+      case 4:
+        std::copy(block.T4.begin(), block.T4.end(), T4.begin() + f0);
+        break;
+      case 3:
+        std::copy(block.T3.begin(), block.T3.end(), T3.begin() + f0);
+        break;
+      case 2:
+        std::copy(block.T2.begin(), block.T2.end(), T2.begin() + f0);
+        break;
+      case 1:
+        std::copy(block.T1.begin(), block.T1.end(), T1.begin() + f0);
+        break;
+    }
+  }
+
   /** Set this to a multiple of A by B
    * 
    * *this is not aliased with A or B
@@ -543,6 +567,30 @@ class RadiationVector {
     for (size_t i = 0; i < R1.size(); i++) R1[i] = T.Mat1(i) * R1[i];
   }
 
+  /** Set the frequencies of a block to those of a smaller vector
+   * 
+   * @param[in] f0 Position of the first frequency of the block in this
+   * @param[in] block Vector with the frequencies of the block
+   */
+  void setFrequencyBlock(size_t f0, const RadiationVector& block) {
+    ARTS_ASSERT(stokes_dim == block.stokes_dim and
+                f0 + block.Frequencies() <= size_t(Frequencies()));
+    switch (stokes_dim) {
+      case 4:
+        std::copy(block.R4.begin(), block.R4.end(), R4.begin() + f0);
+        break;
+      case 3:
+        std::copy(block.R3.begin(), block.R3.end(), R3.begin() + f0);
+        break;
+      case 2:
+        std::copy(block.R2.begin(), block.R2.end(), R2.begin() + f0);
+        break;
+      case 1:
+        std::copy(block.R1.begin(), block.R1.end(), R1.begin() + f0);
+        break;
+    }
+  }
+
   /** Set Radiation Vector to Zero at position
    * 
    * @param[in] i position
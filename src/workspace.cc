@@ -909,6 +909,11 @@ void Workspace::define_wsv_data() {
                   "calculations. \n"),
       GROUP("ArrayOfTensor4")));
 
+  wsv_data.push_back(WsvRecord(
+      NAME("benchmark_agenda"),
+      DESCRIPTION("Agenda defining the workload timed by *Benchmark*.\n"),
+      GROUP("Agenda")));
+
   wsv_data.push_back(WsvRecord(
       NAME("channel2fgrid_indexes"),
       DESCRIPTION(
@@ -24,6 +24,9 @@
 
 #include "workspace_ng.h"
 
+#include <memory>
+#include <vector>
+
 #include "workspace_memory_handler.h"
 #include "wsv_aux.h"
 
@@ -67,46 +70,85 @@ void Workspace::del(Index i) {
   WsvStruct *wsvs = ws[i].top();
 
   if (wsvs && wsvs->wsv) {
-    workspace_memory_handler.deallocate(wsv_data[i].Group(), wsvs->wsv);
+    if (!wsvs->borrowed)
+      workspace_memory_handler.deallocate(wsv_data[i].Group(), wsvs->wsv);
     wsvs->wsv = NULL;
     wsvs->auto_allocated = false;
     wsvs->initialized = false;
+    wsvs->borrowed = false;
+    wsvs->deferred.reset();
   }
 }
 
 void Workspace::duplicate(Index i) {
   WsvStruct *wsvs = new WsvStruct;
 
-  wsvs->auto_allocated = true;
+  // The copy is deferred until the variable is written to, see operator[]
   if (ws[i].size() && ws[i].top()->wsv) {
-    wsvs->wsv = workspace_memory_handler.duplicate(wsv_data[i].Group(),
-                                                   ws[i].top()->wsv);
+    wsvs->wsv = ws[i].top()->wsv;
+    wsvs->auto_allocated = false;
+    wsvs->borrowed = true;
     wsvs->initialized = true;
+    wsvs->deferred = ws[i].top()->deferred;
   } else {
     wsvs->wsv = NULL;
+    wsvs->auto_allocated = true;
+    wsvs->borrowed = false;
     wsvs->initialized = false;
   }
   ws[i].push(wsvs);
 }
 
-Workspace::Workspace(const Workspace &workspace) : ws(workspace.ws.nelem()) {
+Workspace::Workspace(const Workspace &workspace) : ws(0) { rebind(workspace); }
+
+void Workspace::rebind(const Workspace &workspace) {
 #ifndef NDEBUG
   context = workspace.context;
 #endif
+  for (Index i = workspace.ws.nelem(); i < ws.nelem(); i++) {
+    release(i);
+    delete ws[i].top();
+    ws[i].pop();
+  }
+  ws.resize(workspace.ws.nelem());
+
   for (Index i = 0; i < workspace.ws.nelem(); i++) {
-    WsvStruct *wsvs = new WsvStruct;
-    wsvs->auto_allocated = false;
+    release(i);
+    WsvStruct *wsvs = ws[i].top();
     if (workspace.ws[i].size() && workspace.ws[i].top()->wsv) {
       wsvs->wsv = workspace.ws[i].top()->wsv;
       wsvs->initialized = workspace.ws[i].top()->initialized;
-    } else {
-      wsvs->wsv = NULL;
-      wsvs->initialized = false;
+      wsvs->borrowed = workspace.ws[i].top()->borrowed;
+      wsvs->deferred = workspace.ws[i].top()->deferred;
     }
-    ws[i].push(wsvs);
   }
 }
 
+void Workspace::release() {
+  for (Index i = 0; i < ws.nelem(); i++) release(i);
+}
+
+void Workspace::release(Index i) {
+  while (ws[i].size()) {
+    WsvStruct *wsvs = ws[i].top();
+    if (wsvs->auto_allocated && wsvs->wsv) {
+      workspace_memory_handler.deallocate(wsv_data[i].Group(), wsvs->wsv);
+    }
+    if (ws[i].size() == 1) break;
+    delete (wsvs);
+    ws[i].pop();
+  }
+
+  if (!ws[i].size()) ws[i].push(new WsvStruct);
+
+  WsvStruct *wsvs = ws[i].top();
+  wsvs->wsv = NULL;
+  wsvs->initialized = false;
+  wsvs->auto_allocated = false;
+  wsvs->borrowed = false;
+  wsvs->deferred.reset();
+}
+
 Workspace::~Workspace() {
 #ifndef NDEBUG
 #pragma omp critical(ws_destruct)
@@ -126,7 +168,29 @@ Workspace::~Workspace() {
   }
 }
 
+namespace {
+/** Workspaces returned by PooledWorkspace on this thread. */
+thread_local std::vector<std::unique_ptr<Workspace> > workspace_pool;
+}  // namespace
+
+PooledWorkspace::PooledWorkspace(const Workspace &workspace) {
+  if (workspace_pool.empty()) {
+    mws = new Workspace(workspace);
+  } else {
+    mws = workspace_pool.back().release();
+    workspace_pool.pop_back();
+    mws->rebind(workspace);
+  }
+}
+
+PooledWorkspace::~PooledWorkspace() {
+  mws->release();
+  workspace_pool.emplace_back(mws);
+}
+
 void *Workspace::pop(Index i) {
+  // The caller takes over the variable, so it has to be complete
+  materialize(i);
   WsvStruct *wsvs = ws[i].top();
   void *vp = NULL;
   if (wsvs) {
@@ -141,7 +205,7 @@ void Workspace::pop_free(Index i) {
   WsvStruct *wsvs = ws[i].top();
 
   if (wsvs) {
-    if (wsvs->wsv)
+    if (wsvs->wsv && !wsvs->borrowed)
       workspace_memory_handler.deallocate(wsv_data[i].Group(), wsvs->wsv);
 
     delete wsvs;
@@ -152,6 +216,7 @@ void Workspace::pop_free(Index i) {
 void Workspace::push(Index i, void *wsv) {
   WsvStruct *wsvs = new WsvStruct;
   wsvs->auto_allocated = false;
+  wsvs->borrowed = false;
   wsvs->initialized = true;
   wsvs->wsv = wsv;
   ws[i].push(wsvs);
@@ -160,6 +225,7 @@ void Workspace::push(Index i, void *wsv) {
 void Workspace::push_uninitialized(Index i, void *wsv) {
   WsvStruct *wsvs = new WsvStruct;
   wsvs->auto_allocated = false;
+  wsvs->borrowed = false;
   wsvs->initialized = false;
   wsvs->wsv = wsv;
   ws[i].push(wsvs);
@@ -168,12 +234,49 @@ void Workspace::push_uninitialized(Index i, void *wsv) {
 void *Workspace::operator[](Index i) {
   if (!ws[i].size()) push(i, NULL);
 
+  materialize(i);
+
   if (!ws[i].top()->wsv) {
     ws[i].top()->auto_allocated = true;
     ws[i].top()->wsv = workspace_memory_handler.allocate(wsv_data[i].Group());
+  } else if (ws[i].top()->borrowed) {
+    ws[i].top()->wsv = workspace_memory_handler.duplicate(wsv_data[i].Group(),
+                                                          ws[i].top()->wsv);
+    ws[i].top()->auto_allocated = true;
+    ws[i].top()->borrowed = false;
   }
 
   ws[i].top()->initialized = true;
 
   return (ws[i].top()->wsv);
 }
+
+const void *Workspace::read(Index i) {
+  materialize(i);
+
+  if (ws[i].size() && ws[i].top()->wsv && ws[i].top()->initialized)
+    return ws[i].top()->wsv;
+
+  return this->operator[](i);
+}
+
+void Workspace::defer(Index i, std::function<void(void *)> loader) {
+  this->operator[](i);
+  ws[i].top()->deferred = std::make_shared<DeferredLoad>();
+  ws[i].top()->deferred->load = std::move(loader);
+}
+
+void Workspace::load_deferred(Index i) {
+  WsvStruct *wsvs = ws[i].top();
+  {
+    // Other scopes or workspace copies sharing the variable may load it
+    // concurrently. std::call_once is not used, because some standard
+    // libraries deadlock when retrying after the loader threw.
+    std::lock_guard<std::mutex> lock(wsvs->deferred->mutex);
+    if (!wsvs->deferred->done) {
+      wsvs->deferred->load(wsvs->wsv);
+      wsvs->deferred->done = true;
+    }
+  }
+  wsvs->deferred.reset();
+}
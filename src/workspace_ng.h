@@ -25,7 +25,10 @@
 #ifndef WORKSPACE_NG_INCLUDED
 #define WORKSPACE_NG_INCLUDED
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <stack>
 
 class Workspace;
@@ -39,10 +42,26 @@ class Workspace;
  */
 class Workspace {
  protected:
+  /** Load of a WSV postponed until its first access.
+   *
+   * Shared by all scopes and workspace copies that point to the same WSV,
+   * so the load is only done once, also if several threads access the
+   * variable at the same time.
+   */
+  struct DeferredLoad {
+    std::function<void(void *)> load;
+    std::mutex mutex;
+    bool done{false};
+  };
+
   struct WsvStruct {
     void *wsv;
     bool initialized;
     bool auto_allocated;
+    /** Points to the WSV of the scope below, owned by that scope. */
+    bool borrowed;
+    /** Pending load of the WSV, see defer. */
+    std::shared_ptr<DeferredLoad> deferred;
   };
 
   /** Workspace variable container. */
@@ -78,6 +97,24 @@ class Workspace {
   /** Destruct the workspace and free all WSVs. */
   virtual ~Workspace();
 
+  /** Make this workspace a copy of another workspace again.
+   *
+   * Same as the copy constructor, but reuses the stacks of this workspace.
+   * All WSVs owned by this workspace are freed first.
+   *
+   * @see PooledWorkspace
+   *
+   * @param[in] workspace The workspace to be copied
+   */
+  void rebind(const Workspace &workspace);
+
+  /** Free all WSVs owned by this workspace.
+   *
+   * Afterwards all WSVs are uninitialized. The stacks are kept, so the
+   * workspace can be rebound cheaply.
+   */
+  void release();
+
   /** Define workspace variables. */
   static void define_wsv_data();
 
@@ -100,6 +137,12 @@ class Workspace {
    * Create another level of scope by duplicating the top element on the WSV
    * stack.
    *
+   * The new scope initially shares the variable with the scope below. A
+   * private copy is only made the first time the variable is accessed for
+   * writing through operator[].
+   *
+   * @see read
+   *
    * @param[in] i
    */
   void duplicate(Index i);
@@ -122,6 +165,22 @@ class Workspace {
   /** Return scoping level of the given WSV. */
   Index depth(Index i) { return (Index)ws[i].size(); }
 
+  /** Postpone filling the given WSV until it is accessed.
+   *
+   * The WSV is allocated and marked as initialized, but the loader is
+   * only called the first time the variable is accessed through
+   * operator[], read or pop. It receives the pointer to the
+   * WSV, which it must fill. If the loader throws, the exception is passed
+   * on to the accessing method and the load is tried again on the next
+   * access.
+   *
+   * @see ReadXMLLazy
+   *
+   * @param[in] i WSV index.
+   * @param[in] loader Function that fills the WSV.
+   */
+  void defer(Index i, std::function<void(void *)> loader);
+
   /** Remove the topmost WSV from its stack.
    *
    * Memory is not freed.
@@ -164,8 +223,62 @@ class Workspace {
   /** Add a new variable to existing workspace and to the static maps */
   Index add_wsv_inplace(const WsvRecord &wsv);
 
-  /** Retrieve a pointer to the given WSV. */
+  /** Retrieve a pointer to the given WSV.
+   *
+   * The returned variable may be modified. If the topmost scope shares
+   * the variable with the scope below, it is copied first.
+   */
   void *operator[](Index i);
+
+  /** Retrieve a read-only pointer to the given WSV.
+   *
+   * Other than operator[], this does not copy a variable which is shared
+   * with the scope below.
+   *
+   * @param[in] i WSV index.
+   */
+  const void *read(Index i);
+
+ private:
+  /** Free the WSV i if owned by this workspace and leave one empty level. */
+  void release(Index i);
+
+  /** Run the deferred load of WSV i, if any. */
+  void materialize(Index i) {
+    if (ws[i].size() && ws[i].top()->deferred) load_deferred(i);
+  }
+
+  void load_deferred(Index i);
+};
+
+/** Workspace copy from a thread-local pool.
+ *
+ * Parallel loops need a copy of the workspace for each thread or task.
+ * Constructing a Workspace allocates the stacks for all WSVs, which adds
+ * up if a parallel method is called many times, e.g. inside ybatchCalc.
+ * A PooledWorkspace reuses a Workspace released earlier on the same
+ * thread and only rebinds it to the topmost layer of the given workspace.
+ * It is returned to the pool when the PooledWorkspace goes out of scope.
+ */
+class PooledWorkspace {
+ public:
+  /** Check out a copy of the given workspace.
+   *
+   * @param[in] workspace The workspace to be copied
+   */
+  explicit PooledWorkspace(const Workspace &workspace);
+
+  PooledWorkspace(const PooledWorkspace &) = delete;
+  PooledWorkspace &operator=(const PooledWorkspace &) = delete;
+
+  /** Release the WSVs owned by the copy and return it to the pool. */
+  ~PooledWorkspace();
+
+  Workspace &operator*() { return *mws; }
+  Workspace *operator->() { return mws; }
+
+ private:
+  Workspace *mws;
 };
 
 /** Print WSV name to output stream.
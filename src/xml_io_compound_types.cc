@@ -371,6 +371,7 @@ void xml_read_from_stream(istream& is_xml,
   xml_read_from_stream(is_xml, gal.t_pert, pbifs, verbosity);
   xml_read_from_stream(is_xml, gal.nls_pert, pbifs, verbosity);
   xml_read_from_stream(is_xml, gal.xsec, pbifs, verbosity);
+  gal.mapped_xsec.reset();
 
   tag.read_from_stream(is_xml);
   tag.check_name("/GasAbsLookup");
@@ -388,6 +389,14 @@ void xml_write_to_stream(ostream& os_xml,
                          bofstream* pbofs,
                          const String& name,
                          const Verbosity& verbosity) {
+  // Memory-mapped cross sections are written from a copy in memory
+  if (gal.IsMapped()) {
+    GasAbsLookup unmapped(gal);
+    unmapped.Unmap();
+    xml_write_to_stream(os_xml, unmapped, pbofs, name, verbosity);
+    return;
+  }
+
   ArtsXMLTag open_tag(verbosity);
   ArtsXMLTag close_tag(verbosity);
 